@@ -12,6 +12,7 @@
 #include "core/processor/template_processor.h"
 #include "core/processor/type_processor.h"
 #include "core/processor/variable_processor.h"
+#include "model/config/configuration.h"
 #include <clang/AST/Decl.h>
 #include <clang/AST/RecursiveASTVisitor.h>
 #include <memory>
@@ -26,8 +27,12 @@ class TemplateTemplateParmDecl;
 
 class ASTVisitor : public clang::RecursiveASTVisitor<ASTVisitor> {
 private:
+  using Base = clang::RecursiveASTVisitor<ASTVisitor>;
+
   clang::ASTContext *context_;
   clang::PrintingPolicy pp_;
+  // 正在遍历的模板实例化层数, 实例化内部的声明不参与头文件去重
+  int instantiation_depth_ = 0;
 
   ////// Processors /////////
   std::unique_ptr<FunctionProcessor> function_processor_ = nullptr;
@@ -43,11 +48,14 @@ private:
   std::unique_ptr<Lambda_Processor> lambda_processor_ = nullptr;
 
 public:
-  explicit ASTVisitor(clang::ASTContext *context);
+  ASTVisitor(clang::ASTContext *context, const ExtractionConfig &extraction);
 
   bool shouldVisitImplicitCode() const { return true; }
   bool shouldVisitTemplateInstantiations() const { return true; }
 
+  // 位于已由其他TU抽取的头文件中的声明只遍历本TU产生的模板实例化
+  bool TraverseDecl(clang::Decl *decl);
+
   // 为各种AST节点类型实现Visit方法
 
   // 声明类型
@@ -120,7 +128,11 @@ public:
   bool VisitCXXBoolLiteralExpr(const clang::CXXBoolLiteralExpr *literal);
 
   // 初始化处理器
-  void initProcessors();
+  void initProcessors(const ExtractionConfig &extraction);
+
+private:
+  bool traverseInstantiation(clang::Decl *decl);
+  bool traverseExtractedDecl(clang::Decl *decl);
 };
 
 #endif // _AST_VISITOR_H_
@@ -1,9 +1,12 @@
 #ifndef _CLANG_AST_MANAGER_H_
 #define _CLANG_AST_MANAGER_H_
 
+#include "core/pch_cache.h"
 #include "model/config/configuration.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/Frontend/CompilerInstance.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <llvm/Support/GlobPattern.h>
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,8 +23,13 @@ public:
 
   bool loadConfig(const Configuration &config);
 
-  // 使用Clang Tooling创建并处理AST
-  bool processAST(const std::string &source_path,
+  // 确定本次需要解析的TU列表; 未配置编译数据库时即为 source_path 本身
+  std::vector<std::string>
+  collectSourcePaths(const std::string &source_path) const;
+
+  // 使用Clang Tooling创建并处理AST, 所有TU共享同一次抽取
+  // 可被多个工作线程同时调用, 每次调用使用独立的 ClangTool
+  bool processAST(const std::vector<std::string> &source_paths,
                   std::function<void(clang::ASTContext &)> callback);
 
   const std::string &getSourcePath() const;
@@ -37,9 +45,19 @@ private:
   std::string cxxStandard;
   std::vector<std::string> flags;
   std::vector<std::string> args;
+  std::vector<llvm::GlobPattern> sourceFilters;
+  std::string compileCommandsPath;
+  PchCache pchCache;
+  bool extractPreprocessor = true;
+
+  // 编译数据库: 来自 compile_commands.json, 或由上述固定参数构造
+  std::unique_ptr<clang::tooling::CompilationDatabase> compileDatabase;
 
   // 将配置转换为命令行参数
   std::vector<std::string> convertToCommandLineArgs() const;
+
+  bool loadCompilationDatabase();
+  bool matchesSourceFilters(const std::string &file) const;
 };
 
 #endif // _CLANG_AST_MANAGER_H_
\ No newline at end of file
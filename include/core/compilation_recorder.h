@@ -2,20 +2,41 @@
 #define _CORE_COMP_RECORDER_H_
 
 #include "model/db/compilation.h"
+#include <cstdint>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+namespace clang {
+class FileEntryRef;
+class SourceManager;
+} // namespace clang
+
 class CompRecorder {
 public:
-  int createCompilation(const std::string &working_directory);
+  int64_t createCompilation(const std::string &working_directory);
 
   void recordArguments(const std::vector<std::string> &flags);
   void recordTime(CompTimeKind kind, double seconds);
-  int recordFile(const std::string &file);
-  std::optional<int> getSourceFileId() const;
+  // 写入 ProcessorMetrics 中全部处理器的累计计数
+  void recordProcessorMetrics();
+  int64_t recordFile(const std::string &path);
+  // 查找 path 对应的 files 记录, 头文件等未记录过的文件在首次出现时记录
+  int64_t resolveFile(const std::string &path);
+  // 沿用上次增量抽取记录的 files 记录, 需在记录任何文件之前调用
+  void registerFile(const std::string &path, int64_t id);
+  // 切换当前正在解析的TU, path 需为 recordFile 记录过的源文件
+  void enterSourceFile(const std::string &path);
+  std::optional<int64_t> getSourceFileId() const;
   void finalize(double total_cpu, double total_elapsed);
 
+  static std::string normalizePath(const std::string &path);
+  // 文件在本TU中的规范化路径, 相对路径按编译命令的工作目录解析
+  static std::string entryPath(clang::FileEntryRef entry,
+                               const clang::SourceManager &sourceManager);
+
   static CompRecorder &getInstance() {
     static CompRecorder instance;
     return instance;
@@ -29,9 +50,15 @@ public:
 
 private:
   CompRecorder() = default;
-  int compilation_id_;
-  int source_file_id_ = -1;
+  int64_t compilation_id_;
+  int64_t source_file_id_ = -1;
+  // 并行解析时每个工作线程各自处于不同的TU
+  static thread_local int64_t current_source_file_id_;
   int time_record_seq_ = 0;
+  std::unordered_map<std::string, int64_t> source_file_ids_;
+  std::mutex files_mutex_; // 工作线程会并发记录头文件
+
+  int64_t insertFile(const std::string &normalized_path);
 };
 
 #endif // _CORE_COMP_RECORDER_H_
@@ -0,0 +1,52 @@
+#ifndef _CORE_FOCUS_FILTER_H_
+#define _CORE_FOCUS_FILTER_H_
+
+#include "model/config/configuration.h"
+#include <clang/Basic/SourceLocation.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/Support/GlobPattern.h>
+#include <vector>
+
+namespace clang {
+class Decl;
+class SourceManager;
+} // namespace clang
+
+// 抽取范围过滤
+// 关注范围 = 各TU的主文件 + 路径匹配 focus_paths 的文件, 范围外的函数体不解析;
+// 开启 skip_system_headers 时系统头文件中的声明整体跳过
+class FocusFilter {
+public:
+  static FocusFilter &getInstance() {
+    static FocusFilter instance;
+    return instance;
+  }
+
+  void configure(const CompilationConfig &config);
+
+  // 配置了关注范围, 需要解析器跳过范围外的函数体
+  bool hasFocus() const { return !patterns_.empty(); }
+
+  // 开始解析新的TU, FileID 只在各自的 SourceManager 内有效
+  void enterTranslationUnit();
+
+  // loc 所在文件位于关注范围内, 未配置关注范围时总是 true
+  bool isInFocus(clang::SourceLocation loc,
+                 const clang::SourceManager &sourceManager);
+
+  bool isSkippedSystemDecl(const clang::Decl *decl,
+                           const clang::SourceManager &sourceManager) const;
+
+  FocusFilter(const FocusFilter &) = delete;
+  FocusFilter &operator=(const FocusFilter &) = delete;
+
+private:
+  FocusFilter() = default;
+
+  std::vector<llvm::GlobPattern> patterns_;
+  bool skip_system_headers_ = false;
+
+  static thread_local llvm::DenseMap<clang::FileID, bool> focused_files_;
+};
+
+#endif // _CORE_FOCUS_FILTER_H_
@@ -0,0 +1,75 @@
+#ifndef _CORE_HEADER_REGISTRY_H_
+#define _CORE_HEADER_REGISTRY_H_
+
+#include "util/fingerprint.h"
+#include <atomic>
+#include <clang/Basic/SourceLocation.h>
+#include <cstdint>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringRef.h>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace clang {
+class MacroInfo;
+class PPCallbacks;
+class Preprocessor;
+class SourceManager;
+} // namespace clang
+
+// 跨TU的头文件去重
+// 头文件指纹 = 路径 + 内容 + 预定义宏(命令行 -D/-U 及编译器内置宏)
+//            + 该文件引用的宏及引用时的定义(#ifdef/defined/宏展开)
+// 同一指纹只由最先遇到它的TU抽取, 其余TU跳过位于其中的声明;
+// 认领它的TU再次进入同一指纹(未加保护的头文件、X-macro .def)时照常抽取
+class HeaderRegistry {
+public:
+  static HeaderRegistry &getInstance() {
+    static HeaderRegistry instance;
+    return instance;
+  }
+
+  void setEnabled(bool enabled) { enabled_ = enabled; }
+  bool isEnabled() const { return enabled_; }
+
+  // 开始解析新的TU, predefines 为该TU预处理器的预定义缓冲
+  void enterTranslationUnit(llvm::StringRef predefines);
+
+  // 记录各文件引用的宏, 需在预处理开始前安装到该TU的预处理器上
+  std::unique_ptr<clang::PPCallbacks>
+  createMacroTracker(const clang::Preprocessor &PP);
+
+  // loc 所在的头文件已由其他TU抽取时返回 true, 主文件总是返回 false
+  bool isExtractedElsewhere(clang::SourceLocation loc,
+                            const clang::SourceManager &sourceManager);
+
+  HeaderRegistry(const HeaderRegistry &) = delete;
+  HeaderRegistry &operator=(const HeaderRegistry &) = delete;
+
+private:
+  HeaderRegistry() = default;
+
+  class MacroTracker;
+
+  // 该指纹未被登记或已由当前TU登记时返回 true, 调用方所在的TU负责抽取
+  bool claim(const Fingerprint &header);
+
+  bool enabled_ = true;
+  std::unordered_map<Fingerprint, std::uint64_t> claimed_; // 指纹 -> 所属TU
+  std::mutex mutex_;
+  std::atomic<std::uint64_t> next_tu_{1};
+
+  // 以下为当前线程所处TU的状态, FileID 只在各自的 SourceManager 内有效
+  static thread_local std::uint64_t tu_;
+  static thread_local Fingerprint macro_state_;
+  static thread_local llvm::DenseMap<clang::FileID, bool> skipped_files_;
+  // 各文件按出现顺序累积的宏引用
+  static thread_local llvm::DenseMap<clang::FileID, FingerprintBuilder>
+      file_macros_;
+  // 宏定义内容的指纹, 同一定义被多次引用时只计算一次
+  static thread_local llvm::DenseMap<const clang::MacroInfo *, Fingerprint>
+      macro_definitions_;
+};
+
+#endif // _CORE_HEADER_REGISTRY_H_
@@ -0,0 +1,68 @@
+#ifndef _CORE_INCREMENTAL_TRACKER_H_
+#define _CORE_INCREMENTAL_TRACKER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace clang {
+class SourceManager;
+} // namespace clang
+
+// 增量抽取
+// 每个TU记录其读取过的全部文件(含头文件)的内容哈希以及在各表中写入的 rowid 区间;
+// 再次运行时只重新抽取有文件内容变化的TU, 并先按 rowid 区间删除这些TU上次写入的记录.
+// 为使每个TU的行在各表中连续且只属于该TU, 增量模式下各TU独立抽取:
+// 不共享缓存、不做头文件去重, 且只能顺序解析
+class IncrementalTracker {
+public:
+  static IncrementalTracker &getInstance() {
+    static IncrementalTracker instance;
+    return instance;
+  }
+
+  void setEnabled(bool enabled) { enabled_ = enabled; }
+  bool isEnabled() const { return enabled_; }
+
+  // 读取上次运行的簿记信息: 沿用 files 记录, 并从上次的ID之后继续分配.
+  // 需在生成任何ID之前调用
+  void loadState();
+
+  // 删除需要重新抽取或已不存在的TU上次写入的记录, 返回需要抽取的源文件.
+  // 未开启增量模式时原样返回 sources
+  std::vector<std::string>
+  selectSources(const std::vector<std::string> &sources);
+
+  void beginTranslationUnit();
+  // 在 ASTContext 销毁前收集当前TU读取过的文件
+  void collectFiles(const clang::SourceManager &sourceManager);
+  // 回填依赖并清空跨TU的缓存, 记录TU的 rowid 区间与文件哈希
+  void endTranslationUnit(const std::string &source_path);
+
+  // 全部写入落库后持久化ID计数器
+  void finish();
+
+  IncrementalTracker(const IncrementalTracker &) = delete;
+  IncrementalTracker &operator=(const IncrementalTracker &) = delete;
+
+private:
+  IncrementalTracker() = default;
+
+  // 文件当前内容的哈希, 文件不可读时为空串
+  const std::string &currentHash(const std::string &normalized_path);
+
+  bool enabled_ = false;
+  // TU开始前各表最大的 rowid
+  std::unordered_map<std::string, int64_t> tu_last_rowids_;
+  std::vector<std::string> tu_files_;
+  // 以下以规范化路径为键
+  std::unordered_map<std::string, std::string> recorded_hashes_;
+  std::unordered_map<std::string, std::string> current_hashes_;
+  // files ID -> 路径
+  std::unordered_map<int64_t, std::string> recorded_paths_;
+  std::unordered_set<int64_t> hashed_files_; // 本次运行已写入哈希的文件
+};
+
+#endif // _CORE_INCREMENTAL_TRACKER_H_
@@ -0,0 +1,43 @@
+#ifndef _CORE_PCH_CACHE_H_
+#define _CORE_PCH_CACHE_H_
+
+#include "model/config/configuration.h"
+#include "util/fingerprint.h"
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 前端的预编译头与模块缓存复用
+// 编译命令中已有的 -include-pch 直接沿用; 否则为配置的前缀头文件按编译参数
+// 自动生成PCH, 工作目录与参数相同的TU共用同一个PCH
+class PchCache {
+public:
+  void configure(const Configuration &config);
+
+  // 调整单个TU的编译参数, directory 为编译命令的工作目录
+  // 可被多个工作线程同时调用
+  std::vector<std::string> adjust(const std::vector<std::string> &args,
+                                  const std::string &file,
+                                  const std::string &directory);
+
+private:
+  // 返回可供该TU使用的PCH路径, 生成失败时为空
+  std::string obtain(const std::vector<std::string> &args,
+                     const std::string &file, const std::string &directory);
+  std::string build(std::vector<std::string> command, const std::string &file,
+                    const std::string &directory, const Fingerprint &key);
+
+  std::vector<std::string> prefix_headers_; // 绝对路径
+  std::filesystem::path pch_dir_;
+  std::string module_cache_path_;
+
+  // 参数指纹 -> PCH路径, 生成失败的记为空串以免重复尝试.
+  // 首个请求者在锁外生成, 同一指纹的其他线程等待其结果
+  std::unordered_map<Fingerprint, std::shared_future<std::string>> pch_files_;
+  std::mutex mutex_; // 只保护 pch_files_ 的查找与登记
+};
+
+#endif // _CORE_PCH_CACHE_H_
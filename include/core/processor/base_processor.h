@@ -1,20 +1,31 @@
 #ifndef _BASE_PROCESSOR_H_
 #define _BASE_PROCESSOR_H_
 
+#include "util/processor_metrics.h"
 #include <clang/AST/ASTContext.h>
 
+// 处理器的入口方法以此开头: 计一次节点并计时, 作用域内写入的记录与缓存查找
+// 都记到该处理器上
+#define PROCESSOR_SCOPE() ProcessorScope processor_scope_(counters_)
+
 class BaseProcessor {
 protected:
   clang::ASTContext *ast_context_;
   clang::PrintingPolicy pp_;
+  ProcessorKind kind_;
+  ProcessorCounters counters_;
 
 public:
-  BaseProcessor(clang::ASTContext *ast_context, const clang::PrintingPolicy pp)
-      : ast_context_(ast_context), pp_(pp) {
+  BaseProcessor(clang::ASTContext *ast_context, const clang::PrintingPolicy pp,
+                ProcessorKind kind)
+      : ast_context_(ast_context), pp_(pp), kind_(kind) {
     pp_.SuppressTagKeyword = true;
     pp_.SuppressScope = false;
   };
-  ~BaseProcessor() = default;
+  // 处理器随TU销毁, 本TU的计数并入全局统计
+  ~BaseProcessor() {
+    ProcessorMetrics::getInstance().merge(kind_, counters_);
+  }
 };
 
 #endif // _BASE_PROCESSOR_H_
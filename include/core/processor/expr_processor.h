@@ -40,29 +40,32 @@ public:
   void processArraySubscriptExpr(const ArraySubscriptExpr *expr);
   void processInitListExpr(const InitListExpr *expr);
   void processUnaryExprOrTypeTraitExpr(const UnaryExprOrTypeTraitExpr *expr);
-  int processConceptSpecializationExpr(
-      const ConceptSpecializationExpr *expr, int conceptId);
-  int processNonTypeTemplateParmDecl(const NonTypeTemplateParmDecl *decl);
+  int64_t processConceptSpecializationExpr(
+      const ConceptSpecializationExpr *expr, int64_t conceptId);
+  int64_t processNonTypeTemplateParmDecl(const NonTypeTemplateParmDecl *decl);
 
   ExprProcessor(ASTContext *ast_context, const PrintingPolicy pp, TypeProcessor *tp = nullptr)
-      : BaseProcessor(ast_context, pp), type_processor_(tp) {};
+      : BaseProcessor(ast_context, pp, ProcessorKind::Expr),
+        type_processor_(tp) {};
   ~ExprProcessor() = default;
 
 private:
-  int _typeId;
-  int _varId;
-  int _varDeclId;
+  int64_t _typeId;
+  int64_t _varId;
+  int64_t _varDeclId;
   std::string _name;
 
-  int processBaseExpr(Expr *expr, ExprKind exprKind);
+  int64_t processBaseExpr(Expr *expr, ExprKind exprKind);
 
-  int processLiteralValue(const std::string &value, const std::string &text,
-                          int exprId);
-  void recordValueBindExpr(int valueId, int exprId);
+  int64_t processLiteralValue(const std::string &value, const std::string &text,
+                              int64_t exprId);
+  void recordValueBindExpr(int64_t valueId, int64_t exprId);
 
-  void recordAggregateArrayInit(int initListExprId, const InitListExpr *expr);
-  void recordAggregateFieldInit(int initListExprId, const InitListExpr *expr);
-  void recordSizeOfBind(int exprId, const UnaryExprOrTypeTraitExpr *expr);
+  void recordAggregateArrayInit(int64_t initListExprId,
+                                const InitListExpr *expr);
+  void recordAggregateFieldInit(int64_t initListExprId,
+                                const InitListExpr *expr);
+  void recordSizeOfBind(int64_t exprId, const UnaryExprOrTypeTraitExpr *expr);
 
   TypeProcessor *type_processor_ = nullptr;
 };
@@ -9,28 +9,30 @@ using namespace clang;
 
 class FunctionProcessor : public BaseProcessor {
 public:
-  int routerProcess(const FunctionDecl *decl);
-  int processCXXConstructor(const CXXConstructorDecl *decl);
-  int processCXXDestructor(const CXXDestructorDecl *decl);
-  int processCXXConversion(const CXXConversionDecl *decl);
-  int processCXXDeductionGuide(const CXXDeductionGuideDecl *decl);
-  int processOperatorFunc(const FunctionDecl *decl);
-  int processBuiltinFunc(const FunctionDecl *decl);
-  int processUserDefinedLiteral(const FunctionDecl *decl);
-  int processNormalFunc(const FunctionDecl *decl);
+  int64_t routerProcess(const FunctionDecl *decl);
+  int64_t processCXXConstructor(const CXXConstructorDecl *decl);
+  int64_t processCXXDestructor(const CXXDestructorDecl *decl);
+  int64_t processCXXConversion(const CXXConversionDecl *decl);
+  int64_t processCXXDeductionGuide(const CXXDeductionGuideDecl *decl);
+  int64_t processOperatorFunc(const FunctionDecl *decl);
+  int64_t processBuiltinFunc(const FunctionDecl *decl);
+  int64_t processUserDefinedLiteral(const FunctionDecl *decl);
+  int64_t processNormalFunc(const FunctionDecl *decl);
 
   FunctionProcessor(ASTContext *ast_context, const PrintingPolicy pp)
-      : BaseProcessor(ast_context, pp) {};
+      : BaseProcessor(ast_context, pp, ProcessorKind::Function) {};
   ~FunctionProcessor() = default;
 
 private:
   // Cache for common information
   // Since the RecursiveVisitor will firstly visit FunctionDecl node, than visit
   // related subclasses of FunctionDecl, so, we can cache the information here
-  LocIdPair *_locIdPair;
-  int _funcId;
-  int _funcDeclId;
-  int _typeId;
+  LocIdPair _locIdPair{-1, -1};
+  int64_t _funcId;
+  // 本处声明是否首个登记该函数, 函数级的记录只由首个声明写入
+  bool _funcClaimed = false;
+  int64_t _funcDeclId;
+  int64_t _typeId;
 
   void handleBaseFunc(const FunctionDecl *decl, const FuncType type);
   void recordBasicInfo(const FunctionDecl *decl) const;
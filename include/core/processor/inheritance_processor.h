@@ -14,12 +14,14 @@ public:
                        const clang::PrintingPolicy pp,
                        TypeProcessor *type_processor,
                        SpecifierProcessor *specifier_processor)
-      : BaseProcessor(ast_context, pp), type_processor_(type_processor),
+      : BaseProcessor(ast_context, pp, ProcessorKind::Inheritance),
+        type_processor_(type_processor),
         specifier_processor_(specifier_processor) {}
 
   void processCXXRecordDecl(const clang::CXXRecordDecl *decl);
 
-  static std::string makeDerivationKey(int sub_id, int index, int super_id);
+  static std::string makeDerivationKey(int64_t sub_id, int index,
+                                       int64_t super_id);
 
 private:
   TypeProcessor *type_processor_ = nullptr;
@@ -27,13 +29,13 @@ private:
 
   const clang::CXXRecordDecl *
   getProcessableDefinition(const clang::CXXRecordDecl *decl) const;
-  int resolveRecordTypeId(const clang::CXXRecordDecl *decl);
-  int resolveBaseTypeId(const clang::CXXBaseSpecifier &base,
-                        bool &is_dependent,
-                        std::string &dependent_super_name);
+  int64_t resolveRecordTypeId(const clang::CXXRecordDecl *decl);
+  int64_t resolveBaseTypeId(const clang::CXXBaseSpecifier &base,
+                            bool &is_dependent,
+                            std::string &dependent_super_name);
   void processBaseSpecifier(const clang::CXXBaseSpecifier &base, int index,
-                            int sub_id);
-  void recordDerivationSpecifiers(int derivation_id,
+                            int64_t sub_id);
+  void recordDerivationSpecifiers(int64_t derivation_id,
                                   const clang::CXXBaseSpecifier &base);
 };
 
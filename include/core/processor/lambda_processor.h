@@ -21,18 +21,19 @@ public:
                    const clang::PrintingPolicy pp,
                    TypeProcessor *type_processor,
                    VariableProcessor *variable_processor)
-      : BaseProcessor(ast_context, pp), type_processor_(type_processor),
+      : BaseProcessor(ast_context, pp, ProcessorKind::Lambda),
+        type_processor_(type_processor),
         variable_processor_(variable_processor) {}
   ~Lambda_Processor();
 
   void processLambdaExpr(clang::LambdaExpr *expr);
 
 private:
-  int getOrCreateLambdaExprId(clang::LambdaExpr *expr);
+  int64_t getOrCreateLambdaExprId(clang::LambdaExpr *expr);
   std::string getDefaultCaptureString(const clang::LambdaExpr *expr) const;
-  void recordCaptures(const clang::LambdaExpr *expr, int lambdaExprId);
+  void recordCaptures(const clang::LambdaExpr *expr, int64_t lambdaExprId);
   void recordFieldOnlyCaptures(const clang::LambdaExpr *expr,
-                               int lambdaExprId);
+                               int64_t lambdaExprId);
   const clang::FieldDecl *
   resolveCaptureField(const clang::LambdaExpr *expr,
                       const clang::LambdaCapture *capture,
@@ -40,19 +41,19 @@ private:
   const clang::FieldDecl *
   resolveCaptureFieldByIndex(const clang::LambdaExpr *expr,
                              unsigned captureIndex) const;
-  int resolveCaptureFieldId(const clang::FieldDecl *field) const;
-  int getCaptureLocationId(const clang::LambdaCapture *capture) const;
-  int getFieldLocationId(const clang::FieldDecl *field) const;
+  int64_t resolveCaptureFieldId(const clang::FieldDecl *field) const;
+  int64_t getCaptureLocationId(const clang::LambdaCapture *capture) const;
+  int64_t getFieldLocationId(const clang::FieldDecl *field) const;
   bool isCapturedByReference(const clang::LambdaCapture *capture) const;
 
   struct PendingLambdaCapture {
     const clang::LambdaExpr *expr;
-    int lambdaExprId;
+    int64_t lambdaExprId;
   };
 
   TypeProcessor *type_processor_ = nullptr;
   VariableProcessor *variable_processor_ = nullptr;
-  std::unordered_set<int> processed_lambda_exprs_;
+  std::unordered_set<int64_t> processed_lambda_exprs_;
   std::vector<PendingLambdaCapture> pending_field_only_captures_;
   std::unordered_set<const clang::FieldDecl *> recorded_capture_fields_;
 };
@@ -7,7 +7,7 @@
 
 class LocationProcessor : public BaseProcessor {
 public:
-  int locModelId;
+  int64_t locModelId;
 
   void processDefault(const clang::SourceLocation beginLoc,
                       const clang::SourceLocation endLoc);
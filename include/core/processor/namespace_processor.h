@@ -10,7 +10,7 @@ class NamespaceProcessor : public BaseProcessor {
 public:
   NamespaceProcessor(clang::ASTContext *ast_context,
                      const clang::PrintingPolicy pp)
-      : BaseProcessor(ast_context, pp) {}
+      : BaseProcessor(ast_context, pp, ProcessorKind::Namespace) {}
   ~NamespaceProcessor() = default;
 
   void processNamespaceDecl(const clang::NamespaceDecl *decl);
@@ -22,17 +22,17 @@ public:
                               const clang::Decl *member);
 
 private:
-  int getOrCreateNamespaceId(const clang::NamespaceDecl *decl);
+  int64_t getOrCreateNamespaceId(const clang::NamespaceDecl *decl);
 
   void processNamespace(const clang::NamespaceDecl *decl);
   void recordNamespaceDecl(const clang::NamespaceDecl *decl);
   void processNamespaceInline(const clang::NamespaceDecl *decl);
   void processNamespaceMembers(const clang::NamespaceDecl *decl);
   void recordUsing(const clang::Decl *decl, int kind);
-  std::optional<int> resolveUsingOwnerElement(
+  std::optional<int64_t> resolveUsingOwnerElement(
       const clang::DeclContext *context);
 
-  std::unordered_map<const clang::NamespaceDecl *, int> namespace_ids_;
+  std::unordered_map<const clang::NamespaceDecl *, int64_t> namespace_ids_;
 };
 
 #endif // _NAMESPACE_PROCESSOR_H_
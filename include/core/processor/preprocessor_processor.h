@@ -9,6 +9,7 @@
 #include <clang/Lex/PPCallbacks.h>
 #include <clang/Lex/Preprocessor.h>
 #include <stack>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -66,19 +67,20 @@ private:
 
   // Branch tracking for if/elif/else/endif pairing
   struct BranchInfo {
-    int directive_id;
+    int64_t directive_id;
     PreprocDirectKind kind;
     SourceLocation location;
   };
   std::stack<BranchInfo> branch_stack_;
 
   // Track which branches evaluated to true/false
-  std::unordered_map<int, bool> branch_evaluation_;
-  std::unordered_map<std::string, int> macro_define_id_by_name_;
+  std::unordered_map<int64_t, bool> branch_evaluation_;
+  // 键为驻留在 StringPool 中的宏名, 查找时无需构造 std::string
+  std::unordered_map<std::string_view, int64_t> macro_define_id_by_name_;
   std::unordered_set<std::string> macro_argument_dedup_cache_;
   std::unordered_set<std::string> macrolocationbind_dedup_cache_;
-  std::unordered_set<int> macroparent_child_dedup_cache_;
-  std::unordered_map<unsigned, int> macro_invocation_by_loc_key_;
+  std::unordered_set<int64_t> macroparent_child_dedup_cache_;
+  std::unordered_map<unsigned, int64_t> macro_invocation_by_loc_key_;
 
   static constexpr int kMacroExpansionKind = 1;
   static constexpr int kOtherMacroReferenceKind = 2;
@@ -86,37 +88,40 @@ private:
   ////// Helper Methods //////
 
   // Process a preprocessor directive and return its ID
-  int processDirective(SourceLocation Loc, PreprocDirectKind kind,
-                       const std::string &key_suffix = "");
+  int64_t processDirective(SourceLocation Loc, PreprocDirectKind kind,
+                           const std::string &key_suffix = "");
 
   // Extract and store directive text (head and body)
-  void extractDirectiveText(SourceLocation Loc, int directive_id, PreprocDirectKind kind);
+  void extractDirectiveText(SourceLocation Loc, int64_t directive_id,
+                            PreprocDirectKind kind);
 
   // Record branch pairing (begin -> elif/else/endif)
-  void recordBranchPair(int begin_id, int end_id);
+  void recordBranchPair(int64_t begin_id, int64_t end_id);
 
   // Record whether branch evaluated to true or false
-  void recordBranchEvaluation(int branch_id, bool is_true);
+  void recordBranchEvaluation(int64_t branch_id, bool is_true);
 
   // Resolve include file and create/update File entry
-  int resolveIncludeFile(const std::string &filename);
+  int64_t resolveIncludeFile(const std::string &filename);
 
   // Get full source text for a source range
   std::string getSourceText(CharSourceRange range);
 
   // Record macro invocation/reference row if matching define id is known.
-  int recordMacroInvocation(const Token &MacroNameTok, SourceLocation Loc, int kind);
+  int64_t recordMacroInvocation(const Token &MacroNameTok, SourceLocation Loc,
+                                int kind);
 
   // Convert tokens to a stable space-joined text representation.
   std::string tokensToText(const Token *tokens, unsigned token_count) const;
   std::string tokensToText(const std::vector<Token> &tokens) const;
 
   // Prevent duplicate insertions for the same (invocation, argument_index, table).
-  bool shouldInsertMacroArgumentRow(int invocation_id, int argument_index,
+  bool shouldInsertMacroArgumentRow(int64_t invocation_id, int argument_index,
                                     bool is_expanded);
 
-  bool shouldInsertMacroLocationBindRow(int invocation_id, int location_id);
-  bool shouldInsertMacroParentRow(int child_id);
+  bool shouldInsertMacroLocationBindRow(int64_t invocation_id,
+                                        int64_t location_id);
+  bool shouldInsertMacroParentRow(int64_t child_id);
   unsigned makeMacroLocationKey(SourceLocation loc) const;
 };
 
@@ -21,7 +21,8 @@ public:
                         const clang::PrintingPolicy pp,
                         TypeProcessor *type_processor,
                         VariableProcessor *variable_processor)
-      : BaseProcessor(ast_context, pp), type_processor_(type_processor),
+      : BaseProcessor(ast_context, pp, ProcessorKind::RecordLayout),
+        type_processor_(type_processor),
         variable_processor_(variable_processor) {}
 
   void processCXXRecordDecl(const clang::CXXRecordDecl *decl);
@@ -32,28 +33,31 @@ private:
 
   const clang::CXXRecordDecl *
   getLayoutReadyDefinition(const clang::CXXRecordDecl *decl) const;
-  int resolveRecordTypeId(const clang::CXXRecordDecl *decl);
-  std::optional<int> findDerivationId(int sub_id, int index, int super_id);
+  int64_t resolveRecordTypeId(const clang::CXXRecordDecl *decl);
+  std::optional<int64_t> findDerivationId(int64_t sub_id, int index,
+                                          int64_t super_id);
   std::optional<int> toInt(clang::CharUnits units) const;
   std::optional<int> bitsToByteOffset(uint64_t bit_offset) const;
   std::optional<int> bitsToBitOffset(uint64_t bit_offset) const;
   int toIntFlag(bool value) const;
 
   void recordLayoutMetadata(const clang::CXXRecordDecl *decl,
-                            const clang::ASTRecordLayout &layout, int sub_id);
+                            const clang::ASTRecordLayout &layout,
+                            int64_t sub_id);
   void recordDirectBaseOffsets(const clang::CXXRecordDecl *decl,
                                const clang::ASTRecordLayout &layout,
-                               int sub_id);
+                               int64_t sub_id);
   void recordVirtualBaseOffsets(const clang::CXXRecordDecl *decl,
                                 const clang::ASTRecordLayout &layout,
-                                int sub_id);
+                                int64_t sub_id);
   void recordFieldOffsets(const clang::CXXRecordDecl *decl,
                           const clang::ASTRecordLayout &layout);
-  void recordBitField(const clang::FieldDecl *field, int member_var_id);
+  void recordBitField(const clang::FieldDecl *field, int64_t member_var_id);
   void recordFieldLayoutTraits(const clang::CXXRecordDecl *parent,
                                const clang::FieldDecl *field,
-                               int member_var_id);
-  void recordIndirectFieldPaths(const clang::CXXRecordDecl *decl, int sub_id);
+                               int64_t member_var_id);
+  void recordIndirectFieldPaths(const clang::CXXRecordDecl *decl,
+                                int64_t sub_id);
   std::string buildIndirectFieldPath(const clang::IndirectFieldDecl *decl) const;
 };
 
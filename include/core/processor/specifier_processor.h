@@ -5,6 +5,7 @@
 #include "model/db/specifiers.h"
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclCXX.h>
+#include <llvm/ADT/DenseMap.h>
 #include <vector>
 
 using namespace clang;
@@ -12,30 +13,33 @@ using namespace clang;
 class SpecifierProcessor : public BaseProcessor {
 public:
   // 获取或创建 specifier，返回其 id
-  int getOrCreateSpecifier(const std::string &str);
+  int64_t getOrCreateSpecifier(const std::string &str);
 
   // 处理类型的 cvr 限定符 (const, volatile, restrict)
-  void processTypeQualifiers(int type_id, QualType qualType);
+  void processTypeQualifiers(int64_t type_id, QualType qualType);
 
   // 处理函数的说明符 (inline, static, virtual, constexpr 等)
-  void processFunctionSpecifiers(int func_id, const FunctionDecl *FD);
+  void processFunctionSpecifiers(int64_t func_id, const FunctionDecl *FD);
 
   // 处理变量的说明符
-  void processVariableSpecifiers(int var_id, const VarDecl *VD);
-  void processVariableSpecifiers(int var_id, const FieldDecl *FD);
+  void processVariableSpecifiers(int64_t var_id, const VarDecl *VD);
+  void processVariableSpecifiers(int64_t var_id, const FieldDecl *FD);
 
   // 处理 C++ base specifier 的访问控制与 virtual 标记。
-  std::vector<int> processBaseSpecifiers(const CXXBaseSpecifier &base);
+  std::vector<int64_t> processBaseSpecifiers(const CXXBaseSpecifier &base);
 
   SpecifierProcessor(ASTContext *ast_context, const PrintingPolicy pp)
-      : BaseProcessor(ast_context, pp) {};
+      : BaseProcessor(ast_context, pp, ProcessorKind::Specifier) {};
   ~SpecifierProcessor() = default;
 
 private:
   // 插入 specifier 到关联表
-  void insertTypeSpecifiers(int type_id, int spec_id);
-  void insertFunSpecifiers(int func_id, int spec_id);
-  void insertVarSpecifiers(int var_id, int spec_id);
+  void insertTypeSpecifiers(int64_t type_id, int64_t spec_id);
+  void insertFunSpecifiers(int64_t func_id, int64_t spec_id);
+  void insertVarSpecifiers(int64_t var_id, int64_t spec_id);
+
+  // 本TU内各类型已记录的 cvr 限定符, 同一类型的重复出现不再写入
+  llvm::DenseMap<int64_t, unsigned> type_qualifiers_;
 };
 
 #endif // _SPECIFIER_PROCESSOR_H_
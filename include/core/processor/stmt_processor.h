@@ -11,7 +11,7 @@ using namespace clang;
 
 class StmtProcessor : public BaseProcessor {
 public:
-  int getStmtId(Stmt *stmt, StmtKind stmtKind);
+  int64_t getStmtId(Stmt *stmt, StmtKind stmtKind);
 
   void processIfStmt(IfStmt *ifStmt);
   void processForStmt(ForStmt *forStmt);
@@ -24,13 +24,13 @@ public:
   void processDeclStmt(DeclStmt *declStmt);
 
   StmtProcessor(ASTContext *ast_context, const PrintingPolicy pp)
-      : BaseProcessor(ast_context, pp) {};
+      : BaseProcessor(ast_context, pp, ProcessorKind::Stmt) {};
   ~StmtProcessor() = default;
 
 private:
-  int _typeId;
-  int _varId;
-  int _varDeclId;
+  int64_t _typeId;
+  int64_t _varId;
+  int64_t _varDeclId;
   std::string _name;
 };
 
@@ -2,10 +2,16 @@
 #define _TEMPLATE_PROCESSOR_H_
 
 #include "core/processor/base_processor.h"
+#include "util/fingerprint.h"
 #include <llvm/ADT/ArrayRef.h>
-#include <string>
+#include <llvm/ADT/DenseSet.h>
+#include <tuple>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
+
+namespace llvm {
+class raw_ostream;
+} // namespace llvm
 
 namespace clang {
 class ConceptDecl;
@@ -37,7 +43,8 @@ public:
                     TypeProcessor *typeProcessor,
                     ExprProcessor *exprProcessor,
                     VariableProcessor *variableProcessor)
-      : BaseProcessor(context, pp), type_processor_(typeProcessor),
+      : BaseProcessor(context, pp, ProcessorKind::Template),
+        type_processor_(typeProcessor),
         expr_processor_(exprProcessor),
         variable_processor_(variableProcessor) {
     (void)type_processor_;
@@ -46,82 +53,88 @@ public:
   };
   ~TemplateProcessor() = default;
 
-  bool shouldInsertClassInstantiation(int to, int from);
-  bool shouldInsertClassTemplateArgument(int typeId, int index, int argType);
-  bool shouldInsertClassTemplateArgumentValue(int typeId, int index,
-                                              int argValue);
-  bool shouldInsertFunctionInstantiation(int to, int from);
-  bool shouldInsertFunctionTemplateArgument(int functionId, int index,
-                                            int argType);
-  bool shouldInsertFunctionTemplateArgumentValue(int functionId, int index,
-                                                 int argValue);
-  bool shouldInsertVariableTemplate(int variableId);
-  bool shouldInsertVariableInstantiation(int to, int from);
-  bool shouldInsertVariableTemplateArgument(int variableId, int index,
-                                            int argType);
-  bool shouldInsertVariableTemplateArgumentValue(int variableId, int index,
-                                                 int argValue);
-  bool shouldInsertTemplateTemplateInstantiation(int to, int from);
-  bool shouldInsertTemplateTemplateArgument(int typeId, int index, int argType);
-  bool shouldInsertConceptInstantiation(int conceptId, int templateId);
-  bool shouldInsertConceptTemplateArgument(int conceptId, int index,
-                                           int argType);
-  bool shouldInsertTypeTemplateTypeConstraint(int typeId, int constraintId);
-  bool shouldInsertIsTypeConstraint(int conceptId);
-  bool shouldInsertNontypeTemplateParameter(int id);
-  bool shouldInsertConceptTemplateArgumentValue(int conceptId, int index,
-                                                int argValue);
+  bool shouldInsertClassInstantiation(int64_t to, int64_t from);
+  bool shouldInsertClassTemplateArgument(int64_t typeId, int index,
+                                         int64_t argType);
+  bool shouldInsertClassTemplateArgumentValue(int64_t typeId, int index,
+                                              int64_t argValue);
+  bool shouldInsertFunctionInstantiation(int64_t to, int64_t from);
+  bool shouldInsertFunctionTemplateArgument(int64_t functionId, int index,
+                                            int64_t argType);
+  bool shouldInsertFunctionTemplateArgumentValue(int64_t functionId, int index,
+                                                 int64_t argValue);
+  bool shouldInsertVariableTemplate(int64_t variableId);
+  bool shouldInsertVariableInstantiation(int64_t to, int64_t from);
+  bool shouldInsertVariableTemplateArgument(int64_t variableId, int index,
+                                            int64_t argType);
+  bool shouldInsertVariableTemplateArgumentValue(int64_t variableId, int index,
+                                                 int64_t argValue);
+  bool shouldInsertTemplateTemplateInstantiation(int64_t to, int64_t from);
+  bool shouldInsertTemplateTemplateArgument(int64_t typeId, int index,
+                                            int64_t argType);
+  bool shouldInsertConceptInstantiation(int64_t conceptId, int64_t templateId);
+  bool shouldInsertConceptTemplateArgument(int64_t conceptId, int index,
+                                           int64_t argType);
+  bool shouldInsertTypeTemplateTypeConstraint(int64_t typeId,
+                                              int64_t constraintId);
+  bool shouldInsertIsTypeConstraint(int64_t conceptId);
+  bool shouldInsertNontypeTemplateParameter(int64_t id);
+  bool shouldInsertConceptTemplateArgumentValue(int64_t conceptId, int index,
+                                                int64_t argValue);
 
-  int resolveConceptTemplateId(const clang::ConceptDecl *decl,
-                               clang::ASTContext *context);
-  int resolveConceptSpecializationId(
+  int64_t resolveConceptTemplateId(const clang::ConceptDecl *decl,
+                                   clang::ASTContext *context);
+  int64_t resolveConceptSpecializationId(
       const clang::ConceptSpecializationExpr *expr,
       clang::ASTContext *context);
   // ---- 跨领域模板参数解析 ----
-  int resolveVariableEntityId(const clang::VarDecl *decl);
-  int resolveTemplateArgumentTypeId(clang::QualType argType);
-  int resolveTemplateTemplateParmId(
+  int64_t resolveVariableEntityId(const clang::VarDecl *decl);
+  int64_t resolveTemplateArgumentTypeId(clang::QualType argType);
+  int64_t resolveTemplateTemplateParmId(
       const clang::TemplateTemplateParmDecl *decl);
-  int resolveTemplateTemplateArgumentTypeId(const clang::TemplateArgument &arg);
-  int resolveTemplateArgumentExprId(const clang::Expr *sourceExpr);
+  int64_t resolveTemplateTemplateArgumentTypeId(
+      const clang::TemplateArgument &arg);
+  int64_t resolveTemplateArgumentExprId(const clang::Expr *sourceExpr);
   static const clang::Expr *getTemplateArgumentSourceExpr(
       const clang::TemplateArgumentLoc &argLoc);
 
   void recordClassTemplateTypeArguments(
-      int typeId, const clang::TemplateArgumentList &templateArgs);
+      int64_t typeId, const clang::TemplateArgumentList &templateArgs);
   void recordClassTemplateArgumentValues(
-      int typeId, const clang::ASTTemplateArgumentListInfo *templateArgs);
+      int64_t typeId, const clang::ASTTemplateArgumentListInfo *templateArgs);
   void recordClassTemplateArgumentValues(
-      int typeId, clang::TemplateSpecializationTypeLoc templateArgs);
+      int64_t typeId, clang::TemplateSpecializationTypeLoc templateArgs);
   void recordTemplateTemplateArguments(
-      int typeId, const clang::TemplateArgumentList &templateArgs);
+      int64_t typeId, const clang::TemplateArgumentList &templateArgs);
   void recordTemplateTemplateInstantiations(
       const clang::ClassTemplateDecl *classTemplateDecl,
       const clang::TemplateArgumentList &templateArgs);
   void recordFunctionTemplateTypeArguments(
-      int functionId, const clang::TemplateArgumentList *templateArgs);
+      int64_t functionId, const clang::TemplateArgumentList *templateArgs);
   void recordFunctionTemplateArgumentValues(
-      int functionId, const clang::ASTTemplateArgumentListInfo *templateArgs);
+      int64_t functionId,
+      const clang::ASTTemplateArgumentListInfo *templateArgs);
   void recordFunctionTemplateArgumentValues(
-      int functionId, const clang::TemplateArgumentLoc *templateArgs,
+      int64_t functionId, const clang::TemplateArgumentLoc *templateArgs,
       unsigned numTemplateArgs);
   void recordVariableTemplateTypeArguments(
-      int variableId, const clang::TemplateArgumentList &templateArgs);
+      int64_t variableId, const clang::TemplateArgumentList &templateArgs);
   void recordVariableTemplateArgumentValues(
-      int variableId, const clang::ASTTemplateArgumentListInfo *templateArgs);
+      int64_t variableId,
+      const clang::ASTTemplateArgumentListInfo *templateArgs);
   void recordConceptTemplateTypeArguments(
-      int conceptId, llvm::ArrayRef<clang::TemplateArgument> templateArgs);
+      int64_t conceptId, llvm::ArrayRef<clang::TemplateArgument> templateArgs);
   void recordConceptTemplateArgumentValues(
-      int conceptId, const clang::ConceptSpecializationExpr *expr);
+      int64_t conceptId, const clang::ConceptSpecializationExpr *expr);
   void recordTemplateTypeConstraint(const clang::TemplateTypeParmDecl *decl);
 
   // ---- Visit* orchestration ----
   void processFunctionTemplateSpecialization(
       const clang::FunctionDecl *decl,
-      int functionId);
+      int64_t functionId);
   void processVarTemplateSpecialization(
       const clang::VarTemplateSpecializationDecl *decl,
-      int variableId);
+      int64_t variableId);
   void processClassTemplateSpecialization(
       const clang::ClassTemplateSpecializationDecl *decl);
   void processFriendDecl(const clang::FriendDecl *decl);
@@ -133,35 +146,44 @@ private:
   ExprProcessor *expr_processor_ = nullptr;
   VariableProcessor *variable_processor_ = nullptr;
 
-  std::unordered_set<std::string> classInstantiationDedup;
-  std::unordered_set<std::string> classTemplateArgumentDedup;
-  std::unordered_set<std::string> classTemplateArgumentValueDedup;
-  std::unordered_set<std::string> functionInstantiationDedup;
-  std::unordered_set<std::string> functionTemplateArgumentDedup;
-  std::unordered_set<std::string> functionTemplateArgumentValueDedup;
-  std::unordered_set<std::string> variableTemplateDedup;
-  std::unordered_set<std::string> variableInstantiationDedup;
-  std::unordered_set<std::string> variableTemplateArgumentDedup;
-  std::unordered_set<std::string> variableTemplateArgumentValueDedup;
-  std::unordered_set<std::string> templateTemplateInstantiationDedup;
-  std::unordered_set<std::string> templateTemplateArgumentDedup;
-  std::unordered_set<std::string> conceptInstantiationDedup;
-  std::unordered_set<std::string> conceptTemplateArgumentDedup;
-  std::unordered_set<std::string> typeTemplateTypeConstraintDedup;
-  std::unordered_set<int> isTypeConstraintDedup;
-  std::unordered_set<int> nontypeTemplateParameterDedup;
-  std::unordered_set<std::string> conceptTemplateArgumentValueDedup;
-  std::unordered_map<std::string, int> conceptTemplateIds;
-  std::unordered_map<std::string, int> conceptSpecializationIds;
+  // 去重键由ID直接组成, 存放在开放寻址的 DenseSet 中, 检查时不再格式化字符串
+  using PairKey = std::pair<int64_t, int64_t>;
+  using TripleKey = std::tuple<int64_t, int64_t, int64_t>;
+
+  llvm::DenseSet<PairKey> classInstantiationDedup;
+  llvm::DenseSet<TripleKey> classTemplateArgumentDedup;
+  llvm::DenseSet<TripleKey> classTemplateArgumentValueDedup;
+  llvm::DenseSet<PairKey> functionInstantiationDedup;
+  llvm::DenseSet<TripleKey> functionTemplateArgumentDedup;
+  llvm::DenseSet<TripleKey> functionTemplateArgumentValueDedup;
+  llvm::DenseSet<int64_t> variableTemplateDedup;
+  llvm::DenseSet<PairKey> variableInstantiationDedup;
+  llvm::DenseSet<TripleKey> variableTemplateArgumentDedup;
+  llvm::DenseSet<TripleKey> variableTemplateArgumentValueDedup;
+  llvm::DenseSet<PairKey> templateTemplateInstantiationDedup;
+  llvm::DenseSet<TripleKey> templateTemplateArgumentDedup;
+  llvm::DenseSet<PairKey> conceptInstantiationDedup;
+  llvm::DenseSet<TripleKey> conceptTemplateArgumentDedup;
+  llvm::DenseSet<PairKey> typeTemplateTypeConstraintDedup;
+  llvm::DenseSet<int64_t> isTypeConstraintDedup;
+  llvm::DenseSet<int64_t> nontypeTemplateParameterDedup;
+  llvm::DenseSet<TripleKey> conceptTemplateArgumentValueDedup;
+  std::unordered_map<Fingerprint, int64_t> conceptTemplateIds;
+  std::unordered_map<Fingerprint, int64_t> conceptSpecializationIds;
 
-  static std::string makePairKey(int first, int second);
-  static std::string makeTripleKey(int first, int second, int third);
-  static std::string makeConceptTemplateKey(const clang::ConceptDecl *decl,
+  static PairKey makePairKey(int64_t first, int64_t second) {
+    return {first, second};
+  }
+  static TripleKey makeTripleKey(int64_t first, int64_t second,
+                                 int64_t third) {
+    return {first, second, third};
+  }
+  static Fingerprint makeConceptTemplateKey(const clang::ConceptDecl *decl,
                                             clang::ASTContext *context);
-  static std::string makeTemplateArgumentListKey(
+  static void printTemplateArgumentListKey(
       llvm::ArrayRef<clang::TemplateArgument> args,
-      clang::ASTContext *context);
-  static std::string makeConceptSpecializationKey(
+      clang::ASTContext *context, llvm::raw_ostream &os);
+  static Fingerprint makeConceptSpecializationKey(
       const clang::ConceptSpecializationExpr *expr,
       clang::ASTContext *context);
 };
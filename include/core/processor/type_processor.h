@@ -6,52 +6,65 @@
 #include "model/db/type.h"
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclTemplate.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SmallString.h>
 
 using namespace clang;
 
 class TypeProcessor : public BaseProcessor {
 public:
-  int processType(const Type *T);
+  int64_t processType(const Type *T);
 
   // Specific type declaration processing methods
   void processRecordDecl(const RecordDecl *RD);
   void processEnumDecl(const EnumDecl *ED);
   void processTypedefDecl(const TypedefDecl *TND);
-  int processTemplateTypeParmDecl(const TemplateTypeParmDecl *TTPD);
-  int processTemplateTemplateParmDecl(const TemplateTemplateParmDecl *TTPD);
-  int processDependentType(QualType QT);
+  int64_t processTemplateTypeParmDecl(const TemplateTypeParmDecl *TTPD);
+  int64_t processTemplateTemplateParmDecl(const TemplateTemplateParmDecl *TTPD);
+  int64_t processDependentType(QualType QT);
   void processTypeDecl(const TypeDecl *TD);
-  int processRecordDeclType(const RecordDecl *RD);
+  int64_t processRecordDeclType(const RecordDecl *RD);
   void processRecordType(const RecordType *RT);
-  int processBuiltinType(const BuiltinType *BT, ASTContext *ast_context);
+  int64_t processBuiltinType(const BuiltinType *BT, ASTContext *ast_context);
 
   TypeProcessor(ASTContext *ast_context, const PrintingPolicy pp)
-      : BaseProcessor(ast_context, pp) {};
+      : BaseProcessor(ast_context, pp, ProcessorKind::Type) {};
   ~TypeProcessor() = default;
 
   // Getter for the last processed type ID
-  int getLastTypeId() const { return _typeId; }
+  int64_t getLastTypeId() const { return _typeId; }
 
 private:
-  int _typeId;
-  int _typeDeclId;
+  int64_t _typeId;
+  int64_t _typeDeclId;
 
-  int processDerivedType(
+  // 本TU内已处理过的节点 (处理器随 ASTVisitor 按TU创建), 在生成 Key 之前短路
+  llvm::DenseMap<const Type *, int64_t> type_ids_; // 规范类型 -> ID
+  llvm::DenseMap<const BuiltinType *, int64_t> builtin_type_ids_;
+  llvm::DenseMap<const RecordDecl *, int64_t> record_type_ids_;
+  llvm::DenseSet<const RecordType *> recorded_record_types_;
+
+  // 类型拼写先打印到复用的缓冲区, 再驻留到 StringPool
+  llvm::SmallString<128> print_buffer_;
+  InternedString internTypeName(QualType QT);
+
+  int64_t processDerivedType(
       const Type *T,
       const std::optional<std::pair<DerivedTypeKind, QualType>> derived_result,
       ASTContext *ast_context);
-  int processUserType(const Type *TP, ASTContext *ast_context);
-  int processRoutineType(const Type *TP, ASTContext *ast_context);
-  int processPtrToMemberType(const MemberPointerType *MPT,
-                             ASTContext *ast_context);
-  int processDeclType(const DecltypeType *DT, ASTContext *ast_context);
+  int64_t processUserType(const Type *TP, ASTContext *ast_context);
+  int64_t processRoutineType(const Type *TP, ASTContext *ast_context);
+  int64_t processPtrToMemberType(const MemberPointerType *MPT,
+                                 ASTContext *ast_context);
+  int64_t processDeclType(const DecltypeType *DT, ASTContext *ast_context);
   // void processRecordType(const RecordType *RT);
 
   // New C language feature processing methods
-  void processEnumConstants(const EnumDecl *ED, int parentEnumId);
-  void processTypedefBase(const TypedefNameDecl *TND, int typedefId);
-  void processArraySizes(const ArrayType *AT, int derivedTypeId);
-  void processPointerishSize(const Type *T, int derivedTypeId);
+  void processEnumConstants(const EnumDecl *ED, int64_t parentEnumId);
+  void processTypedefBase(const TypedefNameDecl *TND, int64_t typedefId);
+  void processArraySizes(const ArrayType *AT, int64_t derivedTypeId);
+  void processPointerishSize(const Type *T, int64_t derivedTypeId);
 
   void recordTypeDef(const TypeDecl *TD);
   void recordTopTypeDecl(const TypeDecl *TD);
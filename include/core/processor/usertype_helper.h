@@ -9,7 +9,7 @@
 
 using namespace clang;
 
-void record_is_pod_class(const Type *TP, int usertype_id) {
+void record_is_pod_class(const Type *TP, int64_t usertype_id) {
   if (!TP) {
     LOG_WARNING << "Null type pointer" << std::endl;
     return;
@@ -40,7 +40,7 @@ void record_is_pod_class(const Type *TP, int usertype_id) {
   STG.insertClassObj(isPodClassModel);
 }
 
-void record_is_standard_layout_class(const Type *TP, int userTypeId) {
+void record_is_standard_layout_class(const Type *TP, int64_t userTypeId) {
   if (!TP) {
     LOG_WARNING << "Null type pointer" << std::endl;
     return;
@@ -70,7 +70,7 @@ void record_is_standard_layout_class(const Type *TP, int userTypeId) {
   STG.insertClassObj(isStandardLayoutClassModel);
 }
 
-void record_is_complete(const Type *TP, int userTypeId) {
+void record_is_complete(const Type *TP, int64_t userTypeId) {
   if (!TP) {
     LOG_WARNING << "Null type pointer" << std::endl;
     return;
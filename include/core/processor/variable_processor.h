@@ -4,38 +4,41 @@
 #include "core/processor/base_processor.h"
 #include "core/srcloc_recorder.h"
 #include "model/db/function.h"
+#include "util/string_pool.h"
 #include <clang/AST/Decl.h>
 
 using namespace clang;
 
 class VariableProcessor : public BaseProcessor {
 public:
-  int processVarDecl(const VarDecl *VD);
-  int processParmVarDecl(const ParmVarDecl *PVD);
-  int processFieldDecl(const FieldDecl *FD);
-  int resolveMemberVarId(const FieldDecl *FD, int type_id);
+  int64_t processVarDecl(const VarDecl *VD);
+  int64_t processParmVarDecl(const ParmVarDecl *PVD);
+  int64_t processFieldDecl(const FieldDecl *FD);
+  int64_t resolveMemberVarId(const FieldDecl *FD, int64_t type_id);
 
   VariableProcessor(ASTContext *ast_context, const PrintingPolicy pp)
-      : BaseProcessor(ast_context, pp) {};
+      : BaseProcessor(ast_context, pp, ProcessorKind::Variable) {};
   ~VariableProcessor() = default;
 
 private:
-  int _typeId;
-  int _varId;
-  int _varDeclId;
-  std::string _name;
+  int64_t _typeId;
+  int64_t _varId;
+  int64_t _varDeclId;
+  InternedString _name;
 
   void recordSpecialize(const VarDecl *VD);
   void recordStructuredBinding(const VarDecl *VD);
   void recordRequire(const VarDecl *VD);
 
-  int processLocalScopeVar(const VarDecl *VD);
-  int processGlobalVar(const VarDecl *VD);
-  int processMemberVar(const VarDecl *VD);
-  int processMemberVar(const FieldDecl *FD);
+  int64_t processLocalScopeVar(const VarDecl *VD);
+  int64_t processGlobalVar(const VarDecl *VD);
+  int64_t processMemberVar(const VarDecl *VD);
+  int64_t processMemberVar(const FieldDecl *FD);
 
-  int processLocalVar(const VarDecl *VD);
-  int processParam(const VarDecl *VD);
+  int64_t processLocalVar(const VarDecl *VD);
+  int64_t processParam(const VarDecl *VD);
+  // 登记变量的 Key, 返回本线程生成的 varId 是否胜出
+  bool claimVar(const VarDecl *VD, int64_t varId);
 };
 
 #endif // _VARIABLE_PROCESSOR_H_
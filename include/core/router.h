@@ -2,7 +2,9 @@
 #define _ROUTER_H_
 
 #include "model/config/configuration.h"
+#include <clang/AST/ASTContext.h>
 #include <string>
+#include <vector>
 
 class Router {
 public:
@@ -20,7 +22,15 @@ private:
   ~Router() = default;
   Router() = default;
 
-  void parseAST(const std::string &source_path);
+  void parseAST(const std::vector<std::string> &source_paths);
+  // 逐个TU解析并记录各TU在各表中的 rowid 区间与读取过的文件, 供下次增量抽取使用
+  void parseASTIncremental(const std::vector<std::string> &source_paths);
+  // 多个工作线程并行解析TU, 由 StorageFacade 的写线程统一落库
+  void parseASTParallel(const std::vector<std::string> &source_paths,
+                        unsigned jobs);
+  static void handleTranslationUnit(clang::ASTContext &context);
+
+  ExtractionConfig extraction_;
 };
 
 #endif // _ROUTER_H_
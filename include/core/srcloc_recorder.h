@@ -4,37 +4,74 @@
 #include "model/db/location.h"
 #include <clang/AST/Stmt.h>
 #include <clang/Basic/SourceLocation.h>
+#include <cstdint>
+#include <llvm/ADT/DenseMap.h>
+#include <shared_mutex>
+#include <unordered_map>
 
 using namespace clang;
 
 // Struct as the return type for location and specification IDs
 struct LocIdPair {
-  int location_id;
-  int spec_id;
+  int64_t location_id;
+  int64_t spec_id;
 };
 
 class SrcLocRecorder {
 public:
-  static LocIdPair *processDefault(const Stmt *stmt, ASTContext *context);
-  static LocIdPair *processStmt(const Stmt *stmt, ASTContext *context);
-  static LocIdPair *processExpr(const Stmt *stmt, ASTContext *context);
-  static LocIdPair *processDefault(const Decl *decl, ASTContext *context);
-  static LocIdPair *processStmt(const Decl *decl, ASTContext *context);
-  static LocIdPair *processExpr(const Decl *decl, ASTContext *context);
-  static LocIdPair *processDefault(const SourceLocation beginLoc,
-                                   const SourceLocation endLoc,
-                                   ASTContext *context);
-  static LocIdPair *processStmt(const SourceLocation beginLoc,
-                                const SourceLocation endLoc,
-                                ASTContext *context);
-  static LocIdPair *processExpr(const SourceLocation beginLoc,
-                                const SourceLocation endLoc,
-                                ASTContext *context);
+  static LocIdPair processDefault(const Stmt *stmt, ASTContext *context);
+  static LocIdPair processStmt(const Stmt *stmt, ASTContext *context);
+  static LocIdPair processExpr(const Stmt *stmt, ASTContext *context);
+  static LocIdPair processDefault(const Decl *decl, ASTContext *context);
+  static LocIdPair processStmt(const Decl *decl, ASTContext *context);
+  static LocIdPair processExpr(const Decl *decl, ASTContext *context);
+  static LocIdPair processDefault(const SourceLocation beginLoc,
+                                 const SourceLocation endLoc,
+                                 ASTContext *context);
+  static LocIdPair processStmt(const SourceLocation beginLoc,
+                              const SourceLocation endLoc,
+                              ASTContext *context);
+  static LocIdPair processExpr(const SourceLocation beginLoc,
+                              const SourceLocation endLoc,
+                              ASTContext *context);
+
+  // 开始解析新的TU: FileID 只在各自的 SourceManager 内有效, 清空本线程的缓存
+  static void enterTranslationUnit();
+  // 丢弃已记录的位置, 之后的位置不再复用此前TU写入的行(增量模式下各TU独立)
+  static void clearInterned();
 
 private:
-  static LocIdPair *process(const SourceLocation beginLoc,
-                            const SourceLocation endLoc,
-                            const LocationType type, ASTContext *context);
+  // 位置的去重键: 同一文件中相同的起止范围和类型只记录一行
+  struct LocKey {
+    int64_t container;
+    int start_line, start_column, end_line, end_column;
+    LocationType type;
+
+    bool operator==(const LocKey &other) const {
+      return container == other.container &&
+             start_line == other.start_line &&
+             start_column == other.start_column &&
+             end_line == other.end_line && end_column == other.end_column &&
+             type == other.type;
+    }
+  };
+  struct LocKeyHash {
+    size_t operator()(const LocKey &key) const;
+  };
+
+  static LocIdPair process(const SourceLocation beginLoc,
+                           const SourceLocation endLoc,
+                           const LocationType type, ASTContext *context);
+  static LocIdPair insertLocation(const LocKey &key);
+  // FileID -> files 记录, 每个文件只在首次出现时查找路径
+  static int64_t getContainerId(FileID fileID,
+                                const SourceManager &sourceManager);
+
+  static thread_local llvm::DenseMap<FileID, int64_t> file_containers_;
+
+  // 多个前端工作线程共享, 宏展开/隐式代码/模板实例化的重复范围复用同一行
+  static std::unordered_map<LocKey, LocIdPair, LocKeyHash> interned_;
+  static std::shared_mutex interned_mutex_;
 };
 
 #define PROC_DEFT SrcLocRecorder::processDefault
@@ -1,31 +1,200 @@
 #ifndef _CACHE_REPOSITORY_H_
 #define _CACHE_REPOSITORY_H_
 
-#include <memory>
+#include "db/cache_spill.h"
+#include "util/bloom_filter.h"
+#include "util/flat_hash_map.h"
+#include "util/processor_metrics.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <optional>
-#include <typeindex>
+#include <shared_mutex>
+#include <string>
+#include <typeinfo>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+// CacheManager 通过该接口统一清空仓库与读写容量提示
+class CacheRepositoryBase {
+public:
+  virtual ~CacheRepositoryBase() = default;
+  virtual void clear() = 0;
+  virtual void reserve(size_t count) = 0;
+  // clear 之前曾达到的最大元素数, 作为下次运行的容量提示
+  virtual size_t peakSize() const = 0;
+};
+
+// 未设置内存上限时所有映射常驻内存. 设置上限后按两代近似 LRU 管理:
+// 新插入与最近被访问的条目位于当前代, 总内存超限时上一代整体溢出到
+// CacheSpill, 当前代降为上一代; 在上一代或溢出表中命中的条目提升回当前代.
+// 溢出的 Key 同时记入布隆过滤器, 过滤器判定不存在的 Key 不必查询溢出表
 template <typename Model, typename KeyType = typename Model::KeyType,
-          typename IdType = int>
-class CacheRepository {
+          typename IdType = std::int64_t>
+class CacheRepository : public CacheRepositoryBase {
 public:
+  CacheRepository() : spill_id_(CacheSpill::instance().nextRepositoryId()) {}
+
+  // 多个前端工作线程共享同一份缓存, 读多写少, 使用读写锁;
+  // 内存受限模式下当前代未命中时才需要独占锁, 以便把冷数据提升回当前代
   std::optional<IdType> find(const KeyType &key) const {
-    if (auto it = cache_.find(key); it != cache_.end())
-      return it->second;
-    return std::nullopt;
+    std::optional<IdType> result;
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      if (const IdType *id = hot_.find(key))
+        result = *id;
+    }
+    if (!result && CacheSpill::instance().enabled()) {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
+      result = findBounded(key, true);
+      if (!result)
+        lastMiss() = {this, key, generation_};
+    }
+    ProcessorMetrics::countCacheLookup(result.has_value());
+    return result;
   }
 
   IdType insert(const KeyType &key, IdType id) {
-    return cache_.emplace(key, id).first->second;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!CacheSpill::instance().enabled())
+      return *hot_.try_emplace(key, id).first;
+    // 已降为冷数据的 Key 保持原有 ID. 本线程刚查找未命中且其后没有换代时,
+    // 溢出表不会新增该 Key, 只需检查内存中的两代
+    MissMemo &miss = lastMiss();
+    const bool checkSpill = miss.repository != this ||
+                            miss.generation != generation_ || miss.key != key;
+    miss.repository = nullptr;
+    if (auto existing = findBounded(key, checkSpill))
+      return *existing;
+    hot_.try_emplace(key, id);
+    trackMemory();
+    return id;
+  }
+
+  // 内存受限模式下包含已溢出的条目, 为近似值
+  size_t size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return hot_.size() + warm_.size() + spilled_;
+  }
+
+  void clear() override {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    peak_ = std::max(peak_, hot_.size() + warm_.size() + spilled_);
+    hot_.clear();
+    warm_ = FlatHashMap<KeyType, IdType>();
+    if (spilled_ > 0) {
+      CacheSpill::instance().drop(spill_id_);
+      spilled_ = 0;
+    }
+    spill_filters_.clear();
+    ++generation_;
+    if (CacheSpill::instance().enabled())
+      trackMemory();
   }
 
-  size_t size() const { return cache_.size(); }
+  // 内存受限模式下不按上次的规模预留, 由上限决定容量
+  void reserve(size_t count) override {
+    if (CacheSpill::instance().enabled())
+      return;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    hot_.reserve(count);
+  }
 
-  void clear() { cache_.clear(); }
+  size_t peakSize() const override {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return std::max(peak_, hot_.size() + warm_.size() + spilled_);
+  }
 
 private:
-  std::unordered_map<KeyType, IdType> cache_;
+  // 本线程最近一次在内存受限模式下未命中的 Key 与当时的换代次数
+  struct MissMemo {
+    const CacheRepository *repository = nullptr;
+    KeyType key{};
+    size_t generation = 0;
+  };
+
+  static MissMemo &lastMiss() {
+    static thread_local MissMemo miss;
+    return miss;
+  }
+
+  // 调用方需持有独占锁
+  std::optional<IdType> findBounded(const KeyType &key, bool checkSpill) const {
+    if (const IdType *id = hot_.find(key))
+      return *id;
+    std::optional<IdType> id;
+    if (const IdType *warm = warm_.find(key))
+      id = *warm;
+    else if (checkSpill && mayBeSpilled(key))
+      id = CacheSpill::instance().lookup(spill_id_, spillKey(key));
+    if (id) {
+      hot_.try_emplace(key, *id);
+      trackMemory();
+    }
+    return id;
+  }
+
+  // 最后一个过滤器装满后新建容量翻倍的过滤器, 过滤器个数随溢出总量对数增长
+  void filterSpilled(const KeyType &key) const {
+    if (spill_filters_.empty() || spill_filters_.back().full()) {
+      size_t capacity = warm_.size();
+      if (!spill_filters_.empty())
+        capacity = std::max(capacity, spill_filters_.back().capacity() * 2);
+      spill_filters_.emplace_back(capacity);
+    }
+    spill_filters_.back().add(key);
+  }
+
+  bool mayBeSpilled(const KeyType &key) const {
+    for (const auto &filter : spill_filters_)
+      if (filter.mayContain(key))
+        return true;
+    return false;
+  }
+
+  // 同步本仓库占用的字节数; 增长后总量超限时把上一代溢出到磁盘
+  void trackMemory() const {
+    CacheSpill &spill = CacheSpill::instance();
+    const size_t bytes = hot_.memoryBytes() + warm_.memoryBytes();
+    if (bytes == accounted_)
+      return;
+    const bool grew = bytes > accounted_;
+    const bool over = spill.account(static_cast<std::ptrdiff_t>(bytes) -
+                                    static_cast<std::ptrdiff_t>(accounted_));
+    accounted_ = bytes;
+    if (grew && over && spill.worthSpilling(bytes))
+      rotate();
+  }
+
+  void rotate() const {
+    std::vector<std::pair<std::string, std::int64_t>> rows;
+    rows.reserve(warm_.size());
+    warm_.forEach([this, &rows](const KeyType &key, IdType id) {
+      rows.emplace_back(std::string(spillKey(key)), id);
+      filterSpilled(key);
+    });
+    CacheSpill::instance().write(spill_id_, rows);
+    spilled_ += rows.size();
+    ++generation_;
+    warm_ = std::move(hot_);
+    hot_ = FlatHashMap<KeyType, IdType>();
+    trackMemory();
+  }
+
+  mutable std::shared_mutex mutex_;
+  // find 在内存受限模式下会提升条目, 以下状态对调用方不可见
+  mutable FlatHashMap<KeyType, IdType> hot_;
+  mutable FlatHashMap<KeyType, IdType> warm_;
+  mutable size_t spilled_ = 0;
+  mutable size_t accounted_ = 0;
+  // 已溢出 Key 的过滤器, 每个 Key 约占 10 位, 不计入内存上限
+  mutable std::vector<BloomFilter<KeyType>> spill_filters_;
+  // 换代(溢出)与清空的次数, 用于判断本线程记录的未命中是否仍然有效
+  mutable size_t generation_ = 0;
+  const int spill_id_;
+  size_t peak_ = 0;
 };
 
 // Cache Manager Singleton
@@ -36,30 +205,51 @@ public:
     return instance;
   }
 
+  // 每种仓库类型对应一个静态实例, 在编译期确定; 首次使用时登记,
+  // 之后的 SEARCH_* / INSERT_* 不再经过类型映射与管理器的锁
   template <typename RepoType> RepoType &getRepository() {
-    // Try to get the repository from the map, if not found, create a new one
-    auto [it, inserted] = repositories_.try_emplace(typeid(RepoType));
-    if (inserted)
-      it->second = std::make_unique<Holder<RepoType>>();
+    static RepoType repo;
+    static const bool registered =
+        (registerRepository(typeid(RepoType).name(), repo), true);
+    (void)registered;
+    return repo;
+  }
 
-    return *static_cast<Holder<RepoType> *>(it->second.get())->repo;
+  void clearAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[name, repo] : repositories_)
+      repo->clear();
   }
 
-  void clearAll() { repositories_.clear(); }
+  // 上次运行各仓库的规模, 已登记与之后登记的仓库据此预留容量
+  void setReserveHints(std::unordered_map<std::string, size_t> hints) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hints_ = std::move(hints);
+    for (auto &[name, repo] : repositories_)
+      if (auto it = hints_.find(name); it != hints_.end())
+        repo->reserve(it->second);
+  }
 
-private:
-  // RepositoryBase Type
-  struct RepositoryBase {
-    virtual ~RepositoryBase() = default;
-  };
+  // 各仓库名称(仓库类型的 typeid 名)与本次运行达到的最大规模
+  std::vector<std::pair<std::string, size_t>> peakSizes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::pair<std::string, size_t>> sizes;
+    for (const auto &[name, repo] : repositories_)
+      sizes.emplace_back(name, repo->peakSize());
+    return sizes;
+  }
 
-  // Holder for RepositoryBase
-  template <typename T> struct Holder : RepositoryBase {
-    std::unique_ptr<T> repo = std::make_unique<T>();
-  };
+private:
+  void registerRepository(const char *name, CacheRepositoryBase &repo) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    repositories_.emplace_back(name, &repo);
+    if (auto it = hints_.find(name); it != hints_.end())
+      repo.reserve(it->second);
+  }
 
-  std::unordered_map<std::type_index, std::unique_ptr<RepositoryBase>>
-      repositories_;
+  std::vector<std::pair<std::string, CacheRepositoryBase *>> repositories_;
+  std::unordered_map<std::string, size_t> hints_;
+  mutable std::mutex mutex_;
 
   CacheManager() = default;
   ~CacheManager() = default;
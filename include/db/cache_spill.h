@@ -0,0 +1,80 @@
+#ifndef _DB_CACHE_SPILL_H_
+#define _DB_CACHE_SPILL_H_
+
+#include "util/fingerprint.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+// 缓存Key写入溢出表时的字节表示
+inline std::string_view spillKey(const Fingerprint &key) {
+  return {reinterpret_cast<const char *>(&key), sizeof(key)};
+}
+
+inline std::string_view spillKey(const std::string &key) { return key; }
+
+// 内存受限模式下缓存仓库的溢出存储: 冷数据按 (仓库, Key) 写入临时 SQLite 库,
+// 热数据留在内存; 未设置内存上限时不打开任何连接
+class CacheSpill {
+public:
+  static CacheSpill &instance() {
+    static CacheSpill instance;
+    return instance;
+  }
+
+  // 所有缓存仓库热数据占用内存的上限, 0 表示不限制(不溢出)
+  void setMemoryLimit(size_t bytes);
+  bool enabled() const { return limit_ > 0; }
+
+  // 热数据占用的字节数变化, 返回变化后是否超出上限
+  bool account(std::ptrdiff_t delta);
+  size_t memoryBytes() const { return bytes_.load(std::memory_order_relaxed); }
+  // 只让占上限一定比例以上的仓库溢出, 避免小仓库在总量超限时反复换代
+  bool worthSpilling(size_t repositoryBytes) const {
+    return repositoryBytes * 32 >= limit_;
+  }
+
+  // 为新的缓存仓库分配溢出表中的编号
+  int nextRepositoryId() { return next_repository_id_++; }
+
+  void write(int repository,
+             const std::vector<std::pair<std::string, std::int64_t>> &rows);
+  std::optional<std::int64_t> lookup(int repository, std::string_view key);
+  void drop(int repository);
+
+  // 累计写出的记录数, 以及命中溢出表的查找次数
+  size_t spilledRows() const { return spilled_rows_; }
+  size_t spillHits() const { return spill_hits_; }
+
+  CacheSpill(const CacheSpill &) = delete;
+  CacheSpill &operator=(const CacheSpill &) = delete;
+
+private:
+  CacheSpill() = default;
+  ~CacheSpill();
+
+  void open();
+
+  size_t limit_ = 0;
+  std::atomic<size_t> bytes_{0};
+  std::atomic<int> next_repository_id_{0};
+
+  std::mutex mutex_;
+  sqlite3 *db_ = nullptr;
+  sqlite3_stmt *insert_ = nullptr;
+  sqlite3_stmt *select_ = nullptr;
+  sqlite3_stmt *delete_ = nullptr;
+  size_t spilled_rows_ = 0;
+  size_t spill_hits_ = 0;
+};
+
+#endif // _DB_CACHE_SPILL_H_
@@ -1,11 +1,27 @@
 #ifndef _DB_DEPENDENCY_MANAGER_H_
 #define _DB_DEPENDENCY_MANAGER_H_
 
-#include <functional>
-#include <string>
+#include "db/storage_facade.h"
+#include "model/db/declaration.h"
+#include "model/db/expr.h"
+#include "model/db/function.h"
+#include "model/db/stmt.h"
+#include "model/db/type.h"
+#include "model/db/variable.h"
+#include "util/fingerprint.h"
+#include "util/logger/macros.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
 #include <vector>
 
-using KeyType = std::string;
+using KeyType = Fingerprint;
 
 // 用于指定Key属于哪种类型的缓存，以便DependencyManager知道去哪里查找
 enum class CacheType {
@@ -19,21 +35,40 @@ enum class CacheType {
   ELEMENT
 };
 
-// 描述一个待处理的更新操作
-struct PendingUpdate {
-  KeyType dependencyKey;                // 依赖的节点的Key
-  CacheType keyType;                    // Key的类型，用于指定搜索哪个缓存
-  std::function<void(int)> updater;     // 获取ID后要执行的更新回调函数
-};
+inline constexpr size_t kCacheTypeCount =
+    static_cast<size_t>(CacheType::ELEMENT) + 1;
+
+// 回填记录的行标识: 能唯一定位已写入记录的列, 回填时只 UPDATE 被依赖的列.
+// 无标识的模型只有被回填的一列, 解析出 ID 后才整行写入
+template <typename Model> struct FixupRow;
+
+#define DECLARE_FIXUP_ROW(Model, ...)                                          \
+  template <> struct FixupRow<DbModel::Model> {                                \
+    inline static const std::vector<int64_t DbModel::Model::*> keys{           \
+        __VA_ARGS__};                                                          \
+  }
+
+#define DECLARE_FIXUP_ROW_NO_IDENTITY(Model)                                   \
+  template <> struct FixupRow<DbModel::Model> {                                \
+    inline static const std::vector<int64_t DbModel::Model::*> keys;           \
+  }
 
 class DependencyManager {
 public:
   static DependencyManager &instance();
 
-  // 添加一个新的待处理依赖
-  void addDependency(const PendingUpdate &update);
+  // 登记一条待回填的记录: 依赖的 Key 解析出 ID 后写入 row 所在记录的
+  // column 列. row 需已交给 StorageFacade 写入, 这里只取其行标识
+  template <typename Model>
+  void addDependency(const KeyType &dependencyKey, CacheType keyType,
+                     const Model &row, int64_t Model::*column);
 
-  // 在AST遍历结束后，解析所有依赖
+  // 关闭后不再登记依赖该类缓存的记录, 其ID列保持 -1 (对应表族未抽取时使用)
+  void setCacheTypeEnabled(CacheType keyType, bool enabled) {
+    disabled_[static_cast<size_t>(keyType)] = !enabled;
+  }
+
+  // 在AST遍历结束后，按表批量解析所有依赖
   void resolveDependencies();
 
 private:
@@ -42,7 +77,148 @@ private:
   DependencyManager(const DependencyManager &) = delete;
   DependencyManager &operator=(const DependencyManager &) = delete;
 
-  std::vector<PendingUpdate> pending_updates_;
+  // 单个模型类型的回填队列, 按依赖的缓存类型分组存放
+  struct FixupStoreBase {
+    virtual ~FixupStoreBase() = default;
+    // 返回 {已解析数, 未解析数}
+    virtual std::pair<size_t, size_t> resolve() = 0;
+  };
+  template <typename Model> struct FixupStore;
+
+  static size_t nextSlot();
+  template <typename Model> static size_t slotOf();
+
+  // 在 keyType 对应的缓存中批量查找 keys, 结果写入 ids (未找到为 nullopt)
+  static void findIds(CacheType keyType, const std::vector<KeyType> &keys,
+                      std::vector<std::optional<int64_t>> &ids);
+
+  std::vector<std::unique_ptr<FixupStoreBase>> stores_; // 下标为类型槽位
+  std::mutex mutex_; // 多个前端工作线程会同时登记依赖
+  std::array<bool, kCacheTypeCount> disabled_{};
 };
 
+DECLARE_FIXUP_ROW(DerivedType, &DbModel::DerivedType::id);
+DECLARE_FIXUP_ROW(RoutineType, &DbModel::RoutineType::id);
+DECLARE_FIXUP_ROW(RoutineTypeArg, &DbModel::RoutineTypeArg::routine,
+                  &DbModel::RoutineTypeArg::index);
+DECLARE_FIXUP_ROW(PtrToMember, &DbModel::PtrToMember::id);
+DECLARE_FIXUP_ROW(DeclType, &DbModel::DeclType::id);
+DECLARE_FIXUP_ROW_NO_IDENTITY(IsClassTemplate);
+DECLARE_FIXUP_ROW(FunctionInstantiation, &DbModel::FunctionInstantiation::to);
+DECLARE_FIXUP_ROW_NO_IDENTITY(IsFunctionTemplate);
+DECLARE_FIXUP_ROW(FriendDecl, &DbModel::FriendDecl::id);
+DECLARE_FIXUP_ROW(FunDecl, &DbModel::FunDecl::id);
+DECLARE_FIXUP_ROW(FuncEntryPt, &DbModel::FuncEntryPt::id);
+DECLARE_FIXUP_ROW(FuncRetType, &DbModel::FuncRetType::id);
+DECLARE_FIXUP_ROW(FunDeclThrow, &DbModel::FunDeclThrow::fun_decl,
+                  &DbModel::FunDeclThrow::index);
+DECLARE_FIXUP_ROW(FunDeclNoexcept, &DbModel::FunDeclNoexcept::fun_decl);
+DECLARE_FIXUP_ROW(FunDeclTypedefType, &DbModel::FunDeclTypedefType::fun_decl);
+DECLARE_FIXUP_ROW(Coroutine, &DbModel::Coroutine::function);
+DECLARE_FIXUP_ROW(CoroutineNew, &DbModel::CoroutineNew::function);
+DECLARE_FIXUP_ROW(CoroutineDelete, &DbModel::CoroutineDelete::function);
+DECLARE_FIXUP_ROW(DeductionGuideForClass,
+                  &DbModel::DeductionGuideForClass::id);
+DECLARE_FIXUP_ROW(IfInit, &DbModel::IfInit::if_stmt);
+DECLARE_FIXUP_ROW(IfThen, &DbModel::IfThen::if_stmt);
+DECLARE_FIXUP_ROW(IfElse, &DbModel::IfElse::if_stmt);
+DECLARE_FIXUP_ROW(ForInit, &DbModel::ForInit::for_stmt);
+DECLARE_FIXUP_ROW(ForCond, &DbModel::ForCond::for_stmt);
+DECLARE_FIXUP_ROW(ForUpdate, &DbModel::ForUpdate::for_stmt);
+DECLARE_FIXUP_ROW(ForBody, &DbModel::ForBody::for_stmt);
+DECLARE_FIXUP_ROW(WhileBody, &DbModel::WhileBody::while_stmt);
+DECLARE_FIXUP_ROW(DoBody, &DbModel::DoBody::do_stmt);
+DECLARE_FIXUP_ROW(SwitchInit, &DbModel::SwitchInit::switch_stmt);
+DECLARE_FIXUP_ROW(SwitchBody, &DbModel::SwitchBody::switch_stmt);
+DECLARE_FIXUP_ROW(SwitchCase, &DbModel::SwitchCase::switch_stmt,
+                  &DbModel::SwitchCase::index);
+DECLARE_FIXUP_ROW(VarDecl, &DbModel::VarDecl::id);
+DECLARE_FIXUP_ROW(VarRequire, &DbModel::VarRequire::id);
+DECLARE_FIXUP_ROW(Parameter, &DbModel::Parameter::id);
+DECLARE_FIXUP_ROW(FunBind, &DbModel::FunBind::expr);
+DECLARE_FIXUP_ROW(AggregateFieldInit, &DbModel::AggregateFieldInit::aggregate,
+                  &DbModel::AggregateFieldInit::position);
+
+template <typename Model>
+struct DependencyManager::FixupStore : FixupStoreBase {
+  // 每条回填只记录依赖的 Key、被回填的列和行标识列的取值
+  struct Group {
+    std::vector<KeyType> keys;
+    std::vector<int64_t Model::*> columns;
+    std::vector<int64_t> rowKeys; // 按 FixupRow<Model>::keys 的顺序平铺
+  };
+  std::array<Group, kCacheTypeCount> groups;
+
+  std::pair<size_t, size_t> resolve() override {
+    const auto &keyColumns = FixupRow<Model>::keys;
+    const size_t stride = keyColumns.size();
+    size_t resolved = 0, unresolved = 0;
+    std::vector<std::optional<int64_t>> ids;
+    // 按被回填的列分组, 每组元素依次为解析出的 ID 和行标识
+    std::vector<std::pair<int64_t Model::*, std::vector<int64_t>>> updates;
+    for (size_t type = 0; type < kCacheTypeCount; ++type) {
+      Group &group = groups[type];
+      if (group.keys.empty())
+        continue;
+      findIds(static_cast<CacheType>(type), group.keys, ids);
+      for (size_t i = 0; i < group.keys.size(); ++i) {
+        if (!ids[i]) {
+          LOG_WARNING << "Failed to resolve dependency for key: "
+                      << group.keys[i] << std::endl;
+          ++unresolved;
+          continue;
+        }
+        ++resolved;
+        if (stride == 0) {
+          // 整行只含被回填的列, 解析后才写入
+          Model row{};
+          row.*group.columns[i] = *ids[i];
+          STG.insertClassObj(row);
+          continue;
+        }
+        auto it = std::find_if(
+            updates.begin(), updates.end(),
+            [&](const auto &update) { return update.first == group.columns[i]; });
+        if (it == updates.end())
+          it = updates.emplace(updates.end(), group.columns[i],
+                               std::vector<int64_t>{});
+        it->second.push_back(*ids[i]);
+        it->second.insert(it->second.end(),
+                          group.rowKeys.begin() + i * stride,
+                          group.rowKeys.begin() + (i + 1) * stride);
+      }
+      group = Group{};
+    }
+    for (const auto &[column, values] : updates)
+      STG.updateColumn(column, keyColumns, values);
+    return {resolved, unresolved};
+  }
+};
+
+template <typename Model> size_t DependencyManager::slotOf() {
+  static const size_t slot = nextSlot();
+  return slot;
+}
+
+template <typename Model>
+void DependencyManager::addDependency(const KeyType &dependencyKey,
+                                      CacheType keyType, const Model &row,
+                                      int64_t Model::*column) {
+  if (disabled_[static_cast<size_t>(keyType)])
+    return;
+  const size_t slot = slotOf<Model>();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (slot >= stores_.size())
+    stores_.resize(slot + 1);
+  if (!stores_[slot])
+    stores_[slot] = std::make_unique<FixupStore<Model>>();
+
+  auto &group = static_cast<FixupStore<Model> &>(*stores_[slot])
+                    .groups[static_cast<size_t>(keyType)];
+  group.keys.push_back(dependencyKey);
+  group.columns.push_back(column);
+  for (int64_t Model::*key : FixupRow<Model>::keys)
+    group.rowKeys.push_back(row.*key);
+}
+
 #endif // _DB_DEPENDENCY_MANAGER_H_
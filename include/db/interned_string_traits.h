@@ -0,0 +1,30 @@
+#ifndef _DB_INTERNED_STRING_TRAITS_H_
+#define _DB_INTERNED_STRING_TRAITS_H_
+
+#include "../third_party/sqlite_orm.h"
+#include "util/string_pool.h"
+#include <string>
+
+// InternedString 列按 TEXT 存储, 绑定时直接使用驻留池中的内容
+namespace sqlite_orm {
+
+template <> struct type_printer<InternedString, void> : text_printer {};
+
+template <> struct statement_binder<InternedString, void> {
+  int bind(sqlite3_stmt *stmt, int index, const InternedString &value) const {
+    std::string_view text = value.view();
+    // 驻留内容在写入完成前一直有效, 无需让 SQLite 复制
+    return sqlite3_bind_text(stmt, index, text.data(),
+                             static_cast<int>(text.size()), SQLITE_STATIC);
+  }
+};
+
+template <> struct field_printer<InternedString, void> {
+  std::string operator()(const InternedString &value) const {
+    return std::string(value.view());
+  }
+};
+
+} // namespace sqlite_orm
+
+#endif // _DB_INTERNED_STRING_TRAITS_H_
@@ -2,11 +2,19 @@
 #define _STORAGE_H_
 
 #include "../third_party/sqlite_orm.h"
+#include "db/cache_repository.h"
 #include "model/config/configuration.h"
 #include "table_init.h"
 #include "util/logger/macros.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace sqlite_orm;
 
@@ -24,8 +32,21 @@ public:
     if (!config.path.empty())
       _sqliteDbPath = config.path;
 
-    // 检查并清空现有数据库文件
-    if (std::filesystem::exists(_sqliteDbPath)) {
+    // 内存上限需先于容量提示设置, 受限时不按上次的规模预留
+    if (config.cache_memory_mb > 0)
+      CacheSpill::instance().setMemoryLimit(
+          static_cast<size_t>(config.cache_memory_mb) << 20);
+
+    // 旧库即将被删除或沿用, 先取出上次运行的缓存规模作为容量提示
+    if (std::filesystem::exists(_sqliteDbPath))
+      CacheManager::instance().setReserveHints(readCacheSizes(_sqliteDbPath));
+
+    // 增量模式沿用已有数据库, 否则检查并清空现有数据库文件
+    _reused = config.incremental && std::filesystem::exists(_sqliteDbPath);
+    if (_reused) {
+      LOG_INFO << "Reuse existing database for incremental extraction: "
+               << _sqliteDbPath << std::endl;
+    } else if (std::filesystem::exists(_sqliteDbPath)) {
       LOG_WARNING << "Database file already existed, try to remove..."
                   << std::endl;
       try {
@@ -36,7 +57,8 @@ public:
       }
       LOG_INFO << "Remove old database file" << std::endl;
     }
-    LOG_INFO << "Create new database file: " << _sqliteDbPath << std::endl;
+    if (!_reused)
+      LOG_INFO << "Create new database file: " << _sqliteDbPath << std::endl;
 
     // 确保目录存在
     std::filesystem::path dbPath(_sqliteDbPath);
@@ -46,13 +68,174 @@ public:
 
     _storage =
         std::make_unique<Storage::StorageType>(initStorage(_sqliteDbPath));
+    // PRAGMA 作用于单个连接, 因此在每次打开连接时应用并保持连接常开
+    _storage->on_open = [this, config](sqlite3 *db) {
+      _db = db;
+      applyPragmas(db, config);
+    };
+    _storage->open_forever();
     _storage->sync_schema();
-    _storage->pragma.synchronous(0); // PRAGMA synchronous = OFF
-    _storage->pragma.journal_mode(
-        journal_mode::MEMORY); // PRAGMA journal_mode = MEMORY
+    // 重建堆表会丢弃已有数据, 沿用的数据库保持原有约束;
+    // 重建还会重排 rowid, 增量模式按 rowid 区间记录各TU的行, 因此不延迟
+    if (config.defer_indexes && !config.incremental)
+      deferConstraints();
+    else if (config.defer_indexes)
+      LOG_INFO << "defer_indexes is ignored in incremental mode" << std::endl;
     _initialized = true;
   }
 
+  // 将抽取期间的堆表重建为带主键/唯一约束的正式表, 未开启延迟建索引时为空操作
+  inline void buildDeferredConstraints() {
+    if (_deferredTables.empty())
+      return;
+    LOG_INFO << "Building primary keys for " << _deferredTables.size()
+             << " deferred tables..." << std::endl;
+
+    execSql(_db, "BEGIN");
+    try {
+      for (const auto &table : _deferredTables) {
+        std::string heap = table.name + "__heap";
+        std::string columns = joinQuoted(table.columns);
+        // 按主键与插入顺序写回, 重复主键保留最后一次写入, 与 REPLACE 语义一致
+        std::string order;
+        for (const auto &key : table.primaryKey)
+          order += quote(key) + ", ";
+        order += "rowid";
+
+        execSql(_db, "ALTER TABLE " + quote(table.name) + " RENAME TO " +
+                         quote(heap));
+        execSql(_db, table.createSql);
+        execSql(_db, "INSERT OR REPLACE INTO " + quote(table.name) + " (" +
+                         columns + ") SELECT " + columns + " FROM " +
+                         quote(heap) + " ORDER BY " + order);
+        execSql(_db, "DROP TABLE " + quote(heap));
+      }
+      execSql(_db, "COMMIT");
+    } catch (...) {
+      sqlite3_exec(_db, "ROLLBACK", nullptr, nullptr, nullptr);
+      throw;
+    }
+    _deferredTables.clear();
+    LOG_INFO << "Deferred primary keys built" << std::endl;
+  }
+
+  // 本次运行是否沿用了已有的数据库
+  inline bool isReused() const { return _reused; }
+
+  // 各表当前最大的 rowid, 空表为 0
+  inline std::unordered_map<std::string, int64_t> lastRowids() {
+    std::unordered_map<std::string, int64_t> rowids;
+    for (const auto &name : _storage->table_names()) {
+      std::string sql = "SELECT max(rowid) FROM " + quote(name);
+      sqlite3_stmt *stmt = nullptr;
+      if (sqlite3_prepare_v2(_db, sql.c_str(), -1, &stmt, nullptr) !=
+          SQLITE_OK)
+        throw std::runtime_error("Failed to prepare \"" + sql +
+                                 "\": " + sqlite3_errmsg(_db));
+      rowids[name] =
+          sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int64(stmt, 0) : 0;
+      sqlite3_finalize(stmt);
+    }
+    return rowids;
+  }
+
+  // 删除各表中 rowid 落在对应区间 [first, last] 内的记录, 返回删除的行数
+  inline size_t
+  deleteRowRanges(const std::vector<DbModel::TuRowRange> &ranges) {
+    if (ranges.empty())
+      return 0;
+
+    size_t deleted = 0;
+    execSql(_db, "BEGIN");
+    try {
+      for (const auto &range : ranges) {
+        std::string sql = "DELETE FROM " + quote(range.table_name) +
+                          " WHERE rowid BETWEEN ? AND ?";
+        sqlite3_stmt *stmt = nullptr;
+        if (sqlite3_prepare_v2(_db, sql.c_str(), -1, &stmt, nullptr) !=
+            SQLITE_OK)
+          throw std::runtime_error("Failed to prepare \"" + sql +
+                                   "\": " + sqlite3_errmsg(_db));
+        sqlite3_bind_int64(stmt, 1, range.first);
+        sqlite3_bind_int64(stmt, 2, range.last);
+        int rc = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        if (rc != SQLITE_DONE)
+          throw std::runtime_error("Failed to execute \"" + sql +
+                                   "\": " + sqlite3_errmsg(_db));
+        deleted += sqlite3_changes(_db);
+      }
+      execSql(_db, "COMMIT");
+    } catch (...) {
+      sqlite3_exec(_db, "ROLLBACK", nullptr, nullptr, nullptr);
+      throw;
+    }
+    return deleted;
+  }
+
+  // 按行标识回填一列: values 每组依次为新值和 keyColumns 的取值, 返回更新的行数.
+  // 行标识不是主键前缀时(含延迟建主键的堆表)先为其建临时索引, 避免逐行全表扫描;
+  // 临时索引在 dropFixupIndexes 中删除, 不进入输出的数据库
+  inline size_t updateColumn(const std::string &table, const std::string &column,
+                             const std::vector<std::string> &keyColumns,
+                             const std::vector<int64_t> &values) {
+    const size_t stride = keyColumns.size() + 1;
+    if (values.empty() || values.size() % stride != 0)
+      return 0;
+
+    std::vector<std::string> primaryKey = primaryKeyColumns(table);
+    const std::string index = table + "__fixup";
+    if ((primaryKey.size() < keyColumns.size() ||
+         !std::equal(keyColumns.begin(), keyColumns.end(),
+                     primaryKey.begin())) &&
+        std::find(_fixupIndexes.begin(), _fixupIndexes.end(), index) ==
+            _fixupIndexes.end()) {
+      execSql(_db, "CREATE INDEX IF NOT EXISTS " + quote(index) + " ON " +
+                       quote(table) + " (" + joinQuoted(keyColumns) + ")");
+      _fixupIndexes.push_back(index);
+    }
+
+    std::string sql =
+        "UPDATE " + quote(table) + " SET " + quote(column) + " = ? WHERE ";
+    for (size_t i = 0; i < keyColumns.size(); ++i)
+      sql += (i ? " AND " : "") + quote(keyColumns[i]) + " = ?";
+
+    size_t updated = 0;
+    execSql(_db, "BEGIN");
+    sqlite3_stmt *stmt = nullptr;
+    try {
+      if (sqlite3_prepare_v2(_db, sql.c_str(), -1, &stmt, nullptr) !=
+          SQLITE_OK)
+        throw std::runtime_error("Failed to prepare \"" + sql +
+                                 "\": " + sqlite3_errmsg(_db));
+      for (size_t row = 0; row < values.size(); row += stride) {
+        for (size_t i = 0; i < stride; ++i)
+          sqlite3_bind_int64(stmt, static_cast<int>(i + 1), values[row + i]);
+        int rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        if (rc != SQLITE_DONE)
+          throw std::runtime_error("Failed to execute \"" + sql +
+                                   "\": " + sqlite3_errmsg(_db));
+        updated += sqlite3_changes(_db);
+      }
+      sqlite3_finalize(stmt);
+      stmt = nullptr;
+      execSql(_db, "COMMIT");
+    } catch (...) {
+      sqlite3_finalize(stmt);
+      sqlite3_exec(_db, "ROLLBACK", nullptr, nullptr, nullptr);
+      throw;
+    }
+    return updated;
+  }
+
+  // 删除回填时建立的临时索引, 在抽取结束、重建延迟约束之前调用
+  inline void dropFixupIndexes() {
+    for (const auto &index : _fixupIndexes)
+      execSql(_db, "DROP INDEX IF EXISTS " + quote(index));
+    _fixupIndexes.clear();
+  }
+
   // Check if all the models are completely mapped
   inline bool isInitialised() const { return _initialized.load(); }
 
@@ -68,9 +251,205 @@ public:
 private:
   Storage() = default;
 
+  static std::string toUpper(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return std::toupper(c); });
+    return value;
+  }
+
+  static void execPragma(sqlite3 *db, const std::string &pragma) {
+    char *errmsg = nullptr;
+    if (sqlite3_exec(db, ("PRAGMA " + pragma).c_str(), nullptr, nullptr,
+                     &errmsg) != SQLITE_OK) {
+      LOG_WARNING << "Failed to apply PRAGMA " << pragma << ": "
+                  << (errmsg ? errmsg : "unknown error") << std::endl;
+      sqlite3_free(errmsg);
+    }
+  }
+
+  static void applyPragmas(sqlite3 *db, const DatabaseConfig &config) {
+    static const std::vector<std::string> journalModes = {
+        "DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"};
+    static const std::vector<std::string> syncModes = {"OFF", "NORMAL", "FULL",
+                                                       "EXTRA"};
+
+    bool bulkLoad = config.profile == "bulk_load";
+    if (bulkLoad) {
+      // page_size 需在建表前设置才对新库生效
+      execPragma(db, "page_size = 65536");
+      execPragma(db, "locking_mode = EXCLUSIVE");
+      execPragma(db, "temp_store = MEMORY");
+      execPragma(db, "mmap_size = 1073741824");
+    } else if (config.profile != "default" && !config.profile.empty()) {
+      LOG_WARNING << "Unknown database profile: " << config.profile
+                  << ", fallback to default" << std::endl;
+    }
+
+    // 负值表示以 KiB 为单位
+    if (config.cache_size_mb > 0)
+      execPragma(db, "cache_size = -" +
+                         std::to_string(config.cache_size_mb * 1024));
+
+    std::string journal = toUpper(config.journal_mode);
+    if (std::find(journalModes.begin(), journalModes.end(), journal) ==
+        journalModes.end()) {
+      LOG_WARNING << "Unknown journal_mode: " << config.journal_mode
+                  << ", fallback to MEMORY" << std::endl;
+      journal = "MEMORY";
+    }
+    execPragma(db, "journal_mode = " + journal);
+
+    std::string sync = toUpper(config.synchronous);
+    if (std::find(syncModes.begin(), syncModes.end(), sync) ==
+        syncModes.end()) {
+      LOG_WARNING << "Unknown synchronous mode: " << config.synchronous
+                  << ", fallback to OFF" << std::endl;
+      sync = "OFF";
+    }
+    execPragma(db, "synchronous = " + sync);
+  }
+
+  // 延迟建立约束的表: 保存原始建表语句, 结束时据此重建
+  struct DeferredTable {
+    std::string name;
+    std::string createSql;
+    std::vector<std::string> columns;
+    std::vector<std::string> primaryKey;
+  };
+
   std::string _sqliteDbPath;
   std::atomic<bool> _initialized{false};
+  bool _reused = false;
   std::shared_ptr<StorageType> _storage;
+  sqlite3 *_db = nullptr;
+  std::vector<DeferredTable> _deferredTables;
+  std::vector<std::string> _fixupIndexes;
+
+  static std::string quote(const std::string &identifier) {
+    return "\"" + identifier + "\"";
+  }
+
+  static std::string joinQuoted(const std::vector<std::string> &names) {
+    std::string result;
+    for (const auto &name : names) {
+      if (!result.empty())
+        result += ", ";
+      result += quote(name);
+    }
+    return result;
+  }
+
+  static void execSql(sqlite3 *db, const std::string &sql) {
+    char *errmsg = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errmsg) != SQLITE_OK) {
+      std::string message = errmsg ? errmsg : "unknown error";
+      sqlite3_free(errmsg);
+      throw std::runtime_error("Failed to execute \"" + sql + "\": " + message);
+    }
+  }
+
+  // 读取旧库中的 cache_sizes 表, 旧库不含该表或无法打开时返回空
+  static std::unordered_map<std::string, size_t>
+  readCacheSizes(const std::string &path) {
+    std::unordered_map<std::string, size_t> sizes;
+    sqlite3 *db = nullptr;
+    if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) !=
+        SQLITE_OK) {
+      sqlite3_close(db);
+      return sizes;
+    }
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT name, size FROM cache_sizes", -1,
+                           &stmt, nullptr) == SQLITE_OK) {
+      while (sqlite3_step(stmt) == SQLITE_ROW) {
+        int size = sqlite3_column_int(stmt, 1);
+        if (size > 0)
+          sizes.emplace(
+              reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0)),
+              static_cast<size_t>(size));
+      }
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+    if (!sizes.empty())
+      LOG_INFO << "Reserve caches by sizes of the previous run ("
+               << sizes.size() << " repositories)" << std::endl;
+    return sizes;
+  }
+
+  // 按主键中的顺序返回表的主键列, 无主键的表(含堆表)返回空
+  std::vector<std::string> primaryKeyColumns(const std::string &table) {
+    sqlite3_stmt *stmt = nullptr;
+    std::string tableInfo = "PRAGMA table_info(" + quote(table) + ")";
+    if (sqlite3_prepare_v2(_db, tableInfo.c_str(), -1, &stmt, nullptr) !=
+        SQLITE_OK)
+      throw std::runtime_error("Failed to read schema of table " + table);
+    std::vector<std::pair<int, std::string>> keys;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      int pk = sqlite3_column_int(stmt, 5);
+      if (pk > 0)
+        keys.emplace_back(
+            pk, reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1)));
+    }
+    sqlite3_finalize(stmt);
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::string> columns;
+    for (auto &key : keys)
+      columns.push_back(std::move(key.second));
+    return columns;
+  }
+
+  // 用 sync_schema 建好的表定义替换为同列的无约束堆表
+  void deferConstraints() {
+    for (const auto &name : _storage->table_names()) {
+      DeferredTable table{name, "", {}, {}};
+      std::vector<std::pair<int, std::string>> keys;
+
+      sqlite3_stmt *stmt = nullptr;
+      std::string plainColumns;
+      std::string tableInfo = "PRAGMA table_info(" + quote(name) + ")";
+      if (sqlite3_prepare_v2(_db, tableInfo.c_str(), -1, &stmt, nullptr) !=
+          SQLITE_OK)
+        throw std::runtime_error("Failed to read schema of table " + name);
+      while (sqlite3_step(stmt) == SQLITE_ROW) {
+        std::string column =
+            reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+        auto type = sqlite3_column_text(stmt, 2);
+        int pk = sqlite3_column_int(stmt, 5);
+        table.columns.push_back(column);
+        if (pk > 0)
+          keys.emplace_back(pk, column);
+        if (!plainColumns.empty())
+          plainColumns += ", ";
+        plainColumns += quote(column);
+        if (type)
+          plainColumns += " " + std::string(reinterpret_cast<const char *>(
+                                    type));
+      }
+      sqlite3_finalize(stmt);
+
+      if (sqlite3_prepare_v2(_db,
+                             "SELECT sql FROM sqlite_master "
+                             "WHERE type = 'table' AND name = ?",
+                             -1, &stmt, nullptr) != SQLITE_OK)
+        throw std::runtime_error("Failed to read schema of table " + name);
+      sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+      if (sqlite3_step(stmt) == SQLITE_ROW)
+        table.createSql =
+            reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
+      sqlite3_finalize(stmt);
+
+      std::sort(keys.begin(), keys.end());
+      for (auto &key : keys)
+        table.primaryKey.push_back(std::move(key.second));
+
+      execSql(_db, "DROP TABLE " + quote(name));
+      execSql(_db, "CREATE TABLE " + quote(name) + " (" + plainColumns + ")");
+      _deferredTables.push_back(std::move(table));
+    }
+    LOG_INFO << "Deferred primary keys of " << _deferredTables.size()
+             << " tables until extraction finishes" << std::endl;
+  }
 };
 
 #endif // _STORAGE_H_
@@ -2,8 +2,12 @@
 #define _STORAGE_FACADE_H_
 
 #include "model/config/configuration.h"
+#include "util/thread_safe_queue.h"
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #define STG StorageFacade::getInstance()
 
@@ -16,16 +20,69 @@ public:
 
   void initOrm(const DatabaseConfig config);
 
+  // 记录先进入调用线程的缓冲, 攒满 batch_size 条后在事务中批量写入
   template <typename T> void insertClassObj(T &&obj);
 
   void transaction(const std::function<bool()> &f);
 
+  // 回填已写入记录的一列: values 每组依次为新值和 keyColumns 的取值,
+  // 先提交调用线程的缓冲, 再在一个事务中逐组执行预编译的 UPDATE
+  template <typename T>
+  void updateColumn(int64_t T::*column,
+                    const std::vector<int64_t T::*> &keyColumns,
+                    const std::vector<int64_t> &values);
+
+  // 并行解析时由唯一的写线程落库, 前端线程只在本线程缓冲中攒批
+  void startWriter();
+  // 提交调用线程的剩余缓冲, 等待写线程写完全部批次后退出
+  void stopWriter();
+  // 提交调用线程的缓冲: 写线程运行时交给写线程, 否则直接写入数据库
+  void flushThreadBatch();
+  // 抽取结束: 写入剩余缓冲, 删除回填用的临时索引并建立延迟的主键与约束
+  void finalizeSchema();
+
   ~StorageFacade() = default;
   StorageFacade(const StorageFacade &) = delete;
   StorageFacade &operator=(const StorageFacade &) = delete;
 
 private:
   StorageFacade() = default;
+
+  // 单个模型类型的行缓冲, 具体实现位于 storage_facade.cc
+  struct RowBufferBase {
+    virtual ~RowBufferBase() = default;
+    virtual void write() = 0;
+    virtual void clear() = 0;
+  };
+  template <typename T> struct RowBuffer;
+
+  // 每个模型类型缓存的预编译语句, 只由执行写入的线程访问
+  struct StatementCacheBase {
+    virtual ~StatementCacheBase() = default;
+  };
+  template <typename T> struct StatementCache;
+
+  // 一批待写入的记录, 按模型类型分桶, 下标为类型槽位
+  struct RowBatch {
+    std::vector<std::unique_ptr<RowBufferBase>> buffers;
+    size_t rows = 0;
+  };
+
+  static constexpr size_t kDefaultBatchSize = 5000;
+
+  static thread_local RowBatch thread_batch_;
+  size_t batch_size_ = kDefaultBatchSize;
+  ThreadSafeQueue<RowBatch> writer_queue_;
+  std::thread writer_thread_;
+  std::atomic<bool> writer_running_{false};
+  std::vector<std::unique_ptr<StatementCacheBase>> statements_;
+
+  static size_t nextSlot();
+  template <typename T> static size_t slotOf();
+  template <typename T> StatementCache<T> &statementCache();
+
+  void writerLoop();
+  void writeBatch(RowBatch &batch);
 };
 
-#endif // _STORAGE_FACADE_H_
\ No newline at end of file
+#endif // _STORAGE_FACADE_H_
@@ -40,6 +40,18 @@ inline auto compilatio_time() {
       make_column("seconds", &DbModel::CompilationTime::seconds));
 }
 
+inline auto compilation_metrics() {
+  return make_table(
+      "compilation_metrics",
+      make_column("id", &DbModel::CompilationMetric::id),
+      make_column("processor", &DbModel::CompilationMetric::processor),
+      make_column("nodes", &DbModel::CompilationMetric::nodes),
+      make_column("rows", &DbModel::CompilationMetric::rows),
+      make_column("cache_hits", &DbModel::CompilationMetric::cache_hits),
+      make_column("cache_misses", &DbModel::CompilationMetric::cache_misses),
+      make_column("seconds", &DbModel::CompilationMetric::seconds));
+}
+
 inline auto compilation_finished() {
   return make_table(
       "compilation_finished",
@@ -2,6 +2,7 @@
 #define _TABLE_DEFS_FUNCTION_H_
 
 #include "../third_party/sqlite_orm.h"
+#include "db/interned_string_traits.h"
 #include "model/db/function.h"
 
 using namespace sqlite_orm;
@@ -43,37 +44,37 @@ inline auto function_return_type() {
 inline auto pure_functions() {
   return make_table(
       "purefunctions",
-      make_column("id", &DbModel::PureFuncs::id));
+      make_column("id", &DbModel::PureFuncs::id, primary_key()));
 }
 
 inline auto function_deleted() {
   return make_table(
       "function_deleted",
-      make_column("id", &DbModel::FuncDeleted::id));
+      make_column("id", &DbModel::FuncDeleted::id, primary_key()));
 }
 
 inline auto function_defaulted() {
   return make_table(
       "function_defaulted",
-      make_column("id", &DbModel::FuncDefaulted::id));
+      make_column("id", &DbModel::FuncDefaulted::id, primary_key()));
 }
 
 inline auto function_prototyped() {
   return make_table(
       "function_prototyped",
-      make_column("id", &DbModel::FuncPrototyped::id));
+      make_column("id", &DbModel::FuncPrototyped::id, primary_key()));
 }
 
 inline auto fun_specialized() {
   return make_table(
       "fun_specialized",
-      make_column("id", &DbModel::FunSpecialized::id));
+      make_column("id", &DbModel::FunSpecialized::id, primary_key()));
 }
 
 inline auto fun_implicit() {
   return make_table(
       "fun_implicit",
-      make_column("id", &DbModel::FunImplicit::id));
+      make_column("id", &DbModel::FunImplicit::id, primary_key()));
 }
 
 inline auto is_function_template() {
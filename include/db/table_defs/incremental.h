@@ -0,0 +1,56 @@
+#ifndef _TABLE_DEFS_INCREMENTAL_H_
+#define _TABLE_DEFS_INCREMENTAL_H_
+
+#include "../third_party/sqlite_orm.h"
+#include "model/db/incremental.h"
+
+using namespace sqlite_orm;
+
+namespace IncrementalTableFn {
+
+// clang-format off
+inline auto file_hashes() {
+  return make_table(
+      "file_hashes",
+      make_column("file", &DbModel::FileHash::file, primary_key()),
+      make_column("path", &DbModel::FileHash::path),
+      make_column("hash", &DbModel::FileHash::hash));
+}
+
+inline auto tu_files() {
+  return make_table(
+      "tu_files",
+      make_column("tu", &DbModel::TuFile::tu),
+      make_column("file", &DbModel::TuFile::file),
+      primary_key(&DbModel::TuFile::tu, &DbModel::TuFile::file));
+}
+
+inline auto tu_row_ranges() {
+  return make_table(
+      "tu_row_ranges",
+      make_column("tu", &DbModel::TuRowRange::tu),
+      make_column("table_name", &DbModel::TuRowRange::table_name),
+      make_column("first", &DbModel::TuRowRange::first),
+      make_column("last", &DbModel::TuRowRange::last),
+      primary_key(&DbModel::TuRowRange::tu,
+                  &DbModel::TuRowRange::table_name));
+}
+
+inline auto incremental_state() {
+  return make_table(
+      "incremental_state",
+      make_column("name", &DbModel::IncrementalState::name, primary_key()),
+      make_column("value", &DbModel::IncrementalState::value));
+}
+
+inline auto cache_sizes() {
+  return make_table(
+      "cache_sizes",
+      make_column("name", &DbModel::CacheSize::name, primary_key()),
+      make_column("size", &DbModel::CacheSize::size));
+}
+// clang-format on
+
+} // namespace IncrementalTableFn
+
+#endif // _TABLE_DEFS_INCREMENTAL_H_
@@ -2,6 +2,7 @@
 #define _TABLE_DEFS_PREPROCESSOR_H_
 
 #include "../third_party/sqlite_orm.h"
+#include "db/interned_string_traits.h"
 #include "model/db/preprocessor.h"
 
 using namespace sqlite_orm;
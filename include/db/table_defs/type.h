@@ -2,6 +2,7 @@
 #define _TABLE_DEFS_TYPE_H_
 
 #include "../third_party/sqlite_orm.h"
+#include "db/interned_string_traits.h"
 #include "model/db/type.h"
 #include "model/db/location.h"
 
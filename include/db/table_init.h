@@ -10,6 +10,7 @@
 #include "table_defs/element.h"
 #include "table_defs/expr.h"
 #include "table_defs/function.h"
+#include "table_defs/incremental.h"
 #include "table_defs/lambda.h"
 #include "table_defs/location.h"
 #include "table_defs/preprocessor.h"
@@ -29,6 +30,7 @@ inline auto initStorage(const std::string &path) {
       CompTableFn::compilatio_args(),
       CompTableFn::compilatio_build_mode(),
       CompTableFn::compilatio_time(),
+      CompTableFn::compilation_metrics(),
       CompTableFn::compilation_finished(),
       // Location Tables
       LocTableFn::locations(),
@@ -184,7 +186,13 @@ inline auto initStorage(const std::string &path) {
       PreprocessorTableFn::macroparent(),
       PreprocessorTableFn::macrolocationbind(),
       PreprocessorTableFn::macro_argument_unexpanded(),
-      PreprocessorTableFn::macro_argument_expanded()
+      PreprocessorTableFn::macro_argument_expanded(),
+      // Incremental Bookkeeping Tables
+      IncrementalTableFn::file_hashes(),
+      IncrementalTableFn::tu_files(),
+      IncrementalTableFn::tu_row_ranges(),
+      IncrementalTableFn::incremental_state(),
+      IncrementalTableFn::cache_sizes()
     );
   // clang-format on
 }
@@ -7,13 +7,18 @@ struct CLArgs {
   std::string config_path;
   std::string source_path;
   std::string output_path;
+  std::string compile_commands_path;
+  int jobs{-1}; // -1 表示沿用配置文件
   bool quiet{false};
   bool show_help{false};
   bool show_version{false};
   std::string working_directory;
 
   bool isValid() const {
-    return !config_path.empty() && !source_path.empty() && !output_path.empty();
+    // 使用编译数据库时 source_path 仅作为过滤条件, 可以省略
+    return !config_path.empty() &&
+           (!source_path.empty() || !compile_commands_path.empty()) &&
+           !output_path.empty();
   }
 };
 
@@ -18,6 +18,24 @@ struct CompilationConfig {
   std::string cxx_standard;
   std::vector<std::string> flags;
   std::string working_directory;
+  // compile_commands.json 路径(文件或其所在目录), 非空时由编译数据库驱动多TU抽取
+  std::string compile_commands;
+  // 编译数据库条目的路径过滤(glob), 为空则处理全部条目
+  std::vector<std::string> source_filters;
+  // 并行解析TU的工作线程数, 0 表示使用全部硬件线程
+  unsigned jobs = 1;
+  // 已被其他TU抽取过的头文件(路径+内容+预定义宏+引用的宏定义相同)中的声明不再重复遍历
+  bool dedup_headers = true;
+  // 关注的文件路径(glob), 范围外文件中的函数体不解析; 为空则全部关注
+  std::vector<std::string> focus_paths;
+  // 跳过位于系统头文件中的声明
+  bool skip_system_headers = false;
+  // 自动预编译的前缀头文件, 工作目录与编译参数相同的TU共用同一个PCH
+  std::vector<std::string> prefix_headers;
+  // 自动生成的PCH存放目录, 为空时使用系统临时目录
+  std::string pch_dir;
+  // 使用 -fmodules 的TU共享的隐式模块缓存目录, 编译命令中已指定时以其为准
+  std::string module_cache_path;
 };
 
 // 数据库相关配置
@@ -27,6 +45,37 @@ struct DatabaseConfig {
   int cache_size_mb;
   std::string journal_mode;
   std::string synchronous;
+  // 写入调优方案: "default" 或 "bulk_load"(独占锁, 内存临时表, 大页与 mmap)
+  std::string profile = "default";
+  // 抽取期间使用无主键的堆表, 结束时一次性建立主键与约束(bulk_load 默认开启)
+  bool defer_indexes = false;
+  // 增量抽取: 沿用已有数据库, 只重新抽取读取过的文件内容发生变化的TU
+  bool incremental = false;
+  // 缓存仓库(Key到ID的映射)占用内存的上限(MB), 超出后冷数据溢出到临时库; 0 表示不限制
+  int cache_memory_mb = 0;
+};
+
+// 可选抽取的表族, 函数、变量、类型及其说明符构成声明图的主干, 始终抽取
+enum class ExtractionFamily : unsigned {
+  Namespaces,   // namespaces, namespacembrs, usings 等
+  Templates,    // 模板参数、实例化与 concept 相关表
+  Inheritance,  // derivations 与类布局
+  Stmts,        // stmts 及 locations_stmt
+  Exprs,        // exprs 及 locations_expr
+  Lambdas,      // lambdas, lambda_capture
+  Preprocessor, // 预处理指令与宏调用
+  Count
+};
+
+// 抽取范围相关配置
+struct ExtractionConfig {
+  // 按 ExtractionFamily 的位掩码, 默认抽取全部表族
+  unsigned families =
+      (1u << static_cast<unsigned>(ExtractionFamily::Count)) - 1;
+
+  bool has(ExtractionFamily family) const {
+    return (families >> static_cast<unsigned>(family)) & 1u;
+  }
 };
 
 // 日志相关配置
@@ -36,6 +85,10 @@ struct LoggerConfig {
   bool is_to_console;
   int batch_size;
   bool enable_perf_logging;
+  // 性能事件(二进制)的输出文件, 由 scripts/perf_summary.py 汇总
+  std::string perf_file = "perf.bin";
+  // 是否把各处理器的计数写入 compilation_metrics 表
+  bool record_metrics = false;
 };
 
 // 完整的配置信息
@@ -43,6 +96,7 @@ struct Configuration {
   GeneralConfig general;
   CompilationConfig compilation;
   DatabaseConfig database;
+  ExtractionConfig extraction;
   LoggerConfig logger;
 };
 
@@ -1,6 +1,7 @@
 #ifndef _MODEL_CLASS_H_
 #define _MODEL_CLASS_H_
 
+#include <cstdint>
 #include <string>
 
 enum class MemberType {
@@ -13,9 +14,9 @@ enum class MemberType {
 namespace DbModel {
 
 struct Member {
-  int id;
-  int associated_id;
-  int type;
+  int64_t id;
+  int64_t associated_id;
+  int64_t type;
 };
 
 } // namespace DbModel
@@ -1,6 +1,7 @@
 #ifndef _MODEL_COMPILATION_H_
 #define _MODEL_COMPILATION_H_
 
+#include <cstdint>
 #include <string>
 
 enum class CompTimeKind {
@@ -13,30 +14,42 @@ enum class CompTimeKind {
 namespace DbModel {
 
 struct Compilation {
-  int id;
+  int64_t id;
   std::string cwd;
 };
 
 struct CompilationArg {
-  int id;
-  int num;
+  int64_t id;
+  int64_t num;
   std::string arg;
 };
 
 struct CompilationBuildMode {
-  int id;
-  int mode;
+  int64_t id;
+  int64_t mode;
 };
 
 struct CompilationTime {
-  int id;
-  int num;
-  int kind;
+  int64_t id;
+  int64_t num;
+  int64_t kind;
+  double seconds;
+};
+
+// 各处理器在本次编译中的累计计数, seconds 不含其调用的其他处理器的耗时,
+// 未开启性能日志时为 0
+struct CompilationMetric {
+  int64_t id;
+  std::string processor;
+  int64_t nodes;
+  int64_t rows;
+  int64_t cache_hits;
+  int64_t cache_misses;
   double seconds;
 };
 
 struct CompilationFinished {
-  int id;
+  int64_t id;
   double cpu_seconds;
   double elapsed_seconds;
 };
@@ -1,36 +1,39 @@
 #ifndef _MODEL_CONCEPT_H_
 #define _MODEL_CONCEPT_H_
 
+#include "util/fingerprint.h"
+#include "util/string_pool.h"
+#include <cstdint>
 #include <string>
 
 namespace DbModel {
 
 struct ConceptTemplate {
-  int id;
-  std::string name;
-  int location;
-  using KeyType = std::string;
+  int64_t id;
+  InternedString name;
+  int64_t location;
+  using KeyType = Fingerprint;
 };
 
 struct ConceptInstantiation {
-  int to;
-  int from;
+  int64_t to;
+  int64_t from;
 };
 
 struct ConceptTemplateArgument {
-  int concept_id;
-  int index;
-  int arg_type;
+  int64_t concept_id;
+  int64_t index;
+  int64_t arg_type;
 };
 
 struct IsTypeConstraint {
-  int concept_id;
+  int64_t concept_id;
 };
 
 struct ConceptTemplateArgumentValue {
-  int concept_id;
-  int index;
-  int arg_value;
+  int64_t concept_id;
+  int64_t index;
+  int64_t arg_value;
 };
 
 } // namespace DbModel
@@ -1,6 +1,7 @@
 #ifndef _MODEL_CONTAINER_H_
 #define _MODEL_CONTAINER_H_
 
+#include <cstdint>
 #include <string>
 
 enum class ContainerType { File = 0, Folder = 1 };
@@ -8,33 +9,33 @@ enum class ContainerType { File = 0, Folder = 1 };
 namespace DbModel {
 
 struct Container {
-  int id;
-  int associated_id;
-  int type;
+  int64_t id;
+  int64_t associated_id;
+  int64_t type;
 };
 
 struct File {
-  int id;
+  int64_t id;
   std::string name;
 };
 
 struct Folder {
-  int id;
+  int64_t id;
   std::string name;
 };
 
 struct Namespace {
-  int id;
+  int64_t id;
   std::string name;
 };
 
 struct NamespaceInline {
-  int id;
+  int64_t id;
 };
 
 struct NamespaceMember {
-  int parentid;
-  int memberid;
+  int64_t parentid;
+  int64_t memberid;
 };
 
 } // namespace DbModel
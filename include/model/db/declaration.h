@@ -1,6 +1,7 @@
 #ifndef _MODEL_DECLRATION_H_
 #define _MODEL_DECLRATION_H_
 
+#include <cstdint>
 #include <string>
 
 enum class DeclType {
@@ -15,35 +16,35 @@ enum class DeclType {
 namespace DbModel {
 
 struct Declaration {
-  int id;
-  int associated_id;
-  int type;
+  int64_t id;
+  int64_t associated_id;
+  int64_t type;
 };
 
 struct FriendDecl {
-  int id;
-  int type_id;
-  int decl_id;
-  int location;
+  int64_t id;
+  int64_t type_id;
+  int64_t decl_id;
+  int64_t location;
 };
 
 struct NamespaceDecl {
-  int id;
-  int namespace_id;
-  int location;
-  int bodylocation;
+  int64_t id;
+  int64_t namespace_id;
+  int64_t location;
+  int64_t bodylocation;
 };
 
 struct Using {
-  int id;
-  int element_id;
-  int location;
-  int kind;
+  int64_t id;
+  int64_t element_id;
+  int64_t location;
+  int64_t kind;
 };
 
 struct UsingContainer {
-  int parent;
-  int child;
+  int64_t parent;
+  int64_t child;
 };
 
 } // namespace DbModel
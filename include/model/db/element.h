@@ -1,6 +1,8 @@
 #ifndef _MODEL_ELEMENT_H_
 #define _MODEL_ELEMENT_H_
 
+#include "util/fingerprint.h"
+#include <cstdint>
 #include <string>
 
 enum class ElementType {
@@ -12,10 +14,10 @@ enum class ElementType {
 namespace DbModel {
 
 struct ParameterizedElement {
-  int id;
-  int associate_id;
-  int type;
-  using KeyType = std::string;
+  int64_t id;
+  int64_t associate_id;
+  int64_t type;
+  using KeyType = Fingerprint;
 };
 
 } // namespace DbModel
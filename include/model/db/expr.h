@@ -1,6 +1,8 @@
 #ifndef _MODEL_EXPR_H_
 #define _MODEL_EXPR_H_
 
+#include "util/fingerprint.h"
+#include <cstdint>
 #include <string>
 
 enum class ExprKind {
@@ -270,67 +272,67 @@ enum class IsCallKind {
 namespace DbModel {
 
 struct Expr {
-  int id;
-  int kind;
-  int location;
-  using KeyType = std::string;
+  int64_t id;
+  int64_t kind;
+  int64_t location;
+  using KeyType = Fingerprint;
 };
 
 struct FunBind {
-  int expr;
-  int fun;
+  int64_t expr;
+  int64_t fun;
 };
 
 struct IsCall {
-  int caller;
-  int kind;
+  int64_t caller;
+  int64_t kind;
 };
 
 struct VarBind {
-  int expr;
-  int var;
+  int64_t expr;
+  int64_t var;
 };
 
 struct Values {
-  int id;
+  int64_t id;
   std::string str;
-  using KeyType = std::string;
+  using KeyType = Fingerprint;
 };
 
 struct ValueText {
-  int id;
+  int64_t id;
   std::string text;
-  using KeyType = std::string;
+  using KeyType = Fingerprint;
 };
 
 struct ValueBind {
-  int val;
-  int expr;
+  int64_t val;
+  int64_t expr;
 };
 
 // 数组元素初始化：链接初始化列表到数组元素
 // aggregate_array_init(aggregate: @aggregateliteral ref, initializer: @expr ref, element_index: int ref, position: int ref)
 struct AggregateArrayInit {
-  int aggregate;      // InitListExpr ID (@aggregateliteral)
-  int initializer;    // 初始化表达式 ID (@expr)
-  int element_index;  // 数组中的索引
-  int position;       // 位置信息
+  int64_t aggregate;      // InitListExpr ID (@aggregateliteral)
+  int64_t initializer;    // 初始化表达式 ID (@expr)
+  int64_t element_index;  // 数组中的索引
+  int64_t position;       // 位置信息
 };
 
 // 结构体/联合体字段初始化：链接初始化列表到字段
 // aggregate_field_init(aggregate: @aggregateliteral ref, initializer: @expr ref, field: @membervariable ref, position: int ref)
 struct AggregateFieldInit {
-  int aggregate;      // InitListExpr ID (@aggregateliteral)
-  int initializer;    // 初始化表达式 ID (@expr)
-  int field;          // 字段 ID (@membervariable ref)
-  int position;       // 位置信息
+  int64_t aggregate;      // InitListExpr ID (@aggregateliteral)
+  int64_t initializer;    // 初始化表达式 ID (@expr)
+  int64_t field;          // 字段 ID (@membervariable ref)
+  int64_t position;       // 位置信息
 };
 
 // sizeof 绑定：链接到类型
 // sizeof_bind(unique int expr: @expr ref, type_id: @type ref)
 struct SizeOfBind {
-  int expr;      // UnaryExprOrTypeTraitExpr ID (unique, 主键)
-  int type_id;   // 类型 ID (@type ref)
+  int64_t expr;      // UnaryExprOrTypeTraitExpr ID (unique, 主键)
+  int64_t type_id;   // 类型 ID (@type ref)
 };
 
 } // namespace DbModel
@@ -1,6 +1,9 @@
 #ifndef _MODEL_FUNCTION_H_
 #define _MODEL_FUNCTION_H_
 
+#include "util/fingerprint.h"
+#include "util/string_pool.h"
+#include <cstdint>
 #include <string>
 
 enum class FuncType {
@@ -17,121 +20,121 @@ enum class FuncType {
 namespace DbModel {
 
 struct Function {
-  int id;
-  std::string name;
-  int kind;
-  using KeyType = std::string;
+  int64_t id;
+  InternedString name;
+  int64_t kind;
+  using KeyType = Fingerprint;
 };
 
 struct FunDecl {
-  int id;
-  int function;
-  int type_id;
-  std::string name;
-  int location;
+  int64_t id;
+  int64_t function;
+  int64_t type_id;
+  InternedString name;
+  int64_t location;
 };
 
 struct FunDef {
-  int id;
+  int64_t id;
 };
 
 struct FuncRetType {
-  int id;
-  int return_type;
+  int64_t id;
+  int64_t return_type;
 };
 
 struct PureFuncs {
-  int id;
+  int64_t id;
 };
 
 struct FuncDeleted {
-  int id;
+  int64_t id;
 };
 
 struct FuncDefaulted {
-  int id;
+  int64_t id;
 };
 
 struct FuncPrototyped {
-  int id;
+  int64_t id;
 };
 
 struct FunSpecialized {
-  int id;
+  int64_t id;
 };
 
 struct FunImplicit {
-  int id;
+  int64_t id;
 };
 
 struct IsFunctionTemplate {
-  int id;
+  int64_t id;
 };
 
 struct FunctionInstantiation {
-  int to;
-  int from;
+  int64_t to;
+  int64_t from;
 };
 
 struct FunctionTemplateArgument {
-  int function_id;
-  int index;
-  int arg_type;
+  int64_t function_id;
+  int64_t index;
+  int64_t arg_type;
 };
 
 struct FunctionTemplateArgumentValue {
-  int function_id;
-  int index;
-  int arg_value;
+  int64_t function_id;
+  int64_t index;
+  int64_t arg_value;
 };
 
 struct FuncEntryPt {
-  int id;
-  int entry_point;
+  int64_t id;
+  int64_t entry_point;
 };
 
 struct DeductionGuideForClass {
-  int id;
-  int class_template;
+  int64_t id;
+  int64_t class_template;
 };
 
 struct FunDeclThrow {
-  int fun_decl;
-  int index;
-  int type_id;
+  int64_t fun_decl;
+  int64_t index;
+  int64_t type_id;
 };
 
 struct FunDeclEmptyThrow {
-  int fun_decl;
+  int64_t fun_decl;
 };
 
 struct FunDeclNoexcept {
-  int fun_decl;
-  int constant;
+  int64_t fun_decl;
+  int64_t constant;
 };
 
 struct FunDeclEmptyNoexcept {
-  int fun_decl;
+  int64_t fun_decl;
 };
 
 struct FunDeclTypedefType {
-  int fun_decl;
-  int tyepdeftype_id;
+  int64_t fun_decl;
+  int64_t tyepdeftype_id;
 };
 
 struct Coroutine {
-  int function;
-  int traits;
+  int64_t function;
+  int64_t traits;
 };
 
 struct CoroutineNew {
-  int function;
-  int new_;
+  int64_t function;
+  int64_t new_;
 };
 
 struct CoroutineDelete {
-  int function;
-  int delete_;
+  int64_t function;
+  int64_t delete_;
 };
 
 } // namespace DbModel
@@ -0,0 +1,45 @@
+#ifndef _MODEL_INCREMENTAL_H_
+#define _MODEL_INCREMENTAL_H_
+
+#include <cstdint>
+#include <string>
+
+// 增量抽取的簿记信息, 不属于抽取结果本身, 不会随TU的重新抽取而删除
+namespace DbModel {
+
+// 文件内容哈希, file 为 files 表中的ID
+struct FileHash {
+  int64_t file;
+  std::string path; // 规范化后的绝对路径
+  std::string hash;
+};
+
+// TU(以主文件的ID表示)解析时读取过的全部文件, 包括主文件本身
+struct TuFile {
+  int64_t tu;
+  int64_t file;
+};
+
+// TU在表 table_name 中写入的行的 rowid 区间 [first, last].
+// 增量模式下各TU顺序抽取且不共享实体, 每个TU的行在各表中占据连续的 rowid
+struct TuRowRange {
+  int64_t tu;
+  std::string table_name;
+  int64_t first;
+  int64_t last;
+};
+
+struct IncrementalState {
+  std::string name;
+  int64_t value;
+};
+
+// 缓存仓库(以仓库类型名表示)在一次运行中达到的最大规模, 下次运行据此预留容量
+struct CacheSize {
+  std::string name;
+  int64_t size;
+};
+
+} // namespace DbModel
+
+#endif // _MODEL_INCREMENTAL_H_
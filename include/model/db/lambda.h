@@ -1,24 +1,25 @@
 #ifndef _MODEL_LAMBDA_H_
 #define _MODEL_LAMBDA_H_
 
+#include <cstdint>
 #include <string>
 
 namespace DbModel {
 
 struct Lambda {
-  int expr;
+  int64_t expr;
   std::string default_capture;
   bool has_explicit_return_type;
 };
 
 struct LambdaCapture {
-  int id;
-  int lambda;
-  int index;
-  int field;
+  int64_t id;
+  int64_t lambda;
+  int64_t index;
+  int64_t field;
   bool captured_by_reference;
   bool is_implicit;
-  int location;
+  int64_t location;
 };
 
 } // namespace DbModel
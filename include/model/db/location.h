@@ -1,6 +1,7 @@
 #ifndef _MODEL_LOCATION_H_
 #define _MODEL_LOCATION_H_
 
+#include <cstdint>
 #include <string>
 
 enum class LocationType { DEFAULT = 1, STMT = 2, EXPR = 3 };
@@ -8,35 +9,35 @@ enum class LocationType { DEFAULT = 1, STMT = 2, EXPR = 3 };
 namespace DbModel {
 
 struct Location {
-  int id;
-  int associated_id;
+  int64_t id;
+  int64_t associated_id;
 };
 
 struct LocationDefault {
-  int id;
-  int container;
-  int start_line;
-  int start_column;
-  int end_line;
-  int end_column;
+  int64_t id;
+  int64_t container;
+  int64_t start_line;
+  int64_t start_column;
+  int64_t end_line;
+  int64_t end_column;
 };
 
 struct LocationStmt {
-  int id;
-  int container;
-  int start_line;
-  int start_column;
-  int end_line;
-  int end_column;
+  int64_t id;
+  int64_t container;
+  int64_t start_line;
+  int64_t start_column;
+  int64_t end_line;
+  int64_t end_column;
 };
 
 struct LocationExpr {
-  int id;
-  int container;
-  int start_line;
-  int start_column;
-  int end_line;
-  int end_column;
+  int64_t id;
+  int64_t container;
+  int64_t start_line;
+  int64_t start_column;
+  int64_t end_line;
+  int64_t end_column;
 };
 
 } // namespace DbModel
@@ -1,6 +1,9 @@
 #ifndef _MODEL_PREPROCESSOR_H_
 #define _MODEL_PREPROCESSOR_H_
 
+#include "util/fingerprint.h"
+#include "util/string_pool.h"
+#include <cstdint>
 #include <string>
 
 enum class PreprocDirectKind {
@@ -27,63 +30,63 @@ enum class PreprocDirectKind {
 namespace DbModel {
 
 struct Preprocdirect {
-  int id;
-  int kind;
-  int location;
-  using KeyType = std::string;
+  int64_t id;
+  int64_t kind;
+  int64_t location;
+  using KeyType = Fingerprint;
 };
 
 struct Preprocpair {
-  int begin;
-  int elseelifend;
+  int64_t begin;
+  int64_t elseelifend;
 };
 
 struct Preproctrue {
-  int branch;
+  int64_t branch;
 };
 
 struct Preprocfalse {
-  int branch;
+  int64_t branch;
 };
 
 struct Preproctext {
-  int id;
-  std::string head;
-  std::string body;
+  int64_t id;
+  InternedString head;
+  InternedString body;
 };
 
 struct Includes {
-  int id;
-  int included;
+  int64_t id;
+  int64_t included;
 };
 
 struct MacroInvocation {
-  int id;
-  int macro_id;
-  int location;
-  int kind;
+  int64_t id;
+  int64_t macro_id;
+  int64_t location;
+  int64_t kind;
 };
 
 struct MacroParent {
-  int id;
-  int parent_id;
+  int64_t id;
+  int64_t parent_id;
 };
 
 struct MacroLocationBind {
-  int id;
-  int location;
+  int64_t id;
+  int64_t location;
 };
 
 struct MacroArgumentUnexpanded {
-  int invocation;
-  int argument_index;
-  std::string text;
+  int64_t invocation;
+  int64_t argument_index;
+  InternedString text;
 };
 
 struct MacroArgumentExpanded {
-  int invocation;
-  int argument_index;
-  std::string text;
+  int64_t invocation;
+  int64_t argument_index;
+  InternedString text;
 };
 
 } // namespace DbModel
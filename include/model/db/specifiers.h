@@ -1,29 +1,30 @@
 #ifndef _MODEL_SPECIFIERS_H_
 #define _MODEL_SPECIFIERS_H_
 
+#include <cstdint>
 #include <string>
 
 namespace DbModel {
 
 struct Specifier {
-  int id;
+  int64_t id;
   std::string str;
   using KeyType = std::string;
 };
 
 struct TypeSpecifiers {
-  int type_id;
-  int spec_id;
+  int64_t type_id;
+  int64_t spec_id;
 };
 
 struct FunSpecifiers {
-  int func_id;
-  int spec_id;
+  int64_t func_id;
+  int64_t spec_id;
 };
 
 struct VarSpecifiers {
-  int var_id;
-  int spec_id;
+  int64_t var_id;
+  int64_t spec_id;
 };
 
 } // namespace DbModel
@@ -1,6 +1,8 @@
 #ifndef _MODEL_STMT_H_
 #define _MODEL_STMT_H_
 
+#include "util/fingerprint.h"
+#include <cstdint>
 #include <string>
 
 enum class StmtKind {
@@ -38,71 +40,71 @@ enum class StmtKind {
 namespace DbModel {
 
 struct Stmt {
-  int id;
-  int kind;
-  int location;
-  using KeyType = std::string;
+  int64_t id;
+  int64_t kind;
+  int64_t location;
+  using KeyType = Fingerprint;
 };
 
 struct IfInit {
-  int if_stmt;
-  int init_id;
+  int64_t if_stmt;
+  int64_t init_id;
 };
 
 struct IfThen {
-  int if_stmt;
-  int then_id;
+  int64_t if_stmt;
+  int64_t then_id;
 };
 
 struct IfElse {
-  int if_stmt;
-  int else_id;
+  int64_t if_stmt;
+  int64_t else_id;
 };
 
 struct ForInit {
-  int for_stmt;
-  int init_id;
+  int64_t for_stmt;
+  int64_t init_id;
 };
 
 struct ForCond {
-  int for_stmt;
-  int condition_id;
+  int64_t for_stmt;
+  int64_t condition_id;
 };
 
 struct ForUpdate {
-  int for_stmt;
-  int update_id;
+  int64_t for_stmt;
+  int64_t update_id;
 };
 
 struct ForBody {
-  int for_stmt;
-  int body_id;
+  int64_t for_stmt;
+  int64_t body_id;
 };
 
 struct WhileBody {
-  int while_stmt;
-  int body_id;
+  int64_t while_stmt;
+  int64_t body_id;
 };
 
 struct DoBody {
-  int do_stmt;
-  int body_id;
+  int64_t do_stmt;
+  int64_t body_id;
 };
 
 struct SwitchInit {
-  int switch_stmt;
-  int init_id;
+  int64_t switch_stmt;
+  int64_t init_id;
 };
 
 struct SwitchCase {
-  int switch_stmt;
-  int index;
-  int case_id;
+  int64_t switch_stmt;
+  int64_t index;
+  int64_t case_id;
 };
 
 struct SwitchBody {
-  int switch_stmt;
-  int body_id;
+  int64_t switch_stmt;
+  int64_t body_id;
 };
 
 } // namespace DbModel
@@ -1,6 +1,9 @@
 #ifndef _MODEL_TYPE_H_
 #define _MODEL_TYPE_H_
 
+#include "util/fingerprint.h"
+#include "util/string_pool.h"
+#include <cstdint>
 #include <string>
 
 enum class TypeType {
@@ -114,208 +117,208 @@ enum class DerivedTypeKind {
 namespace DbModel {
 
 struct Type {
-  int id;
-  int associate_id;
-  int type;
-  using KeyType = std::string;
+  int64_t id;
+  int64_t associate_id;
+  int64_t type;
+  using KeyType = Fingerprint;
 };
 
 struct TypeDecl {
-  int id;
-  int type_id;
-  int location;
+  int64_t id;
+  int64_t type_id;
+  int64_t location;
 };
 
 struct TypeDef {
-  int id;
+  int64_t id;
 };
 
 struct TypeDeclTop {
-  int type_decl;
+  int64_t type_decl;
 };
 
 struct BuiltinType_ {
-  int id;
-  std::string name;
-  int kind;
-  int size;
-  int sign;
-  int alignment;
+  int64_t id;
+  InternedString name;
+  int64_t kind;
+  int64_t size;
+  int64_t sign;
+  int64_t alignment;
 };
 
 struct DerivedType {
-  int id;
-  std::string name;
-  int kind;
-  int type_id;
+  int64_t id;
+  InternedString name;
+  int64_t kind;
+  int64_t type_id;
 };
 
 struct UserType {
-  int id;
-  std::string name;
-  int kind;
-  using KeyType = std::string;
+  int64_t id;
+  InternedString name;
+  int64_t kind;
+  using KeyType = Fingerprint;
 };
 
 struct RoutineType {
-  int id;
-  int return_type;
+  int64_t id;
+  int64_t return_type;
 };
 
 struct RoutineTypeArg {
-  int routine;
-  int index;
-  int type_id;
+  int64_t routine;
+  int64_t index;
+  int64_t type_id;
 };
 
 struct PtrToMember {
-  int id;
-  int type_id;
-  int class_id;
+  int64_t id;
+  int64_t type_id;
+  int64_t class_id;
 };
 
 struct DeclType {
-  int id;
-  int expr;
-  int base_type;
+  int64_t id;
+  int64_t expr;
+  int64_t base_type;
   bool parentheses_would_change_meaning;
 };
 
 struct IsPodClass {
-  int id;
+  int64_t id;
 };
 
 struct IsStandartLayoutClass {
-  int id;
+  int64_t id;
 };
 
 struct IsComplete {
-  int id;
+  int64_t id;
 };
 
 struct IsClassTemplate {
-  int id;
+  int64_t id;
 };
 
 struct ClassInstantiation {
-  int to;
-  int from;
+  int64_t to;
+  int64_t from;
 };
 
 struct ClassTemplateArgument {
-  int type_id;
-  int index;
-  int arg_type;
+  int64_t type_id;
+  int64_t index;
+  int64_t arg_type;
 };
 
 struct ClassTemplateArgumentValue {
-  int type_id;
-  int index;
-  int arg_value;
+  int64_t type_id;
+  int64_t index;
+  int64_t arg_value;
 };
 
 struct TemplateTemplateInstantiation {
-  int to;
-  int from;
+  int64_t to;
+  int64_t from;
 };
 
 struct TemplateTemplateArgument {
-  int type_id;
-  int index;
-  int arg_type;
+  int64_t type_id;
+  int64_t index;
+  int64_t arg_type;
 };
 
 struct TypeTemplateTypeConstraint {
-  int id;
-  int constraint;
+  int64_t id;
+  int64_t constraint;
 };
 
 struct NonTypeTemplateParameter {
-  int id;
+  int64_t id;
 };
 
 struct Derivation {
-  int id;
-  int sub;
-  int index;
-  int super;
-  int location;
-  int is_dependent = 0;
+  int64_t id;
+  int64_t sub;
+  int64_t index;
+  int64_t super;
+  int64_t location;
+  int64_t is_dependent = 0;
   std::string dependent_super_name = "";
   using KeyType = std::string;
 };
 
 struct DerSpecifier {
-  int der_id;
-  int spec_id;
+  int64_t der_id;
+  int64_t spec_id;
 };
 
 struct DirectBaseOffset {
-  int der_id;
-  int offset;
+  int64_t der_id;
+  int64_t offset;
 };
 
 struct VirtualBaseOffset {
-  int sub;
-  int super;
-  int offset;
+  int64_t sub;
+  int64_t super;
+  int64_t offset;
 };
 
 struct ArborLayoutProvenance {
-  int id;
+  int64_t id;
   std::string clang_version;
   std::string target_triple;
   std::string abi_kind;
-  int char_width;
-  int pointer_width;
+  int64_t char_width;
+  int64_t pointer_width;
 };
 
 struct ArborRecordLayoutTrait {
-  int id;
-  int ends_with_zero_sized_object;
-  int leads_with_zero_sized_base;
-  int has_own_vfptr;
-  int has_extendable_vfptr;
-  int has_vbptr;
+  int64_t id;
+  int64_t ends_with_zero_sized_object;
+  int64_t leads_with_zero_sized_base;
+  int64_t has_own_vfptr;
+  int64_t has_extendable_vfptr;
+  int64_t has_vbptr;
 };
 
 struct ArborDirectBaseLayoutTrait {
-  int der_id;
-  int is_empty_base;
-  int uses_empty_base_optimization;
-  int is_primary_base;
-  int is_primary_base_virtual;
+  int64_t der_id;
+  int64_t is_empty_base;
+  int64_t uses_empty_base_optimization;
+  int64_t is_primary_base;
+  int64_t is_primary_base_virtual;
 };
 
 // For enumconstants table
 struct EnumConstant {
-  int id;
-  int parent;        // @usertype ref - parent enum
-  int index;         // Position in enum definition
-  int type_id;       // @type ref - type of the enum constant
+  int64_t id;
+  int64_t parent;        // @usertype ref - parent enum
+  int64_t index;         // Position in enum definition
+  int64_t type_id;       // @type ref - type of the enum constant
   std::string name;  // Constant name
-  int location;      // @location_default ref
+  int64_t location;      // @location_default ref
 };
 
 // For typedefbase table
 struct TypedefBase {
-  int id;            // @usertype ref - the typedef
-  int type_id;       // @type ref - underlying type
+  int64_t id;            // @usertype ref - the typedef
+  int64_t type_id;       // @type ref - underlying type
 };
 
 // For arraysizes table
 struct ArraySizes {
-  int id;            // @derivedtype ref - the array type
-  int num_elements;  // Number of elements (0 for incomplete arrays)
-  int bytesize;      // Total size in bytes
-  int alignment;     // Alignment requirement in bytes
+  int64_t id;            // @derivedtype ref - the array type
+  int64_t num_elements;  // Number of elements (0 for incomplete arrays)
+  int64_t bytesize;      // Total size in bytes
+  int64_t alignment;     // Alignment requirement in bytes
 };
 
 // For pointerishsize table
 struct PointerishSize {
-  int id;            // @derivedtype ref - the pointer type
-  int size;          // Pointer size in bytes
-  int alignment;     // Pointer alignment in bytes
+  int64_t id;            // @derivedtype ref - the pointer type
+  int64_t size;          // Pointer size in bytes
+  int64_t alignment;     // Pointer alignment in bytes
 };
 
 } // namespace DbModel
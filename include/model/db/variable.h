@@ -1,6 +1,9 @@
 #ifndef _MODEL_VARIABLE_H_
 #define _MODEL_VARIABLE_H_
 
+#include "util/fingerprint.h"
+#include "util/string_pool.h"
+#include <cstdint>
 #include <string>
 
 // TO BE REMOVED: VarType enum - no longer needed for direct relationships
@@ -17,10 +20,10 @@ namespace DbModel {
 
 // TO BE REMOVED: Variable struct - intermediary table no longer needed
 struct Variable {
-   int id;
-   int associate_id;
-   int type;
-   using KeyType = std::string;
+   int64_t id;
+   int64_t associate_id;
+   int64_t type;
+   using KeyType = Fingerprint;
  };
 
 // TO BE REMOVED: LocalScopeVar struct - intermediary table no longer needed
@@ -31,111 +34,111 @@ struct Variable {
 // };
 
 struct LocalVar {
-  int id;
-  int type_id;
-  std::string name;
+  int64_t id;
+  int64_t type_id;
+  InternedString name;
 };
 
 struct Parameter {
-  int id;
-  int function;
-  int index;
-  int type_id;
+  int64_t id;
+  int64_t function;
+  int64_t index;
+  int64_t type_id;
 };
 
 struct GlobalVar {
-  int id;
-  int type_id;
-  std::string name;
+  int64_t id;
+  int64_t type_id;
+  InternedString name;
 };
 
 struct MemberVar {
-  int id;
-  int type_id;
-  std::string name;
-  using KeyType = std::string;
+  int64_t id;
+  int64_t type_id;
+  InternedString name;
+  using KeyType = Fingerprint;
 };
 
 struct VarDecl {
-  int id;
-  int variable;
-  int type_id;
-  std::string name;
-  int location;
+  int64_t id;
+  int64_t variable;
+  int64_t type_id;
+  InternedString name;
+  int64_t location;
 };
 
 struct VarDef {
-  int id;
+  int64_t id;
 };
 
 struct VarSpecialized {
-  int id;
+  int64_t id;
 };
 
 struct IsVariableTemplate {
-  int id;
+  int64_t id;
 };
 
 struct VariableInstantiation {
-  int to;
-  int from;
+  int64_t to;
+  int64_t from;
 };
 
 struct VariableTemplateArgument {
-  int variable_id;
-  int index;
-  int arg_type;
+  int64_t variable_id;
+  int64_t index;
+  int64_t arg_type;
 };
 
 struct VariableTemplateArgumentValue {
-  int variable_id;
-  int index;
-  int arg_value;
+  int64_t variable_id;
+  int64_t index;
+  int64_t arg_value;
 };
 
 struct VarDeclSpec {
-  int id;
+  int64_t id;
   std::string name;
 };
 
 struct IsStructuredBinding {
-  int id;
+  int64_t id;
 };
 
 struct VarRequire {
-  int id;
-  int constraint;
+  int64_t id;
+  int64_t constraint;
 };
 
 struct FieldOffset {
-  int id;
-  int byteoffset;
-  int bitoffset;
+  int64_t id;
+  int64_t byteoffset;
+  int64_t bitoffset;
 };
 
 struct BitField {
-  int id;
-  int bits;
-  int declared_bits;
+  int64_t id;
+  int64_t bits;
+  int64_t declared_bits;
 };
 
 struct ArborFieldLayoutTrait {
-  int id;
-  int is_bitfield;
-  int is_zero_size;
-  int is_potentially_overlapping;
-  int has_no_unique_address;
-  int is_anonymous_struct_or_union;
-  int parent_is_union;
+  int64_t id;
+  int64_t is_bitfield;
+  int64_t is_zero_size;
+  int64_t is_potentially_overlapping;
+  int64_t has_no_unique_address;
+  int64_t is_anonymous_struct_or_union;
+  int64_t parent_is_union;
 };
 
 struct ArborIndirectFieldPath {
-  int id;
-  int parent;
-  int leaf;
+  int64_t id;
+  int64_t parent;
+  int64_t leaf;
   std::string name;
   std::string path;
-  int field_count;
+  int64_t field_count;
 };
 } // namespace DbModel
 
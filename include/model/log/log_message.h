@@ -15,6 +15,11 @@ struct LogMessage {
   LogMessage(LogLevel lvl, std::string msg, std::string src_file, int src_line)
       : level(lvl), timestamp(std::chrono::system_clock::now()),
         message(std::move(msg)), file(std::move(src_file)), line(src_line) {}
+
+  LogMessage(LogLevel lvl, std::chrono::system_clock::time_point time,
+             std::string msg, std::string src_file, int src_line)
+      : level(lvl), timestamp(time), message(std::move(msg)),
+        file(std::move(src_file)), line(src_line) {}
 };
 
 #endif // _LOG_MESSAGE_H_
\ No newline at end of file
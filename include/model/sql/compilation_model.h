@@ -15,7 +15,7 @@ public:
 
 class CompilationArgsModel : public SQLModel {
 public:
-  CompilationArgsModel(int compilation_id, int num) {
+  CompilationArgsModel(int64_t compilation_id, int num) {
     setField("id", compilation_id);
     setField("num", num);
   }
@@ -36,7 +36,7 @@ enum class CompilationTimeKind {
 
 class CompilationTimeModel : public SQLModel {
 public:
-  CompilationTimeModel(int compilation_id, int file_num) {
+  CompilationTimeModel(int64_t compilation_id, int file_num) {
     setField("id", compilation_id);
     setField("num", file_num);
   }
@@ -54,7 +54,7 @@ public:
 
 class CompilationFinishedModel : public SQLModel {
 public:
-  CompilationFinishedModel(int compilation_id) {
+  CompilationFinishedModel(int64_t compilation_id) {
     setField("id", compilation_id);
   }
 
@@ -0,0 +1,64 @@
+#ifndef _BLOOM_FILTER_H_
+#define _BLOOM_FILTER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// 布隆过滤器: 按容量分配位数组, 每个元素置 kProbes 个位.
+// mayContain 返回 false 时元素一定未加入; 元素数不超过容量时误判率约 1%
+template <typename Key, typename Hash = std::hash<Key>> class BloomFilter {
+public:
+  explicit BloomFilter(size_t capacity)
+      : capacity_(std::max<size_t>(capacity, 1)),
+        words_((capacity_ * kBitsPerKey + 63) / 64), bits_(words_.size() * 64) {}
+
+  void add(const Key &key) {
+    ++size_;
+    uint64_t h1, h2;
+    hashes(key, h1, h2);
+    for (int i = 0; i < kProbes; ++i, h1 += h2) {
+      const uint64_t bit = h1 % bits_;
+      words_[bit >> 6] |= uint64_t{1} << (bit & 63);
+    }
+  }
+
+  bool mayContain(const Key &key) const {
+    uint64_t h1, h2;
+    hashes(key, h1, h2);
+    for (int i = 0; i < kProbes; ++i, h1 += h2) {
+      const uint64_t bit = h1 % bits_;
+      if (!(words_[bit >> 6] & (uint64_t{1} << (bit & 63))))
+        return false;
+    }
+    return true;
+  }
+
+  size_t capacity() const { return capacity_; }
+  bool full() const { return size_ >= capacity_; }
+
+private:
+  static constexpr size_t kBitsPerKey = 10;
+  static constexpr int kProbes = 7;
+
+  // 由一次哈希派生两个独立的值, 第 i 个探测位为 h1 + i * h2
+  static void hashes(const Key &key, uint64_t &h1, uint64_t &h2) {
+    uint64_t h = static_cast<uint64_t>(Hash{}(key));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h1 = h;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    h2 = h | 1;
+  }
+
+  size_t capacity_;
+  size_t size_ = 0;
+  std::vector<uint64_t> words_;
+  size_t bits_;
+};
+
+#endif // _BLOOM_FILTER_H_
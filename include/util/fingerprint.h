@@ -0,0 +1,168 @@
+#ifndef _FINGERPRINT_H_
+#define _FINGERPRINT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+
+// 128位节点指纹, 用作缓存Key; 全零表示空Key
+struct Fingerprint {
+  uint64_t lo = 0;
+  uint64_t hi = 0;
+
+  bool empty() const { return lo == 0 && hi == 0; }
+
+  friend bool operator==(const Fingerprint &a, const Fingerprint &b) {
+    return a.lo == b.lo && a.hi == b.hi;
+  }
+  friend bool operator!=(const Fingerprint &a, const Fingerprint &b) {
+    return !(a == b);
+  }
+
+  static Fingerprint of(std::string_view text);
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Fingerprint &fp) {
+  auto flags = os.flags();
+  auto fill = os.fill('0');
+  os << std::hex << std::setw(16) << fp.hi << std::setw(16) << fp.lo;
+  os.flags(flags);
+  os.fill(fill);
+  return os;
+}
+
+template <> struct std::hash<Fingerprint> {
+  size_t operator()(const Fingerprint &fp) const noexcept {
+    // 指纹本身已充分混合, 取低64位即可
+    return static_cast<size_t>(fp.lo);
+  }
+};
+
+// 增量计算指纹(MurmurHash3 x64_128 的流式实现)
+// 结果只取决于写入的字节序列, 与分几次写入无关
+class FingerprintBuilder {
+public:
+  FingerprintBuilder &addBytes(const void *data, size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    total_ += size;
+
+    if (buffered_ > 0) {
+      size_t take = std::min(size, kBlock - buffered_);
+      std::memcpy(buffer_ + buffered_, bytes, take);
+      buffered_ += take;
+      bytes += take;
+      size -= take;
+      if (buffered_ < kBlock)
+        return *this;
+      mixBlock(buffer_);
+      buffered_ = 0;
+    }
+
+    for (; size >= kBlock; bytes += kBlock, size -= kBlock)
+      mixBlock(bytes);
+
+    std::memcpy(buffer_, bytes, size);
+    buffered_ = size;
+    return *this;
+  }
+
+  FingerprintBuilder &add(std::string_view text) {
+    return addBytes(text.data(), text.size());
+  }
+
+  FingerprintBuilder &add(const Fingerprint &fp) {
+    addBytes(&fp.lo, sizeof(fp.lo));
+    return addBytes(&fp.hi, sizeof(fp.hi));
+  }
+
+  Fingerprint finish() const {
+    uint64_t h1 = h1_, h2 = h2_;
+    uint64_t k1 = 0, k2 = 0;
+
+    for (size_t i = buffered_; i > 8; --i)
+      k2 ^= uint64_t(buffer_[i - 1]) << ((i - 9) * 8);
+    if (buffered_ > 8) {
+      k2 *= kC2;
+      k2 = rotl(k2, 33);
+      k2 *= kC1;
+      h2 ^= k2;
+    }
+    for (size_t i = std::min<size_t>(buffered_, 8); i > 0; --i)
+      k1 ^= uint64_t(buffer_[i - 1]) << ((i - 1) * 8);
+    if (buffered_ > 0) {
+      k1 *= kC1;
+      k1 = rotl(k1, 31);
+      k1 *= kC2;
+      h1 ^= k1;
+    }
+
+    h1 ^= total_;
+    h2 ^= total_;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix(h1);
+    h2 = fmix(h2);
+    h1 += h2;
+    h2 += h1;
+
+    // 全零保留给空Key
+    if (h1 == 0 && h2 == 0)
+      h1 = 1;
+    return Fingerprint{h1, h2};
+  }
+
+private:
+  static constexpr size_t kBlock = 16;
+  static constexpr uint64_t kC1 = 0x87c37b91114253d5ULL;
+  static constexpr uint64_t kC2 = 0x4cf5ad432745937fULL;
+
+  uint64_t h1_ = 0;
+  uint64_t h2_ = 0;
+  uint64_t total_ = 0;
+  size_t buffered_ = 0;
+  unsigned char buffer_[kBlock];
+
+  static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+  static uint64_t fmix(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+  }
+
+  void mixBlock(const unsigned char *block) {
+    uint64_t k1, k2;
+    std::memcpy(&k1, block, sizeof(k1));
+    std::memcpy(&k2, block + 8, sizeof(k2));
+
+    k1 *= kC1;
+    k1 = rotl(k1, 31);
+    k1 *= kC2;
+    h1_ ^= k1;
+    h1_ = rotl(h1_, 27);
+    h1_ += h2_;
+    h1_ = h1_ * 5 + 0x52dce729;
+
+    k2 *= kC2;
+    k2 = rotl(k2, 33);
+    k2 *= kC1;
+    h2_ ^= k2;
+    h2_ = rotl(h2_, 31);
+    h2_ += h1_;
+    h2_ = h2_ * 5 + 0x38495ab5;
+  }
+};
+
+inline Fingerprint Fingerprint::of(std::string_view text) {
+  return FingerprintBuilder().add(text).finish();
+}
+
+#endif // _FINGERPRINT_H_
@@ -0,0 +1,123 @@
+#ifndef _FLAT_HASH_MAP_H_
+#define _FLAT_HASH_MAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// 开放寻址(线性探测)的扁平哈希表: 键值连续存放在一个数组中, 不为每个元素单独分配,
+// 另用一个字节数组记录槽位是否占用及哈希的高7位, 探测时先比较该字节再比较键.
+// 只支持插入与查找, 供只增不删的缓存使用
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+public:
+  const Value *find(const Key &key) const {
+    if (size_ == 0)
+      return nullptr;
+    const size_t hash = mix(Hash{}(key));
+    const uint8_t tag = tagOf(hash);
+    for (size_t index = hash & mask_;; index = (index + 1) & mask_) {
+      if (ctrl_[index] == kEmpty)
+        return nullptr;
+      if (ctrl_[index] == tag && slots_[index].key == key)
+        return &slots_[index].value;
+    }
+  }
+
+  // 键不存在时插入 value; 返回表中该键对应的值, 以及是否发生了插入
+  std::pair<const Value *, bool> try_emplace(const Key &key,
+                                             const Value &value) {
+    if ((size_ + 1) * 4 > capacity() * 3)
+      rehash(capacity() == 0 ? kMinCapacity : capacity() * 2);
+    const size_t hash = mix(Hash{}(key));
+    const uint8_t tag = tagOf(hash);
+    size_t index = hash & mask_;
+    for (; ctrl_[index] != kEmpty; index = (index + 1) & mask_) {
+      if (ctrl_[index] == tag && slots_[index].key == key)
+        return {&slots_[index].value, false};
+    }
+    ctrl_[index] = tag;
+    slots_[index] = Slot{key, value};
+    ++size_;
+    return {&slots_[index].value, true};
+  }
+
+  // 预留至少容纳 count 个元素的空间, 之后插入 count 个元素不会再扩容
+  void reserve(size_t count) {
+    size_t target = kMinCapacity;
+    while (target * 3 < count * 4)
+      target *= 2;
+    if (target > capacity())
+      rehash(target);
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return ctrl_.size(); }
+  // 槽位数组与标记数组占用的字节数
+  size_t memoryBytes() const {
+    return ctrl_.capacity() + slots_.capacity() * sizeof(Slot);
+  }
+
+  template <typename Fn> void forEach(Fn &&fn) const {
+    for (size_t i = 0; i < ctrl_.size(); ++i)
+      if (ctrl_[i] != kEmpty)
+        fn(slots_[i].key, slots_[i].value);
+  }
+
+  // 清空元素但保留容量, 后续同等规模的插入不必重新扩容
+  void clear() {
+    std::fill(ctrl_.begin(), ctrl_.end(), kEmpty);
+    std::fill(slots_.begin(), slots_.end(), Slot{});
+    size_ = 0;
+  }
+
+private:
+  struct Slot {
+    Key key{};
+    Value value{};
+  };
+
+  static constexpr uint8_t kEmpty = 0;
+  static constexpr size_t kMinCapacity = 16;
+
+  // 对原始哈希再做一次混合, 使低位(槽位下标)与高位(标记)都分布均匀
+  static size_t mix(size_t hash) {
+    uint64_t h = static_cast<uint64_t>(hash);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+  }
+
+  static uint8_t tagOf(size_t hash) {
+    return static_cast<uint8_t>(0x80 | (hash >> (sizeof(size_t) * 8 - 7)));
+  }
+
+  void rehash(size_t newCapacity) {
+    std::vector<uint8_t> oldCtrl(newCapacity, kEmpty);
+    std::vector<Slot> oldSlots(newCapacity);
+    oldCtrl.swap(ctrl_);
+    oldSlots.swap(slots_);
+    mask_ = newCapacity - 1;
+    for (size_t i = 0; i < oldCtrl.size(); ++i) {
+      if (oldCtrl[i] == kEmpty)
+        continue;
+      size_t index = mix(Hash{}(oldSlots[i].key)) & mask_;
+      while (ctrl_[index] != kEmpty)
+        index = (index + 1) & mask_;
+      ctrl_[index] = oldCtrl[i];
+      slots_[index] = std::move(oldSlots[i]);
+    }
+  }
+
+  std::vector<uint8_t> ctrl_;
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+  size_t mask_ = 0;
+};
+
+#endif // _FLAT_HASH_MAP_H_
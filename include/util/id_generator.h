@@ -3,36 +3,81 @@
 
 #include "util/logger/macros.h"
 #include <atomic>
-#include <mutex>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
 #include <type_traits>
 
 #define GENID(type) IDGenerator::generateId<DbModel::type>()
 
+// 无锁ID分配: 每个线程从全局计数器一次领取一段连续ID, 之后在本线程内分配
 class IDGenerator {
+public:
+  // 对外暴露的ID类型, 与 DbModel 中的整数列一致
+  // 大型代码库的实体总数会超出 32 位
+  using IdType = std::int64_t;
+
 private:
-  static std::mutex mutex_;
-  static std::atomic<int> global_id_;
+  static constexpr std::int64_t kBlockSize = 1024;
+
+  struct IdBlock {
+    std::int64_t next = 0; // 本线程最近一次分配的ID
+    std::int64_t end = 0;  // 当前ID段的最后一个ID
+  };
+
+  static std::atomic<std::int64_t> global_id_;
+  static thread_local IdBlock block_;
+
+  static void refillBlock() {
+    std::int64_t base =
+        global_id_.fetch_add(kBlockSize, std::memory_order_relaxed);
+    if (base > std::numeric_limits<IdType>::max() - kBlockSize)
+      throw std::overflow_error("IDGenerator: ID space exhausted");
+    block_.next = base;
+    block_.end = base + kBlockSize;
+  }
 
 public:
-  template <typename T> static int generateId() {
+  template <typename T> static IdType generateId() {
     static_assert(std::is_member_pointer<decltype(&T::id)>::value,
                   "Model must have an 'id' member");
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    return ++global_id_;
+    if (block_.next == block_.end)
+      refillBlock();
+    return static_cast<IdType>(++block_.next);
   }
 
-  template <typename T> static int getLastGeneratedId() {
+  // 返回当前线程最近一次分配的ID
+  template <typename T> static IdType getLastGeneratedId() {
     static_assert(std::is_member_pointer<decltype(&T::id)>::value,
                   "Model must have an 'id' member");
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    int current_id = global_id_.load();
-    return current_id > 0 ? current_id : 0;
+    return static_cast<IdType>(block_.next);
   }
 
-  template <typename T> static void generateAndSetId(const T &model) {
+  template <typename T> static void generateAndSetId(T &model) {
     model.id = generateId<T>();
   }
+
+  // 放弃本线程剩余的ID段, 返回此刻已领出的最大ID, 之后分配的ID均大于它.
+  // 本线程的ID段仍是最后领出的一段时把未用部分退回全局计数器,
+  // 增量抽取逐个TU调用时不会每次浪费一整段ID
+  static std::int64_t discardThreadBlock() {
+    std::int64_t end = block_.end;
+    global_id_.compare_exchange_strong(end, block_.next,
+                                       std::memory_order_relaxed);
+    block_.end = block_.next;
+    return global_id_.load(std::memory_order_relaxed);
+  }
+
+  // 之后领取的ID段都从 id 之后开始, 增量抽取时延续上次运行的ID
+  static void resumeAfter(std::int64_t id) {
+    std::int64_t current = global_id_.load(std::memory_order_relaxed);
+    while (current < id &&
+           !global_id_.compare_exchange_weak(current, id,
+                                             std::memory_order_relaxed))
+      ;
+    block_.end = block_.next;
+  }
 };
 #endif // _ID_GENERATOR_H_
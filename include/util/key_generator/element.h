@@ -2,6 +2,7 @@
 #define _KEY_GENERATOR_ELEMENT_H_
 
 #include "db/cache_repository.h"
+#include "util/fingerprint.h"
 #include "model/db/element.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
@@ -17,7 +18,7 @@
       .getRepository<CacheRepository<DbModel::ParameterizedElement>>()         \
       .insert(key, id)
 
-using KeyType = std::string;
+using KeyType = Fingerprint;
 using namespace clang;
 
 namespace KeyGen {
@@ -2,6 +2,7 @@
 #define _KEY_GENERATOR_EXPR_H_
 
 #include "db/cache_repository.h"
+#include "util/fingerprint.h"
 #include "model/db/expr.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/DeclTemplate.h>
@@ -18,7 +19,7 @@
       .getRepository<CacheRepository<DbModel::Expr>>()                         \
       .insert(key, id)
 
-using KeyType = std::string;
+using KeyType = Fingerprint;
 using namespace clang;
 
 namespace KeyGen {
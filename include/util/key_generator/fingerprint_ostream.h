@@ -0,0 +1,34 @@
+#ifndef _KEY_GENERATOR_FINGERPRINT_OSTREAM_H_
+#define _KEY_GENERATOR_FINGERPRINT_OSTREAM_H_
+
+#include "util/fingerprint.h"
+#include <llvm/Support/raw_ostream.h>
+
+// 将 raw_ostream 的输出直接喂给指纹, 不再拼接中间字符串
+// 写入的字节与原先拼出的Key字符串完全相同, 因此Key的等价关系保持不变
+class FingerprintOStream : public llvm::raw_ostream {
+public:
+  FingerprintOStream() : llvm::raw_ostream(/*unbuffered=*/true) {}
+
+  // 写入另一个指纹的原始字节, 用于组合Key
+  FingerprintOStream &add(const Fingerprint &fp) {
+    builder_.add(fp);
+    pos_ += sizeof(fp.lo) + sizeof(fp.hi);
+    return *this;
+  }
+
+  Fingerprint finish() const { return builder_.finish(); }
+
+private:
+  FingerprintBuilder builder_;
+  uint64_t pos_ = 0;
+
+  void write_impl(const char *ptr, size_t size) override {
+    builder_.addBytes(ptr, size);
+    pos_ += size;
+  }
+
+  uint64_t current_pos() const override { return pos_; }
+};
+
+#endif // _KEY_GENERATOR_FINGERPRINT_OSTREAM_H_
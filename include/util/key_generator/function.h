@@ -2,9 +2,11 @@
 #define _KEY_GENERATOR_FUNCTION_H_
 
 #include "db/cache_repository.h"
+#include "util/fingerprint.h"
 #include "model/db/function.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
+#include <optional>
 #include <string>
 
 #define SEARCH_FUNCTION_CACHE(type)                                            \
@@ -17,7 +19,7 @@
       .getRepository<CacheRepository<DbModel::Function>>()                     \
       .insert(key, id)
 
-using KeyType = std::string;
+using KeyType = Fingerprint;
 using namespace clang;
 
 namespace KeyGen {
@@ -26,6 +28,9 @@ namespace Function {
 
 KeyType makeKey(const FunctionDecl *FD, ASTContext *Context);
 
+// 已登记的函数ID, 本TU内按规范声明记忆, 等价于 SEARCH_FUNCTION_CACHE(makeKey())
+std::optional<int64_t> findId(const FunctionDecl *FD, ASTContext *Context);
+
 } // namespace Function
 
 } // namespace KeyGen
@@ -0,0 +1,76 @@
+#ifndef _KEY_GENERATOR_NODE_CACHE_H_
+#define _KEY_GENERATOR_NODE_CACHE_H_
+
+#include "util/fingerprint.h"
+#include "util/processor_metrics.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <llvm/ADT/DenseMap.h>
+#include <optional>
+
+using KeyType = Fingerprint;
+
+// 本TU内以节点指针为键的 Key/ID 记忆, 位于 KeyGen::*::makeKey 与
+// CacheRepository 之前: 同一个 Decl / 规范 Type 再次查找时不再构造 Key, 也不再
+// 经过 CacheManager 的锁与哈希表. 指纹 Key 仍是跨TU的唯一身份.
+// 节点地址只在所属 ASTContext 内有意义(下一个TU可能复用同一地址),
+// 因此每个TU开始时清空
+class NodeCache {
+public:
+  enum class Kind : unsigned {
+    Function,  // 规范 FunctionDecl
+    Variable,  // VarDecl
+    MemberVar, // FieldDecl
+    Type,      // 规范且去掉限定符的 Type
+    TypeDecl,  // NamedDecl (用户类型/模板)
+    Count
+  };
+
+  // 开始解析新的TU
+  static void enterTranslationUnit();
+
+  // 已记忆则直接返回, 否则调用 make() 计算 Key 并记下
+  template <typename MakeKey>
+  static KeyType key(Kind kind, const void *node, MakeKey &&make) {
+    auto &keys = table(kind).keys;
+    if (auto it = keys.find(node); it != keys.end())
+      return it->second;
+    // make() 可能递归生成其他节点的 Key, 完成后再插入
+    KeyType key = make();
+    table(kind).keys.try_emplace(node, key);
+    return key;
+  }
+
+  // 已记忆则直接返回, 否则调用 lookup() 查 CacheRepository;
+  // 只记忆命中的结果, 未命中的节点可能稍后在本TU内被处理.
+  // 直接返回同样计为一次缓存命中, 其余情况由 CacheRepository::find 计数
+  template <typename Lookup>
+  static std::optional<int64_t> id(Kind kind, const void *node,
+                                   Lookup &&lookup) {
+    auto &ids = table(kind).ids;
+    if (auto it = ids.find(node); it != ids.end()) {
+      ProcessorMetrics::countCacheLookup(true);
+      return it->second;
+    }
+    std::optional<int64_t> found = lookup();
+    if (found)
+      table(kind).ids.try_emplace(node, *found);
+    return found;
+  }
+
+private:
+  struct Table {
+    llvm::DenseMap<const void *, KeyType> keys;
+    llvm::DenseMap<const void *, int64_t> ids;
+  };
+
+  static Table &table(Kind kind) {
+    return tables_[static_cast<size_t>(kind)];
+  }
+
+  static thread_local std::array<Table, static_cast<size_t>(Kind::Count)>
+      tables_;
+};
+
+#endif // _KEY_GENERATOR_NODE_CACHE_H_
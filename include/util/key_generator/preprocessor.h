@@ -2,6 +2,7 @@
 #define _KEY_GENERATOR_PREPROCESSOR_H_
 
 #include "db/cache_repository.h"
+#include "util/fingerprint.h"
 #include "model/db/preprocessor.h"
 #include <string>
 
@@ -15,7 +16,7 @@
       .getRepository<CacheRepository<DbModel::Preprocdirect>>()               \
       .insert(key, id)
 
-using KeyType = std::string;
+using KeyType = Fingerprint;
 
 namespace KeyGen {
 
@@ -2,11 +2,13 @@
 #define _KEY_GENERATOR_TYPE_H_
 
 #include "db/cache_repository.h"
+#include "util/fingerprint.h"
 #include "model/db/type.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclTemplate.h>
 #include <clang/AST/Type.h>
+#include <optional>
 #include <string>
 
 #define SEARCH_TYPE_CACHE(type)                                                \
@@ -19,7 +21,7 @@
       .getRepository<CacheRepository<DbModel::Type>>()                         \
       .insert(key, id)
 
-using KeyType = std::string;
+using KeyType = Fingerprint;
 using namespace clang;
 
 std::string getScopePath(const NamedDecl *decl);
@@ -27,6 +29,8 @@ std::string getDeclName(const NamedDecl *decl);
 std::string getTemplateArgs(const NamedDecl *decl);
 std::string getTemplateParamListAsString(const TemplateParameterList *params);
 std::string getTemplateArgumentListAsString(const TemplateArgumentList &args);
+// 可读的完整名称, 即 KeyGen::Type::makeKey(NamedDecl) 的指纹输入
+std::string getQualifiedDeclName(const NamedDecl *decl);
 
 namespace KeyGen {
 
@@ -44,6 +48,11 @@ KeyType makeKey(const TemplateDecl *decl, ASTContext *ctx);
 // clang::TypeDecl -> clang::NamedDecl
 KeyType makeKey(const TypeDecl *decl, ASTContext *ctx);
 
+// 已登记的类型ID, 本TU内按规范类型/声明记忆,
+// 等价于 SEARCH_TYPE_CACHE(makeKey())
+std::optional<int64_t> findId(const QualType &qualType, ASTContext *ctx);
+std::optional<int64_t> findId(const NamedDecl *decl, ASTContext *ctx);
+
 } // namespace Type
 
 } // namespace KeyGen
@@ -2,6 +2,7 @@
 #define _KEY_GENERATOR_VALUES_H_
 
 #include "db/cache_repository.h"
+#include "util/fingerprint.h"
 #include "model/db/expr.h"
 #include <clang/AST/ASTContext.h>
 #include <string>
@@ -26,7 +27,7 @@
       .getRepository<CacheRepository<DbModel::ValueText>>()                    \
       .insert(key, id)
 
-using KeyType = std::string;
+using KeyType = Fingerprint;
 using namespace clang;
 
 namespace KeyGen {
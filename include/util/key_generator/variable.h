@@ -2,8 +2,10 @@
 #define _KEY_GENERATOR_VARIABLE_H_
 
 #include "db/cache_repository.h"
+#include "util/fingerprint.h"
 #include "model/db/variable.h"
 #include <clang/AST/ASTContext.h>
+#include <optional>
 #include <string>
 
 #define SEARCH_VARIABLE_CACHE(type)                                            \
@@ -26,7 +28,7 @@
       .getRepository<CacheRepository<DbModel::MemberVar>>()                     \
       .insert(key, id)
 
-using KeyType = std::string;
+using KeyType = Fingerprint;
 using namespace clang;
 
 namespace KeyGen {
@@ -36,6 +38,9 @@ namespace Var {
 KeyType makeKey(const VarDecl *VD, ASTContext *ctx);
 // For clang::FieldDecl (MemberVar)
 KeyType makeKey(const FieldDecl *FD, ASTContext *ctx);
+// 已登记的变量/成员变量ID, 本TU内按声明记忆
+std::optional<int64_t> findId(const VarDecl *VD, ASTContext *ctx);
+std::optional<int64_t> findId(const FieldDecl *FD, ASTContext *ctx);
 } // namespace Var
 
 } // namespace KeyGen
@@ -0,0 +1,133 @@
+#ifndef _LOG_BUFFER_H_
+#define _LOG_BUFFER_H_
+
+#include "enum/log_level.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// 一条日志记录: 参数按类型编码进 payload, 由日志线程解码并格式化
+struct LogRecord {
+  LogLevel level;
+  const char *file;
+  int line;
+  std::chrono::system_clock::time_point timestamp;
+  std::string payload; // 复用容量, 稳定后不再分配
+};
+
+// 日志参数的二进制编码. 算术类型与字符串原样写入, 交给日志线程格式化;
+// 其余带 operator<< 的类型在调用线程上先格式化为文本
+namespace LogArgs {
+
+enum class Tag : uint8_t { Text, Int, UInt, Double, Char, Bool, Pointer, Manip };
+
+using Manipulator = std::ostream &(*)(std::ostream &);
+
+template <typename T> inline void put(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+inline void putText(std::string &out, std::string_view text) {
+  out.push_back(static_cast<char>(Tag::Text));
+  put(out, text.size());
+  out.append(text);
+}
+
+template <typename T> void encode(std::string &out, const T &value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    out.push_back(static_cast<char>(Tag::Bool));
+    put(out, value);
+  } else if constexpr (std::is_same_v<T, char> ||
+                       std::is_same_v<T, signed char> ||
+                       std::is_same_v<T, unsigned char>) {
+    out.push_back(static_cast<char>(Tag::Char));
+    put(out, static_cast<char>(value));
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    out.push_back(static_cast<char>(Tag::Int));
+    put(out, static_cast<int64_t>(value));
+  } else if constexpr (std::is_integral_v<T>) {
+    out.push_back(static_cast<char>(Tag::UInt));
+    put(out, static_cast<uint64_t>(value));
+  } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+    out.push_back(static_cast<char>(Tag::Double));
+    put(out, static_cast<double>(value));
+  } else if constexpr (std::is_pointer_v<T> &&
+                       std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>,
+                                      char>) {
+    putText(out, value ? std::string_view(value) : std::string_view("(null)"));
+  } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+    putText(out, static_cast<std::string_view>(value));
+  } else if constexpr (std::is_pointer_v<T>) {
+    out.push_back(static_cast<char>(Tag::Pointer));
+    put(out, static_cast<const void *>(value));
+  } else {
+    thread_local std::ostringstream stream;
+    stream.str(std::string());
+    stream.clear();
+    stream << value;
+    putText(out, stream.str());
+  }
+}
+
+inline void encodeManip(std::string &out, Manipulator manip) {
+  out.push_back(static_cast<char>(Tag::Manip));
+  put(out, manip);
+}
+
+// 按编码顺序把参数输出到 os
+void decode(std::string_view payload, std::ostream &os);
+
+} // namespace LogArgs
+
+// 单生产者单消费者的环形缓冲区, 槽位预先分配并循环复用.
+// 每个写日志的线程独占一个, 日志线程轮询全部缓冲区, 合起来构成无锁的多生产者单消费者队列
+class LogRing {
+public:
+  static constexpr size_t kCapacity = 1024; // 2 的幂
+
+  // 生产者: 取得下一个可写槽位, 缓冲区已满时返回 nullptr
+  LogRecord *acquire() {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == kCapacity)
+      return nullptr;
+    return &slots_[tail & (kCapacity - 1)];
+  }
+
+  // 生产者: 发布 acquire 得到的槽位
+  void publish() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  // 消费者: 最早发布的记录, 为空时返回 nullptr
+  LogRecord *front() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+      return nullptr;
+    return &slots_[head & (kCapacity - 1)];
+  }
+
+  // 消费者: 归还 front 得到的槽位
+  void pop() {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  // 线程退出后缓冲区交还, 由之后的新线程认领
+  std::atomic<bool> owned{false};
+  LogRing *next = nullptr;
+
+private:
+  std::array<LogRecord, kCapacity> slots_;
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
+#endif // _LOG_BUFFER_H_
@@ -4,17 +4,20 @@
 #include "enum/log_level.h"
 #include "model/config/configuration.h"
 #include "model/log/log_message.h"
-#include "util/thread_safe_queue.h"
+#include "util/logger/log_buffer.h"
 #include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 class Logger {
 private:
-  ThreadSafeQueue<LogMessage> queue_;
   std::ofstream log_file_;
   std::atomic<bool> running_{false};
   std::thread worker_thread_;
@@ -24,26 +27,46 @@ private:
   bool is_to_file_;
   bool is_to_console_;
 
-  // 定义一个结构体 LogContext，用于存储日志相关的上下文信息
-  struct LogContext {
-    std::ostringstream stream; // 使用 std::ostringstream
-                               // 来存储日志信息，可以方便地进行字符串拼接
-    LogLevel level;
-    const char *file;
-    int line;
+  // 全部线程的环形缓冲区(无锁单链表, 只增不删)
+  std::atomic<LogRing *> rings_{nullptr};
+  // 生产者发布记录或请求停止时递增; 日志线程空闲时在 wake_cv_ 上等待其变化,
+  // sleeping_ 为真时生产者才需要加锁唤醒
+  std::atomic<uint64_t> signal_{0};
+  std::atomic<bool> sleeping_{false};
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  // 解码与输出由日志线程完成; 日志线程未运行时(init 之前或 stop 之后)
+  // 由调用线程直接输出, 二者以该锁互斥
+  std::mutex output_mutex_;
+  std::ostringstream decode_stream_;
+
+  // 线程退出时交还其环形缓冲区
+  struct RingHandle {
+    LogRing *ring = nullptr;
+    ~RingHandle() {
+      if (ring)
+        ring->owned.store(false, std::memory_order_release);
+    }
   };
 
-  // 定义一个静态的 thread_local 变量 log_context_，用于存储当前线程的日志上下文
-  // thread_local 修饰符表示该变量在每个线程中都有独立的副本，不会在线程间共享
-  static thread_local LogContext log_context_;
+  static thread_local RingHandle ring_handle_;
+  // 当前正在写入的记录: 环形缓冲区中的槽位, 或日志线程未运行时的 direct_record_
+  static thread_local LogRecord *record_;
+  static thread_local LogRecord direct_record_;
   static thread_local bool is_logging_; // 标记当前线程是否正在进行日志记录
 
   Logger() = default;
-  ~Logger() = default;
+  ~Logger();
 
   Logger(const Logger &) = delete;
   Logger &operator=(const Logger &) = delete;
 
+  LogRing *claimRing();
+  LogRecord *acquireRecord();
+  void commitRecord();
+  void wakeWorker();
+  size_t drainRings();
+  LogMessage decodeRecord(const LogRecord &record);
   void processMessages();
   void formatOutput(const std::vector<LogMessage> &messages);
   void flushBuffer();
@@ -59,12 +82,16 @@ public:
   const char *levelToString(LogLevel level);
   LogLevel StringToLevel(const std::string &level);
 
+  // 宏在求值任何参数之前先检查级别, 被过滤的日志不做格式化
+  bool isEnabled(LogLevel level) const { return level >= log_level_threshold_; }
+
   // 定义一个函数调用运算符，用于设置日志级别和代码文件信息
   Logger &operator()(LogLevel level, const char *file, int line);
 
+  // 参数只做编码, 格式化推迟到日志线程
   template <typename T> Logger &operator<<(const T &value) {
     if (is_logging_)
-      log_context_.stream << value;
+      LogArgs::encode(record_->payload, value);
     return *this;
   }
 
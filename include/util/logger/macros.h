@@ -4,12 +4,26 @@
 #include "logger.h"
 #include "model/log/log_message.h"
 
+// 编译期最低日志级别(LogLevel 的数值), 低于它的日志语句连同参数求值一起被删除;
+// release 构建以 -DLOG_MIN_LEVEL=1 去掉全部 LOG_DEBUG
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
 #define LOG(level) Logger::getInstance()(level, __FILE__, __LINE__)
 
-#define LOG_DEBUG LOG(LogLevel::DEBUG)
-#define LOG_INFO LOG(LogLevel::INFO)
-#define LOG_WARNING LOG(LogLevel::WARNING)
-#define LOG_ERROR LOG(LogLevel::ERROR)
+// 先按编译期与运行期级别过滤, 被过滤的语句不会求值 << 右侧的参数.
+// 用单次 for 而非 if-else 包装, 宏出现在无括号的 if 中时不会产生悬空 else
+#define LOG_IF_ENABLED(level)                                                  \
+  for (bool log_enabled_ = static_cast<int>(level) >= LOG_MIN_LEVEL &&         \
+                           Logger::getInstance().isEnabled(level);             \
+       log_enabled_; log_enabled_ = false)                                     \
+  LOG(level)
+
+#define LOG_DEBUG LOG_IF_ENABLED(LogLevel::DEBUG)
+#define LOG_INFO LOG_IF_ENABLED(LogLevel::INFO)
+#define LOG_WARNING LOG_IF_ENABLED(LogLevel::WARNING)
+#define LOG_ERROR LOG_IF_ENABLED(LogLevel::ERROR)
 
 #define INDENT_LEFT "                  "
 
@@ -0,0 +1,123 @@
+#ifndef _PERF_LOG_H_
+#define _PERF_LOG_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+
+// 作用域计时: 每个调用点只在首次执行时登记事件名, 未开启性能日志时只有一次判断
+// PERF_SPAN 每次执行输出一条区间记录, 用于阶段、TU 等低频区间;
+// PERF_ACCUMULATE 在线程内累加次数与耗时, 每个 TU 结束时输出一条汇总记录, 用于逐节点的处理
+#define PERF_SCOPE_(name, mode)                                                \
+  static const uint16_t PERF_CONCAT(perf_event_, __LINE__) =                   \
+      PerfLog::getInstance().registerEvent(name);                              \
+  PerfScope PERF_CONCAT(perf_scope_, __LINE__)(                                \
+      PERF_CONCAT(perf_event_, __LINE__), mode)
+
+#define PERF_SPAN(name) PERF_SCOPE_(name, PerfLog::Mode::Span)
+#define PERF_ACCUMULATE(name) PERF_SCOPE_(name, PerfLog::Mode::Accumulate)
+
+// 性能事件通道: 以紧凑的二进制记录写入单独的文件, 由 scripts/perf_summary.py 汇总.
+// 文件以 8 字节魔数 "CXXPERF1" 开头, 之后每条记录以 1 字节类型开始(本机字节序):
+//   Name      : uint16 事件ID, uint16 名称长度, 名称
+//   Span      : uint16 事件ID, uint32 线程号, uint64 开始时间(ns), uint64 耗时(ns)
+//   Aggregate : uint16 事件ID, uint32 线程号, uint64 次数, uint64 总耗时(ns)
+// 时间相对于 open 的时刻; 事件名在其ID第一次出现之前写入
+class PerfLog {
+public:
+  enum class Mode { Span, Accumulate };
+  enum class RecordKind : uint8_t { Name = 1, Span = 2, Aggregate = 3 };
+
+  static PerfLog &getInstance() {
+    static PerfLog instance;
+    return instance;
+  }
+
+  bool open(const std::string &path);
+  // 输出全部线程剩余的记录并关闭文件, 需在工作线程结束之后调用
+  void close();
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+  static uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  uint16_t registerEvent(const char *name);
+  void record(uint16_t event, Mode mode, uint64_t start, uint64_t duration);
+
+  // 输出当前线程累加的汇总记录, 在每个 TU 处理结束时调用
+  void flushThread();
+
+  PerfLog(const PerfLog &) = delete;
+  PerfLog &operator=(const PerfLog &) = delete;
+
+private:
+  struct Aggregate {
+    uint64_t count = 0;
+    uint64_t total = 0;
+  };
+
+  // 每个线程独立攒记录, 攒满后加锁写文件; 线程退出时输出剩余记录
+  struct ThreadBuffer {
+    uint32_t thread = 0;
+    std::string bytes;
+    std::vector<Aggregate> aggregates;
+    ~ThreadBuffer();
+  };
+
+  static constexpr size_t kFlushBytes = 64 * 1024;
+
+  PerfLog() = default;
+  ~PerfLog();
+
+  ThreadBuffer &threadBuffer();
+  void emitAggregates(ThreadBuffer &buffer);
+  void writeLocked(std::string &bytes);
+  void writeNameLocked(uint16_t event, const std::string &name);
+
+  static std::atomic<bool> enabled_;
+  static thread_local std::unique_ptr<ThreadBuffer> thread_buffer_;
+
+  std::mutex mutex_;
+  std::FILE *file_ = nullptr;
+  uint64_t origin_ = 0;
+  uint32_t next_thread_ = 0;
+  std::vector<std::string> names_;
+  std::vector<ThreadBuffer *> buffers_;
+};
+
+class PerfScope {
+public:
+  PerfScope(uint16_t event, PerfLog::Mode mode)
+      : event_(event), mode_(mode), active_(PerfLog::enabled()) {
+    if (active_)
+      start_ = PerfLog::now();
+  }
+
+  ~PerfScope() {
+    if (active_)
+      PerfLog::getInstance().record(event_, mode_, start_,
+                                    PerfLog::now() - start_);
+  }
+
+  PerfScope(const PerfScope &) = delete;
+  PerfScope &operator=(const PerfScope &) = delete;
+
+private:
+  uint16_t event_;
+  PerfLog::Mode mode_;
+  bool active_;
+  uint64_t start_ = 0;
+};
+
+#endif // _PERF_LOG_H_
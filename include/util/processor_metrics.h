@@ -0,0 +1,118 @@
+#ifndef _PROCESSOR_METRICS_H_
+#define _PROCESSOR_METRICS_H_
+
+#include "util/logger/perf_log.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+enum class ProcessorKind {
+  Function,
+  Variable,
+  Type,
+  Specifier,
+  Namespace,
+  Stmt,
+  Expr,
+  Template,
+  Inheritance,
+  RecordLayout,
+  Lambda,
+  Preprocessor,
+  Count
+};
+
+// 单个处理器实例(每个TU一组)的计数, 只由所在线程修改, 析构时并入全局统计
+struct ProcessorCounters {
+  uint64_t nodes = 0;        // 进入处理器入口的次数
+  uint64_t rows = 0;         // 写入的记录数
+  uint64_t cache_hits = 0;   // Key 到 ID 缓存的命中次数
+  uint64_t cache_misses = 0; // Key 到 ID 缓存的未命中次数
+  uint64_t time_ns = 0;      // 处理器自身耗时, 不含其调用的其他处理器;
+                             // 仅在开启性能日志时统计
+};
+
+// 各处理器在整个运行中的累计统计. 线程当前所处的处理器由 ProcessorScope 维护,
+// 写库与查缓存处据此把记录数和命中数记到对应的处理器上
+class ProcessorMetrics {
+public:
+  static ProcessorMetrics &getInstance() {
+    static ProcessorMetrics instance;
+    return instance;
+  }
+
+  static const char *name(ProcessorKind kind);
+
+  void merge(ProcessorKind kind, const ProcessorCounters &counters);
+  ProcessorCounters total(ProcessorKind kind) const;
+
+  static void countRow() {
+    if (current_)
+      ++current_->rows;
+  }
+
+  static void countCacheLookup(bool hit) {
+    if (current_)
+      ++(hit ? current_->cache_hits : current_->cache_misses);
+  }
+
+  ProcessorMetrics(const ProcessorMetrics &) = delete;
+  ProcessorMetrics &operator=(const ProcessorMetrics &) = delete;
+
+private:
+  friend class ProcessorScope;
+
+  struct AtomicCounters {
+    std::atomic<uint64_t> nodes{0};
+    std::atomic<uint64_t> rows{0};
+    std::atomic<uint64_t> cache_hits{0};
+    std::atomic<uint64_t> cache_misses{0};
+    std::atomic<uint64_t> time_ns{0};
+  };
+
+  ProcessorMetrics() = default;
+
+  std::array<AtomicCounters, static_cast<size_t>(ProcessorKind::Count)>
+      totals_;
+
+  static thread_local ProcessorCounters *current_;
+  // 当前处理器开始计时的时刻, 进入或退出嵌套的处理器时切换
+  static thread_local uint64_t switched_at_;
+};
+
+// 处理器入口处的作用域: 计一次节点, 开启性能日志时还把作用域内的耗时记到
+// 该处理器上, 嵌套进入其他处理器时暂停外层计时. 未开启时不读取时钟
+class ProcessorScope {
+public:
+  explicit ProcessorScope(ProcessorCounters &counters)
+      : previous_(ProcessorMetrics::current_), timed_(PerfLog::enabled()) {
+    if (timed_) {
+      const uint64_t now = PerfLog::now();
+      if (previous_)
+        previous_->time_ns += now - ProcessorMetrics::switched_at_;
+      ProcessorMetrics::switched_at_ = now;
+    }
+    ProcessorMetrics::current_ = &counters;
+    ++counters.nodes;
+  }
+
+  ~ProcessorScope() {
+    if (timed_) {
+      const uint64_t now = PerfLog::now();
+      ProcessorMetrics::current_->time_ns +=
+          now - ProcessorMetrics::switched_at_;
+      ProcessorMetrics::switched_at_ = now;
+    }
+    ProcessorMetrics::current_ = previous_;
+  }
+
+  ProcessorScope(const ProcessorScope &) = delete;
+  ProcessorScope &operator=(const ProcessorScope &) = delete;
+
+private:
+  ProcessorCounters *previous_;
+  const bool timed_;
+};
+
+#endif // _PROCESSOR_METRICS_H_
@@ -0,0 +1,78 @@
+#ifndef _STRING_POOL_H_
+#define _STRING_POOL_H_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#define INTERN(text) StringPool::getInstance().intern(text)
+
+// 驻留在 StringPool 中的字符串, 内容在进程结束前一直有效,
+// 可以随记录在线程间传递并延迟写入数据库; 只能由 StringPool 创建
+class InternedString {
+public:
+  InternedString() = default;
+
+  std::string_view view() const { return view_; }
+  operator std::string_view() const { return view_; }
+  bool empty() const { return view_.empty(); }
+
+  friend bool operator==(InternedString lhs, InternedString rhs) {
+    return lhs.view_ == rhs.view_;
+  }
+
+private:
+  friend class StringPool;
+  explicit InternedString(std::string_view view) : view_(view) {}
+
+  std::string_view view_ = ""; // 保证 data() 非空, 写库时为空串而非 NULL
+};
+
+inline std::ostream &operator<<(std::ostream &os, InternedString text) {
+  return os << text.view();
+}
+
+// 名称与类型拼写的驻留池: 每个不同的字符串只在块分配的内存中保存一份
+// 按哈希分片加锁, 多个前端工作线程可以同时驻留; 内存直到进程退出才释放
+class StringPool {
+public:
+  static StringPool &getInstance() {
+    static StringPool instance;
+    return instance;
+  }
+
+  InternedString intern(std::string_view text);
+
+  // 已驻留的不同字符串个数与内容总字节数
+  size_t size() const;
+  size_t bytes() const;
+
+  StringPool(const StringPool &) = delete;
+  StringPool &operator=(const StringPool &) = delete;
+
+private:
+  StringPool() = default;
+
+  static constexpr size_t kShardCount = 16;
+  static constexpr size_t kChunkSize = 64 * 1024;
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_set<std::string_view> strings;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char *cursor = nullptr;
+    size_t remaining = 0;
+    size_t bytes = 0;
+
+    std::string_view store(std::string_view text);
+  };
+
+  std::array<Shard, kShardCount> shards_;
+};
+
+#endif // _STRING_POOL_H_
@@ -1,6 +1,12 @@
 #!/usr/bin/python
 
-"""Generator for explicit instantiations of StorageFacade template methods"""
+"""Generator for explicit instantiations of StorageFacade template methods
+
+Each insertClassObj<T> instantiation also instantiates the per-model row
+buffer and cached prepared statements used by the batched writer.
+updateColumn<T> is instantiated only for the models declared with
+DECLARE_FIXUP_ROW / DECLARE_FIXUP_ROW_NO_IDENTITY in dependency_manager.h.
+"""
 import os
 import re
 
@@ -25,13 +31,25 @@ def find_dbmodel_structs(root_dir):
     return sorted(dbmodel_structs)
 
 
-def generate_instantiations(structs):
+def find_fixup_models(header):
+    """Find the models that DependencyManager resolves fixups for"""
+    fixup_pattern = re.compile(r"^DECLARE_FIXUP_ROW(?:_NO_IDENTITY)?\((\w+)", re.M)
+    with open(header, "r", encoding="utf-8") as f:
+        return sorted(set(fixup_pattern.findall(f.read())))
+
+
+def generate_instantiations(structs, fixup_models):
     """Generate explicit instantiation code"""
     instantiations = []
     for struct in structs:
         instantiations.append(
             f"template void StorageFacade::insertClassObj<DbModel::{struct}&>(DbModel::{struct}&);"
         )
+    for struct in fixup_models:
+        instantiations.append(
+            f"template void StorageFacade::updateColumn<DbModel::{struct}>(int64_t DbModel::{struct}::*, "
+            f"const std::vector<int64_t DbModel::{struct}::*>&, const std::vector<int64_t>&);"
+        )
     return "\n".join(instantiations)
 
 
@@ -45,7 +63,10 @@ def main():
         print("No DbModel structs found! Please check your code.")
         return
 
-    instantiations_code = generate_instantiations(dbmodel_structs)
+    fixup_models = find_fixup_models(
+        os.path.join(script_dir, "..", "include", "db", "dependency_manager.h")
+    )
+    instantiations_code = generate_instantiations(dbmodel_structs, fixup_models)
 
     output_dir = os.path.join(script_dir, "..", "src", "db")
     os.makedirs(output_dir, exist_ok=True)
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Summarize the binary perf event log written with enable_perf_logging.
+
+Record layout (native little-endian, see include/util/logger/perf_log.h):
+  header    : b"CXXPERF1"
+  Name      : u8 1, u16 event, u16 length, name
+  Span      : u8 2, u16 event, u32 thread, u64 start_ns, u64 duration_ns
+  Aggregate : u8 3, u16 event, u32 thread, u64 count, u64 total_ns
+"""
+
+from __future__ import annotations
+
+import argparse
+import struct
+import sys
+from collections import defaultdict
+from dataclasses import dataclass, field
+from pathlib import Path
+
+MAGIC = b"CXXPERF1"
+NAME = struct.Struct("<HH")
+RECORD = struct.Struct("<HIQQ")
+
+
+@dataclass
+class EventStats:
+    kind: str = "span"
+    count: int = 0
+    total_ns: int = 0
+    max_ns: int = 0
+    threads: set[int] = field(default_factory=set)
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(
+        description="Summarize a perf event log written by the extractor."
+    )
+    parser.add_argument("log", help="Path to the perf log (logging.perf_file)")
+    parser.add_argument(
+        "--by-thread",
+        action="store_true",
+        help="Break every event down per worker thread",
+    )
+    return parser.parse_args()
+
+
+def read_events(data: bytes) -> tuple[dict[int, str], dict[tuple[int, int], EventStats]]:
+    if not data.startswith(MAGIC):
+        raise ValueError("not a perf event log (bad magic)")
+
+    names: dict[int, str] = {}
+    stats: dict[tuple[int, int], EventStats] = defaultdict(EventStats)
+    pos = len(MAGIC)
+    while pos < len(data):
+        kind = data[pos]
+        pos += 1
+        if kind == 1:
+            event, length = NAME.unpack_from(data, pos)
+            pos += NAME.size
+            names[event] = data[pos : pos + length].decode("utf-8", "replace")
+            pos += length
+        elif kind in (2, 3):
+            event, thread, first, second = RECORD.unpack_from(data, pos)
+            pos += RECORD.size
+            entry = stats[(event, thread)]
+            if kind == 2:
+                entry.count += 1
+                entry.total_ns += second
+                entry.max_ns = max(entry.max_ns, second)
+            else:
+                entry.kind = "accumulated"
+                entry.count += first
+                entry.total_ns += second
+            entry.threads.add(thread)
+        else:
+            raise ValueError(f"unknown record kind {kind} at offset {pos - 1}")
+    return names, stats
+
+
+def merge_threads(stats: dict[tuple[int, int], EventStats]) -> dict[tuple[int, int], EventStats]:
+    merged: dict[tuple[int, int], EventStats] = defaultdict(EventStats)
+    for (event, thread), entry in stats.items():
+        target = merged[(event, -1)]
+        target.kind = entry.kind
+        target.count += entry.count
+        target.total_ns += entry.total_ns
+        target.max_ns = max(target.max_ns, entry.max_ns)
+        target.threads.add(thread)
+    return merged
+
+
+def print_table(names: dict[int, str], stats: dict[tuple[int, int], EventStats]) -> None:
+    header = f"{'event':<28} {'thread':>6} {'count':>12} {'total ms':>12} {'mean us':>10} {'max ms':>10}"
+    print(header)
+    print("-" * len(header))
+    rows = sorted(stats.items(), key=lambda item: item[1].total_ns, reverse=True)
+    for (event, thread), entry in rows:
+        name = names.get(event, f"#{event}")
+        thread_label = "all" if thread < 0 else str(thread)
+        mean_us = entry.total_ns / entry.count / 1e3 if entry.count else 0.0
+        max_ms = f"{entry.max_ns / 1e6:.3f}" if entry.kind == "span" else "-"
+        print(
+            f"{name:<28} {thread_label:>6} {entry.count:>12} "
+            f"{entry.total_ns / 1e6:>12.3f} {mean_us:>10.2f} {max_ms:>10}"
+        )
+
+
+def print_frontend(names: dict[int, str], stats: dict[tuple[int, int], EventStats]) -> None:
+    # tu.parse_and_extract 包含 tu.extract, 差值即 clang 前端解析耗时
+    totals = {names.get(event): entry.total_ns for (event, _), entry in stats.items()}
+    both = totals.get("tu.parse_and_extract")
+    extract = totals.get("tu.extract")
+    if both is not None and extract is not None:
+        print(f"\nclang frontend (parse_and_extract - extract): {(both - extract) / 1e6:.3f} ms")
+
+
+def main() -> int:
+    args = parse_args()
+    try:
+        names, stats = read_events(Path(args.log).read_bytes())
+    except (OSError, ValueError, struct.error) as error:
+        print(f"error: {error}", file=sys.stderr)
+        return 1
+
+    merged = merge_threads(stats)
+    print_table(names, stats if args.by_thread else merged)
+    print_frontend(names, merged)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
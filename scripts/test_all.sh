@@ -86,4 +86,144 @@ for case_name in "${CASES[@]}"; do
   "$ROOT_DIR/scripts/db_summary.py" "$db"
 done
 
+# Multi-TU extraction driven by a generated compile_commands.json
+MULTI_TU_DIR="$ROOT_DIR/tests/multi-tu"
+COMPDB="$OUT_DIR/compile_commands.json"
+db="$OUT_DIR/multi-tu.db"
+cat >"$COMPDB" <<EOF_COMPDB
+[
+  {"directory": "$MULTI_TU_DIR", "file": "main.cc", "arguments": ["clang++", "-std=c++20", "-c", "main.cc"]},
+  {"directory": "$MULTI_TU_DIR", "file": "util.cc", "arguments": ["clang++", "-std=c++20", "-c", "util.cc"]}
+]
+EOF_COMPDB
+
+rm -f "$db"
+echo "[test_all] Running multi-tu -> $db"
+"$ROOT_DIR/build/demo" \
+  -c "$ROOT_DIR/config.example.toml" \
+  -p "$COMPDB" \
+  -o "$db"
+
+if [[ ! -s "$db" ]]; then
+  echo "[test_all] Expected non-empty database was not created: $db" >&2
+  exit 1
+fi
+
+echo "[test_all] Summary for multi-tu"
+"$ROOT_DIR/scripts/db_summary.py" "$db"
+
+# colors.def is included with three COLOR definitions; header dedup must keep
+# the declarations of every inclusion
+python3 - "$db" <<'EOF_XMACRO'
+import sqlite3
+import sys
+
+conn = sqlite3.connect(sys.argv[1])
+missing = []
+for color in ("Red", "Green", "Blue"):
+    for name in (color + "Value", color + "Name"):
+        if not conn.execute("SELECT 1 FROM functions WHERE name = ?", (name,)).fetchone():
+            missing.append("function " + name)
+    if not conn.execute("SELECT 1 FROM enumconstants WHERE name = ?", (color,)).fetchone():
+        missing.append("enum constant " + color)
+if missing:
+    print("[test_all] X-macro declarations missing: " + ", ".join(missing), file=sys.stderr)
+    sys.exit(1)
+EOF_XMACRO
+
+count_rows() {
+  python3 - "$1" <<'EOF_COUNT'
+import sqlite3
+import sys
+
+conn = sqlite3.connect(sys.argv[1])
+tables = [row[0] for row in conn.execute(
+    "SELECT name FROM sqlite_master WHERE type = 'table' ORDER BY name")]
+for table in tables:
+    if table.startswith("compilation"):
+        continue
+    count = conn.execute('SELECT COUNT(*) FROM "%s"' % table).fetchone()[0]
+    print("%s %d" % (table, count))
+EOF_COUNT
+}
+
+# Parallel extraction of the same TUs must produce the same rows per table
+PAR_CONFIG="$OUT_DIR/parallel.toml"
+par_db="$OUT_DIR/multi-tu-parallel.db"
+sed 's/^jobs = 1$/jobs = 4/' "$ROOT_DIR/config.example.toml" >"$PAR_CONFIG"
+rm -f "$par_db"
+echo "[test_all] Running multi-tu with 4 jobs -> $par_db"
+"$ROOT_DIR/build/demo" -c "$PAR_CONFIG" -p "$COMPDB" -o "$par_db"
+serial="$(count_rows "$db")"
+parallel="$(count_rows "$par_db")"
+if [[ "$serial" != "$parallel" ]]; then
+  echo "[test_all] Row counts differ between 1 and 4 jobs:" >&2
+  diff <(echo "$serial") <(echo "$parallel") >&2 || true
+  exit 1
+fi
+
+# Incremental re-run: after one TU changes, only its rows are replaced, so every
+# table except the per-run compilation records keeps its row count
+INC_DIR="$OUT_DIR/incremental-src"
+INC_COMPDB="$OUT_DIR/incremental_commands.json"
+INC_CONFIG="$OUT_DIR/incremental.toml"
+db="$OUT_DIR/incremental.db"
+rm -rf "$INC_DIR" "$db"
+cp -r "$MULTI_TU_DIR" "$INC_DIR"
+sed "s|$MULTI_TU_DIR|$INC_DIR|g" "$COMPDB" >"$INC_COMPDB"
+sed 's/^incremental = false/incremental = true/' \
+  "$ROOT_DIR/config.example.toml" >"$INC_CONFIG"
+
+# One line per TU: main file name and a digest of the rows it wrote to every
+# table, including their IDs
+tu_snapshot() {
+  python3 - "$1" <<'EOF_TU'
+import hashlib
+import os
+import sqlite3
+import sys
+
+conn = sqlite3.connect(sys.argv[1])
+digests = {}
+for path, table, first, last in conn.execute(
+        "SELECT h.path, r.table_name, r.first, r.last FROM tu_row_ranges r "
+        "JOIN file_hashes h ON h.file = r.tu ORDER BY h.path, r.table_name"):
+    digest = digests.setdefault(os.path.basename(path), hashlib.sha1())
+    rows = conn.execute(
+        'SELECT * FROM "%s" WHERE rowid BETWEEN ? AND ?' % table,
+        (first, last)).fetchall()
+    for row in sorted(map(repr, rows)):
+        digest.update((table + row).encode())
+for name, digest in sorted(digests.items()):
+    print("%s %s" % (name, digest.hexdigest()))
+EOF_TU
+}
+
+echo "[test_all] Running incremental multi-tu -> $db"
+"$ROOT_DIR/build/demo" -c "$INC_CONFIG" -p "$INC_COMPDB" -o "$db"
+before="$(count_rows "$db")"
+before_tus="$(tu_snapshot "$db")"
+echo "// changed" >>"$INC_DIR/util.cc"
+"$ROOT_DIR/build/demo" -c "$INC_CONFIG" -p "$INC_COMPDB" -o "$db"
+after="$(count_rows "$db")"
+after_tus="$(tu_snapshot "$db")"
+if [[ "$before" != "$after" ]]; then
+  echo "[test_all] Row counts changed after re-extracting one TU:" >&2
+  diff <(echo "$before") <(echo "$after") >&2 || true
+  exit 1
+fi
+
+# Exactly util.cc is re-extracted: its rows get fresh IDs, while every row of
+# main.cc is kept unchanged
+main_before="$(grep '^main.cc ' <<<"$before_tus" || true)"
+main_after="$(grep '^main.cc ' <<<"$after_tus" || true)"
+util_before="$(grep '^util.cc ' <<<"$before_tus" || true)"
+util_after="$(grep '^util.cc ' <<<"$after_tus" || true)"
+if [[ -z "$main_before" || -z "$util_before" || -z "$util_after" ||
+      "$main_before" != "$main_after" || "$util_before" == "$util_after" ]]; then
+  echo "[test_all] Expected only util.cc to be re-extracted:" >&2
+  diff <(echo "$before_tus") <(echo "$after_tus") >&2 || true
+  exit 1
+fi
+
 echo "[test_all] All checks passed."
@@ -9,6 +9,8 @@
 // Template orchestration previously polluted this file and
 // caused architecture degradation.
 #include "core/ast_visitor.h"
+#include "core/focus_filter.h"
+#include "core/header_registry.h"
 #include "core/srcloc_recorder.h"
 #include "db/dependency_manager.h"
 #include "db/storage_facade.h"
@@ -22,6 +24,7 @@
 #include "util/key_generator/function.h"
 #include "util/key_generator/type.h"
 #include "util/key_generator/variable.h"
+#include "util/logger/perf_log.h"
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclCXX.h>
 #include <clang/AST/DeclFriend.h>
@@ -38,89 +41,201 @@
 #include <unordered_map>
 #include <unordered_set>
 
-ASTVisitor::ASTVisitor(clang::ASTContext *context)
+ASTVisitor::ASTVisitor(clang::ASTContext *context,
+                       const ExtractionConfig &extraction)
     : context_(context), pp_(context->getPrintingPolicy()) {
-  initProcessors();
+  initProcessors(extraction);
   pp_.SuppressScope = false;
   pp_.SuppressTagKeyword = true;
 }
 
-void ASTVisitor::initProcessors() {
+// 函数、变量、类型及说明符构成声明图的主干, 始终抽取; 其余表族按配置构造,
+// 未构造的处理器对应的 Visit 方法直接返回
+void ASTVisitor::initProcessors(const ExtractionConfig &extraction) {
   function_processor_ = std::make_unique<FunctionProcessor>(context_, pp_);
-  namespace_processor_ = std::make_unique<NamespaceProcessor>(context_, pp_);
   variable_processor_ = std::make_unique<VariableProcessor>(context_, pp_);
   type_processor_ = std::make_unique<TypeProcessor>(context_, pp_);
-  stmt_processor_ = std::make_unique<StmtProcessor>(context_, pp_);
-  expr_processor_ = std::make_unique<ExprProcessor>(context_, pp_, type_processor_.get());
   specifier_processor_ = std::make_unique<SpecifierProcessor>(context_, pp_);
-  template_processor_ = std::make_unique<TemplateProcessor>(
-      context_, pp_, type_processor_.get(), expr_processor_.get(),
-      variable_processor_.get());
-  inheritance_processor_ = std::make_unique<InheritanceProcessor>(
-      context_, pp_, type_processor_.get(), specifier_processor_.get());
-  record_layout_processor_ = std::make_unique<RecordLayoutProcessor>(
-      context_, pp_, type_processor_.get(), variable_processor_.get());
-  lambda_processor_ = std::make_unique<Lambda_Processor>(
-      context_, pp_, type_processor_.get(), variable_processor_.get());
+  if (extraction.has(ExtractionFamily::Namespaces))
+    namespace_processor_ = std::make_unique<NamespaceProcessor>(context_, pp_);
+  if (extraction.has(ExtractionFamily::Stmts))
+    stmt_processor_ = std::make_unique<StmtProcessor>(context_, pp_);
+  if (extraction.has(ExtractionFamily::Exprs))
+    expr_processor_ = std::make_unique<ExprProcessor>(context_, pp_,
+                                                      type_processor_.get());
+  if (extraction.has(ExtractionFamily::Templates))
+    template_processor_ = std::make_unique<TemplateProcessor>(
+        context_, pp_, type_processor_.get(), expr_processor_.get(),
+        variable_processor_.get());
+  if (extraction.has(ExtractionFamily::Inheritance)) {
+    inheritance_processor_ = std::make_unique<InheritanceProcessor>(
+        context_, pp_, type_processor_.get(), specifier_processor_.get());
+    record_layout_processor_ = std::make_unique<RecordLayoutProcessor>(
+        context_, pp_, type_processor_.get(), variable_processor_.get());
+  }
+  if (extraction.has(ExtractionFamily::Lambdas))
+    lambda_processor_ = std::make_unique<Lambda_Processor>(
+        context_, pp_, type_processor_.get(), variable_processor_.get());
+}
+
+// 头文件去重: 只决定遍历范围, 不做任何记录
+static bool isTemplateInstantiationDecl(const clang::Decl *decl) {
+  if (const auto *spec =
+          llvm::dyn_cast<clang::ClassTemplateSpecializationDecl>(decl))
+    return spec->getSpecializationKind() !=
+           clang::TSK_ExplicitSpecialization;
+  if (const auto *spec =
+          llvm::dyn_cast<clang::VarTemplateSpecializationDecl>(decl))
+    return spec->getSpecializationKind() !=
+           clang::TSK_ExplicitSpecialization;
+  if (const auto *function = llvm::dyn_cast<clang::FunctionDecl>(decl))
+    return clang::isTemplateInstantiation(
+        function->getTemplateSpecializationKind());
+  return false;
+}
+
+bool ASTVisitor::TraverseDecl(clang::Decl *decl) {
+  // 系统头文件中的声明(含其中模板的实例化)不再向下遍历
+  if (decl && FocusFilter::getInstance().isSkippedSystemDecl(
+                  decl, context_->getSourceManager()))
+    return true;
+  if (!decl || instantiation_depth_ > 0)
+    return Base::TraverseDecl(decl);
+  if (isTemplateInstantiationDecl(decl))
+    return traverseInstantiation(decl);
+  if (HeaderRegistry::getInstance().isExtractedElsewhere(
+          decl->getLocation(), context_->getSourceManager()))
+    return traverseExtractedDecl(decl);
+  return Base::TraverseDecl(decl);
+}
+
+bool ASTVisitor::traverseInstantiation(clang::Decl *decl) {
+  ++instantiation_depth_;
+  bool result = Base::TraverseDecl(decl);
+  --instantiation_depth_;
+  return result;
+}
+
+// 声明本身已由其他TU记录, 只需找出其中本TU特有的模板实例化
+bool ASTVisitor::traverseExtractedDecl(clang::Decl *decl) {
+  // 与 RecursiveASTVisitor 一致, 实例化只从模板的首个声明处遍历
+  if (auto *CTD = llvm::dyn_cast<clang::ClassTemplateDecl>(decl)) {
+    if (CTD != CTD->getCanonicalDecl())
+      return true;
+    for (auto *spec : CTD->specializations())
+      for (auto *redecl : spec->redecls()) {
+        auto kind = llvm::cast<clang::ClassTemplateSpecializationDecl>(redecl)
+                        ->getSpecializationKind();
+        if (kind == clang::TSK_Undeclared ||
+            kind == clang::TSK_ImplicitInstantiation)
+          if (!TraverseDecl(redecl))
+            return false;
+      }
+    return true;
+  }
+
+  if (auto *VTD = llvm::dyn_cast<clang::VarTemplateDecl>(decl)) {
+    if (VTD != VTD->getCanonicalDecl())
+      return true;
+    for (auto *spec : VTD->specializations())
+      for (auto *redecl : spec->redecls()) {
+        auto kind = llvm::cast<clang::VarTemplateSpecializationDecl>(redecl)
+                        ->getSpecializationKind();
+        if (kind == clang::TSK_Undeclared ||
+            kind == clang::TSK_ImplicitInstantiation)
+          if (!TraverseDecl(redecl))
+            return false;
+      }
+    return true;
+  }
+
+  if (auto *FTD = llvm::dyn_cast<clang::FunctionTemplateDecl>(decl)) {
+    if (FTD != FTD->getCanonicalDecl())
+      return true;
+    for (auto *spec : FTD->specializations())
+      if (spec->getTemplateSpecializationKind() !=
+          clang::TSK_ExplicitSpecialization)
+        if (!TraverseDecl(spec))
+          return false;
+    return true;
+  }
+
+  // 命名空间和类中可能嵌套成员模板, 继续向下查找; 其余声明直接跳过
+  if (llvm::isa<clang::NamespaceDecl, clang::LinkageSpecDecl,
+                clang::ExportDecl, clang::CXXRecordDecl>(decl))
+    for (auto *child : llvm::cast<clang::DeclContext>(decl)->decls())
+      if (!TraverseDecl(child))
+        return false;
+  return true;
 }
 
 // 实现各种Visit方法
 
 // Function Family
 bool ASTVisitor::VisitFunctionDecl(clang::FunctionDecl *decl) {
-  int func_id = function_processor_->routerProcess(decl);
+  PERF_ACCUMULATE("visit.function");
+  int64_t func_id = function_processor_->routerProcess(decl);
 
   // Process function specifiers
   if (func_id != -1)
     specifier_processor_->processFunctionSpecifiers(func_id, decl);
 
   // Process return type with qualifiers
-  int return_type_id =
+  int64_t return_type_id =
       type_processor_->processType(decl->getReturnType().getTypePtr());
   specifier_processor_->processTypeQualifiers(return_type_id,
                                               decl->getReturnType());
 
   for (const auto &param : decl->parameters()) {
-    int param_type_id =
+    int64_t param_type_id =
         type_processor_->processType(param->getType().getTypePtr());
     specifier_processor_->processTypeQualifiers(param_type_id,
                                                 param->getType());
   }
 
-  template_processor_->processFunctionTemplateSpecialization(decl, func_id);
+  if (template_processor_)
+    template_processor_->processFunctionTemplateSpecialization(decl, func_id);
 
   return true;
 }
 bool ASTVisitor::VisitCXXConstructorDecl(clang::CXXConstructorDecl *decl) {
+  PERF_ACCUMULATE("visit.function");
   function_processor_->processCXXConstructor(decl);
   return true;
 }
 bool ASTVisitor::VisitCXXDestructorDecl(clang::CXXDestructorDecl *decl) {
+  PERF_ACCUMULATE("visit.function");
   function_processor_->processCXXDestructor(decl);
   return true;
 }
 bool ASTVisitor::VisitCXXConversionDecl(clang::CXXConversionDecl *decl) {
+  PERF_ACCUMULATE("visit.function");
   function_processor_->processCXXConversion(decl);
   return true;
 }
 bool ASTVisitor::VisitCXXDeductionGuideDecl(
     clang::CXXDeductionGuideDecl *decl) {
+  PERF_ACCUMULATE("visit.function");
   function_processor_->processCXXDeductionGuide(decl);
   return true;
 }
 
 // Variable Family
 bool ASTVisitor::VisitVarDecl(clang::VarDecl *decl) {
-  int var_decl_id = variable_processor_->processVarDecl(decl);
+  PERF_ACCUMULATE("visit.variable");
+  int64_t var_decl_id = variable_processor_->processVarDecl(decl);
 
   // Process variable specifiers
   if (var_decl_id != -1)
     specifier_processor_->processVariableSpecifiers(var_decl_id, decl);
 
   // Process type with qualifiers
-  int type_id = type_processor_->processType(decl->getType().getTypePtr());
+  int64_t type_id = type_processor_->processType(decl->getType().getTypePtr());
   specifier_processor_->processTypeQualifiers(type_id, decl->getType());
 
+  if (!template_processor_)
+    return true;
+
   if (clang::TypeSourceInfo *typeInfo = decl->getTypeSourceInfo()) {
     auto templateTypeLoc = typeInfo->getTypeLoc()
                                .getAsAdjusted<clang::TemplateSpecializationTypeLoc>();
@@ -135,23 +250,25 @@ bool ASTVisitor::VisitVarDecl(clang::VarDecl *decl) {
 }
 
 bool ASTVisitor::VisitParmVarDecl(clang::ParmVarDecl *decl) {
-  int var_decl_id = variable_processor_->processParmVarDecl(decl);
+  PERF_ACCUMULATE("visit.variable");
+  int64_t var_decl_id = variable_processor_->processParmVarDecl(decl);
 
   // Process variable specifiers
   if (var_decl_id != -1)
     specifier_processor_->processVariableSpecifiers(var_decl_id, decl);
 
   // Process type with qualifiers
-  int type_id = type_processor_->processType(decl->getType().getTypePtr());
+  int64_t type_id = type_processor_->processType(decl->getType().getTypePtr());
   specifier_processor_->processTypeQualifiers(type_id, decl->getType());
   return true;
 }
 
 bool ASTVisitor::VisitFieldDecl(clang::FieldDecl *decl) {
+  PERF_ACCUMULATE("visit.variable");
   // Process type first to set _typeId in VariableProcessor
-  int type_id = type_processor_->processType(decl->getType().getTypePtr());
+  int64_t type_id = type_processor_->processType(decl->getType().getTypePtr());
 
-  int var_decl_id = variable_processor_->processFieldDecl(decl);
+  int64_t var_decl_id = variable_processor_->processFieldDecl(decl);
 
   // Process variable specifiers
   if (var_decl_id != -1)
@@ -163,43 +280,51 @@ bool ASTVisitor::VisitFieldDecl(clang::FieldDecl *decl) {
 
 // Type Family
 bool ASTVisitor::VisitRecordDecl(clang::RecordDecl *decl) {
+  PERF_ACCUMULATE("visit.type");
   type_processor_->processRecordDecl(decl);
   return true;
 }
 
 bool ASTVisitor::VisitRecordType(clang::RecordType *RT) {
+  PERF_ACCUMULATE("visit.type");
   type_processor_->processRecordType(RT);
   return true;
 }
 
 bool ASTVisitor::VisitEnumDecl(clang::EnumDecl *decl) {
+  PERF_ACCUMULATE("visit.type");
   type_processor_->processEnumDecl(decl);
   return true;
 }
 
 bool ASTVisitor::VisitTypedefDecl(clang::TypedefDecl *decl) {
+  PERF_ACCUMULATE("visit.type");
   type_processor_->processTypedefDecl(decl);
   return true;
 }
 
 bool ASTVisitor::VisitTemplateTypeParmDecl(clang::TemplateTypeParmDecl *decl) {
+  PERF_ACCUMULATE("visit.type");
   type_processor_->processTemplateTypeParmDecl(decl);
-  template_processor_->recordTemplateTypeConstraint(decl);
+  if (template_processor_)
+    template_processor_->recordTemplateTypeConstraint(decl);
   return true;
 }
 
 bool ASTVisitor::VisitTemplateTemplateParmDecl(
     clang::TemplateTemplateParmDecl *decl) {
+  PERF_ACCUMULATE("visit.type");
   type_processor_->processTemplateTemplateParmDecl(decl);
   return true;
 }
 
 bool ASTVisitor::VisitNonTypeTemplateParmDecl(
     clang::NonTypeTemplateParmDecl *decl) {
-  if (!decl)
+  PERF_ACCUMULATE("visit.type");
+  if (!decl || !expr_processor_ || !template_processor_)
     return true;
 
-  int exprId = expr_processor_->processNonTypeTemplateParmDecl(decl);
+  int64_t exprId = expr_processor_->processNonTypeTemplateParmDecl(decl);
   if (exprId == -1)
     return true;
 
@@ -212,9 +337,13 @@ bool ASTVisitor::VisitNonTypeTemplateParmDecl(
 }
 
 bool ASTVisitor::VisitCXXRecordDecl(clang::CXXRecordDecl *decl) {
+  PERF_ACCUMULATE("visit.type");
   if (!decl)
     return true;
 
+  if (!inheritance_processor_)
+    return true;
+
   // IMPORTANT: hierarchy extraction must run before layout extraction because
   // RecordLayoutProcessor depends on derivation cache population.
   inheritance_processor_->processCXXRecordDecl(decl);
@@ -223,12 +352,14 @@ bool ASTVisitor::VisitCXXRecordDecl(clang::CXXRecordDecl *decl) {
 }
 
 bool ASTVisitor::VisitBuiltinType(clang::BuiltinType *BT) {
+  PERF_ACCUMULATE("visit.type");
   type_processor_->processBuiltinType(BT, context_);
   return true;
 }
 
 bool ASTVisitor::VisitImplicitCastExpr(clang::ImplicitCastExpr *ICE) {
-  if (!ICE || !ICE->getSubExpr())
+  PERF_ACCUMULATE("visit.type");
+  if (!ICE || !ICE->getSubExpr() || !expr_processor_)
     return true;
 
   expr_processor_->processImplicitCastExpr(ICE);
@@ -236,67 +367,100 @@ bool ASTVisitor::VisitImplicitCastExpr(clang::ImplicitCastExpr *ICE) {
   const clang::QualType sourceType = ICE->getSubExpr()->getType();
   const clang::QualType targetType = ICE->getType();
 
-  int source_type_id = type_processor_->processType(sourceType.getTypePtr());
+  int64_t source_type_id =
+      type_processor_->processType(sourceType.getTypePtr());
   specifier_processor_->processTypeQualifiers(source_type_id, sourceType);
 
-  int target_type_id = type_processor_->processType(targetType.getTypePtr());
+  int64_t target_type_id =
+      type_processor_->processType(targetType.getTypePtr());
   specifier_processor_->processTypeQualifiers(target_type_id, targetType);
   return true;
 }
 
 // Stmt Family
 bool ASTVisitor::VisitIfStmt(clang::IfStmt *ifStmt) {
+  PERF_ACCUMULATE("visit.stmt");
+  if (!stmt_processor_)
+    return true;
   stmt_processor_->processIfStmt(ifStmt);
   return true;
 }
 
 bool ASTVisitor::VisitForStmt(clang::ForStmt *forStmt) {
+  PERF_ACCUMULATE("visit.stmt");
+  if (!stmt_processor_)
+    return true;
   stmt_processor_->processForStmt(forStmt);
   return true;
 }
 
 bool ASTVisitor::VisitCXXForRangeStmt(clang::CXXForRangeStmt *rangeForStmt) {
+  PERF_ACCUMULATE("visit.stmt");
+  if (!stmt_processor_)
+    return true;
   stmt_processor_->processCXXForRangeStmt(rangeForStmt);
   return true;
 }
 
 bool ASTVisitor::VisitWhileStmt(clang::WhileStmt *whileStmt) {
+  PERF_ACCUMULATE("visit.stmt");
+  if (!stmt_processor_)
+    return true;
   stmt_processor_->processWhileStmt(whileStmt);
   return true;
 }
 
 bool ASTVisitor::VisitDoStmt(clang::DoStmt *doStmt) {
+  PERF_ACCUMULATE("visit.stmt");
+  if (!stmt_processor_)
+    return true;
   stmt_processor_->processDoStmt(doStmt);
   return true;
 }
 
 bool ASTVisitor::VisitSwitchStmt(clang::SwitchStmt *switchStmt) {
+  PERF_ACCUMULATE("visit.stmt");
+  if (!stmt_processor_)
+    return true;
   stmt_processor_->processSwitchStmt(switchStmt);
   return true;
 }
 
 bool ASTVisitor::VisitReturnStmt(clang::ReturnStmt *returnStmt) {
+  PERF_ACCUMULATE("visit.stmt");
+  if (!stmt_processor_)
+    return true;
   stmt_processor_->processReturnStmt(returnStmt);
   return true;
 }
 
 bool ASTVisitor::VisitDeclStmt(clang::DeclStmt *declStmt) {
+  PERF_ACCUMULATE("visit.stmt");
+  if (!stmt_processor_)
+    return true;
   stmt_processor_->processDeclStmt(declStmt);
   return true;
 }
 
 bool ASTVisitor::VisitCompoundStmt(clang::CompoundStmt *compoundStmt) {
+  PERF_ACCUMULATE("visit.stmt");
+  if (!stmt_processor_)
+    return true;
   stmt_processor_->processBlockStmt(compoundStmt);
   return true;
 }
 
 bool ASTVisitor::VisitFriendDecl(clang::FriendDecl *decl) {
-  template_processor_->processFriendDecl(decl);
+  PERF_ACCUMULATE("visit.type");
+  if (template_processor_)
+    template_processor_->processFriendDecl(decl);
   return true;
 }
 
 bool ASTVisitor::VisitConceptDecl(clang::ConceptDecl *decl) {
-  template_processor_->resolveConceptTemplateId(decl, context_);
+  PERF_ACCUMULATE("visit.concept");
+  if (template_processor_)
+    template_processor_->resolveConceptTemplateId(decl, context_);
   return true;
 }
 
@@ -305,7 +469,8 @@ bool ASTVisitor::VisitConceptDecl(clang::ConceptDecl *decl) {
 bool ASTVisitor::VisitTemplateDecl(clang::TemplateDecl *) { return true; }
 
 bool ASTVisitor::VisitClassTemplateDecl(clang::ClassTemplateDecl *decl) {
-  if (!decl)
+  PERF_ACCUMULATE("visit.template");
+  if (!decl || !template_processor_)
     return true;
 
   const clang::CXXRecordDecl *templatedDecl = decl->getTemplatedDecl();
@@ -320,12 +485,10 @@ bool ASTVisitor::VisitClassTemplateDecl(clang::ClassTemplateDecl *decl) {
     DbModel::IsClassTemplate isClassTemplate = {*cachedId};
     STG.insertClassObj(isClassTemplate);
   } else {
-    PendingUpdate update{
-        typeKey, CacheType::TYPE, [](int resolvedId) {
-          DbModel::IsClassTemplate isClassTemplate = {resolvedId};
-          STG.insertClassObj(isClassTemplate);
-        }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        typeKey, CacheType::TYPE,
+        DbModel::IsClassTemplate{-1},
+        &DbModel::IsClassTemplate::id);
   }
 
   return true;
@@ -333,43 +496,45 @@ bool ASTVisitor::VisitClassTemplateDecl(clang::ClassTemplateDecl *decl) {
 
 bool ASTVisitor::VisitClassTemplateSpecializationDecl(
     clang::ClassTemplateSpecializationDecl *decl) {
-  template_processor_->processClassTemplateSpecialization(decl);
+  PERF_ACCUMULATE("visit.template");
+  if (template_processor_)
+    template_processor_->processClassTemplateSpecialization(decl);
   return true;
 }
 
 bool ASTVisitor::VisitFunctionTemplateDecl(clang::FunctionTemplateDecl *decl) {
-  if (!decl)
+  PERF_ACCUMULATE("visit.template");
+  if (!decl || !template_processor_)
     return true;
 
   const clang::FunctionDecl *templatedDecl = decl->getTemplatedDecl();
   if (!templatedDecl)
     return true;
 
-  KeyType functionKey = KeyGen::Function::makeKey(templatedDecl, context_);
-  if (auto cachedId = SEARCH_FUNCTION_CACHE(functionKey)) {
+  if (auto cachedId = KeyGen::Function::findId(templatedDecl, context_)) {
     DbModel::IsFunctionTemplate isFunctionTemplate = {*cachedId};
     STG.insertClassObj(isFunctionTemplate);
   } else {
-    PendingUpdate update{
-        functionKey, CacheType::FUNCTION, [](int resolvedId) {
-          DbModel::IsFunctionTemplate isFunctionTemplate = {resolvedId};
-          STG.insertClassObj(isFunctionTemplate);
-        }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        KeyGen::Function::makeKey(templatedDecl, context_), CacheType::FUNCTION,
+        DbModel::IsFunctionTemplate{-1},
+        &DbModel::IsFunctionTemplate::id);
   }
 
   return true;
 }
 
 bool ASTVisitor::VisitVarTemplateDecl(clang::VarTemplateDecl *decl) {
-  if (!decl)
+  PERF_ACCUMULATE("visit.template");
+  if (!decl || !template_processor_)
     return true;
 
   clang::VarDecl *templatedDecl = decl->getTemplatedDecl();
   if (!templatedDecl)
     return true;
 
-  int variableId = template_processor_->resolveVariableEntityId(templatedDecl);
+  int64_t variableId =
+      template_processor_->resolveVariableEntityId(templatedDecl);
   if (variableId == -1 ||
       !template_processor_->shouldInsertVariableTemplate(variableId))
     return true;
@@ -380,16 +545,17 @@ bool ASTVisitor::VisitVarTemplateDecl(clang::VarTemplateDecl *decl) {
 }
 
 bool ASTVisitor::VisitDeclRefExpr(clang::DeclRefExpr *expr) {
-  if (!expr)
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr || !expr_processor_)
     return true;
 
   expr_processor_->processDeclRef(expr);
 
-  if (expr->hasExplicitTemplateArgs()) {
+  if (expr->hasExplicitTemplateArgs() && template_processor_) {
     if (const auto *functionDecl =
             llvm::dyn_cast<clang::FunctionDecl>(expr->getDecl())) {
-      KeyType functionKey = KeyGen::Function::makeKey(functionDecl, context_);
-      int functionId = SEARCH_FUNCTION_CACHE(functionKey).value_or(-1);
+      int64_t functionId =
+          KeyGen::Function::findId(functionDecl, context_).value_or(-1);
       template_processor_->recordFunctionTemplateArgumentValues(
           functionId, expr->getTemplateArgs(), expr->getNumTemplateArgs());
     }
@@ -399,93 +565,146 @@ bool ASTVisitor::VisitDeclRefExpr(clang::DeclRefExpr *expr) {
 }
 
 bool ASTVisitor::VisitCallExpr(CallExpr *expr) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processCallExpr(expr);
   return true;
 }
 
 bool ASTVisitor::VisitUnaryOperator(const UnaryOperator *op) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processUnaryOperator(op);
   return true;
 }
 
 bool ASTVisitor::VisitBinaryOperator(const BinaryOperator *op) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processBinaryOperator(op);
   return true;
 }
 
 bool ASTVisitor::VisitConditionalOperator(const ConditionalOperator *op) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processConditionalOperator(op);
   return true;
 }
 
 bool ASTVisitor::VisitStringLiteral(const StringLiteral *literal) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processStringLiteral(literal);
   return true;
 }
 
 bool ASTVisitor::VisitIntegerLiteral(const IntegerLiteral *literal) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processIntegerLiteral(literal);
   return true;
 }
 
 bool ASTVisitor::VisitFloatingLiteral(const FloatingLiteral *literal) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processFloatingLiteral(literal);
   return true;
 }
 
 bool ASTVisitor::VisitCharacterLiteral(const CharacterLiteral *literal) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processCharacterLiteral(literal);
   return true;
 }
 
 bool ASTVisitor::VisitCXXBoolLiteralExpr(const CXXBoolLiteralExpr *literal) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processBoolLiteral(literal);
   return true;
 }
 
 bool ASTVisitor::VisitNamespaceDecl(clang::NamespaceDecl *decl) {
+  PERF_ACCUMULATE("visit.namespace");
+  if (!namespace_processor_)
+    return true;
   namespace_processor_->processNamespaceDecl(decl);
   return true;
 }
 
 bool ASTVisitor::VisitUsingDecl(clang::UsingDecl *decl) {
+  PERF_ACCUMULATE("visit.namespace");
+  if (!namespace_processor_)
+    return true;
   namespace_processor_->processUsingDecl(decl);
   return true;
 }
 
 bool ASTVisitor::VisitUsingDirectiveDecl(clang::UsingDirectiveDecl *decl) {
+  PERF_ACCUMULATE("visit.namespace");
+  if (!namespace_processor_)
+    return true;
   namespace_processor_->processUsingDirectiveDecl(decl);
   return true;
 }
 
 bool ASTVisitor::VisitUnresolvedUsingTypenameDecl(
     clang::UnresolvedUsingTypenameDecl *decl) {
+  PERF_ACCUMULATE("visit.namespace");
+  if (!namespace_processor_)
+    return true;
   namespace_processor_->processUnresolvedUsingTypenameDecl(decl);
   return true;
 }
 
 bool ASTVisitor::VisitArraySubscriptExpr(clang::ArraySubscriptExpr *expr) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processArraySubscriptExpr(expr);
   return true;
 }
 
 bool ASTVisitor::VisitInitListExpr(clang::InitListExpr *expr) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processInitListExpr(expr);
   return true;
 }
 
 bool ASTVisitor::VisitUnaryExprOrTypeTraitExpr(clang::UnaryExprOrTypeTraitExpr *expr) {
+  PERF_ACCUMULATE("visit.expr");
+  if (!expr_processor_)
+    return true;
   expr_processor_->processUnaryExprOrTypeTraitExpr(expr);
   return true;
 }
 
 bool ASTVisitor::VisitConceptSpecializationExpr(
     clang::ConceptSpecializationExpr *expr) {
-  template_processor_->processConceptSpecialization(expr);
+  PERF_ACCUMULATE("visit.concept");
+  if (template_processor_)
+    template_processor_->processConceptSpecialization(expr);
   return true;
 }
 
 bool ASTVisitor::VisitLambdaExpr(clang::LambdaExpr *expr) {
+  PERF_ACCUMULATE("visit.lambda");
+  if (!lambda_processor_)
+    return true;
   lambda_processor_->processLambdaExpr(expr);
   return true;
 }
@@ -1,9 +1,17 @@
 #include "core/clang_ast_manager.h"
+#include "core/focus_filter.h"
+#include "core/header_registry.h"
 #include "core/processor/preprocessor_processor.h"
+#include "core/srcloc_recorder.h"
+#include "util/key_generator/node_cache.h"
 #include "util/logger/macros.h"
+#include "util/logger/perf_log.h"
 #include <clang/Frontend/FrontendActions.h>
 #include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/JSONCompilationDatabase.h>
 #include <clang/Tooling/Tooling.h>
+#include <filesystem>
+#include <llvm/Support/VirtualFileSystem.h>
 #include <memory>
 
 // 创建自定义的clang组件
@@ -17,6 +25,12 @@ public:
     callback(Context); // FIXME: ?
   }
 
+  // 仅在开启 SkipFunctionBodies 时由解析器调用, 关注范围外的函数体不解析
+  bool shouldSkipFunctionBody(clang::Decl *D) override {
+    return !FocusFilter::getInstance().isInFocus(D->getLocation(),
+                                                 context.getSourceManager());
+  }
+
 private:
   std::function<void(clang::ASTContext &)> callback;
   clang::ASTContext &context;
@@ -24,39 +38,64 @@ private:
 
 class CustomASTAction : public clang::ASTFrontendAction {
 public:
-  CustomASTAction(std::function<void(clang::ASTContext &)> cb)
-      : callback(std::move(cb)) {}
+  CustomASTAction(std::function<void(clang::ASTContext &)> cb,
+                  bool preprocessor)
+      : callback(std::move(cb)), preprocessor(preprocessor) {}
 
   std::unique_ptr<clang::ASTConsumer>
   CreateASTConsumer(clang::CompilerInstance &CI,
                     llvm::StringRef InFile) override {
+    // 预处理开始前切换到新TU的 FileID 缓存
+    SrcLocRecorder::enterTranslationUnit();
+    NodeCache::enterTranslationUnit();
+    HeaderRegistry::getInstance().enterTranslationUnit(
+        CI.getPreprocessor().getPredefines());
+    FocusFilter &focus = FocusFilter::getInstance();
+    focus.enterTranslationUnit();
+    // 解析在创建 ASTConsumer 之后才开始, 此时设置仍然生效
+    if (focus.hasFocus())
+      CI.getFrontendOpts().SkipFunctionBodies = true;
+
     // Install PPCallbacks for preprocessor directive tracking
     auto &PP = CI.getPreprocessor();
-    PP.addPPCallbacks(std::make_unique<PreprocessorProcessor>(
-        &CI.getASTContext(),
-        CI.getASTContext().getPrintingPolicy(),
-        &PP));
+    HeaderRegistry &headers = HeaderRegistry::getInstance();
+    if (headers.isEnabled())
+      PP.addPPCallbacks(headers.createMacroTracker(PP));
+    if (preprocessor)
+      PP.addPPCallbacks(std::make_unique<PreprocessorProcessor>(
+          &CI.getASTContext(),
+          CI.getASTContext().getPrintingPolicy(),
+          &PP));
 
     return std::make_unique<CustomASTConsumer>(callback, CI.getASTContext());
   }
 
+  // clang 解析与抽取的总耗时, 扣除 tu.extract 即为前端解析本身
+  void ExecuteAction() override {
+    PERF_SPAN("tu.parse_and_extract");
+    clang::ASTFrontendAction::ExecuteAction();
+  }
+
 private:
   std::function<void(clang::ASTContext &)> callback;
+  bool preprocessor; // 是否记录预处理指令
 };
 
 struct CustomFrontendActionFactory
     : public clang::tooling::FrontendActionFactory {
-  explicit CustomFrontendActionFactory(
-      std::function<void(clang::ASTContext &)> cb)
-      : clang::tooling::FrontendActionFactory(), callback(cb) {}
+  CustomFrontendActionFactory(std::function<void(clang::ASTContext &)> cb,
+                              bool preprocessor)
+      : clang::tooling::FrontendActionFactory(), callback(cb),
+        preprocessor(preprocessor) {}
   std::unique_ptr<clang::FrontendAction> create() override {
-    auto *action =
-        dynamic_cast<clang::FrontendAction *>(new CustomASTAction(callback));
+    auto *action = dynamic_cast<clang::FrontendAction *>(
+        new CustomASTAction(callback, preprocessor));
     return std::unique_ptr<clang::FrontendAction>(action);
   }
 
 private:
   std::function<void(clang::ASTContext &)> callback;
+  bool preprocessor;
 };
 
 ///////////////////////////////////////////////////////////
@@ -64,16 +103,36 @@ private:
 ClangASTManager::ClangASTManager() {}
 
 bool ClangASTManager::loadConfig(const Configuration &config) {
+  PERF_SPAN("frontend.load_config");
   // 根据配置文件设置相应的成员变量
   sourcePath = config.general.source_path;
   includePaths = config.compilation.include_paths;
   defines = config.compilation.defines;
   cxxStandard = config.compilation.cxx_standard;
   flags = config.compilation.flags;
+  compileCommandsPath = config.compilation.compile_commands;
+  pchCache.configure(config);
+  extractPreprocessor =
+      config.extraction.has(ExtractionFamily::Preprocessor);
+
+  sourceFilters.clear();
+  for (const auto &filter : config.compilation.source_filters) {
+    auto pattern = llvm::GlobPattern::create(filter);
+    if (!pattern) {
+      LOG_WARNING << "Ignore invalid source filter '" << filter
+                  << "': " << llvm::toString(pattern.takeError())
+                  << std::endl;
+      continue;
+    }
+    sourceFilters.push_back(std::move(*pattern));
+  }
 
   // 转换命令行参数
   args = convertToCommandLineArgs();
 
+  if (!loadCompilationDatabase())
+    return false;
+
   LOG_INFO << "ClangASTManager configuration loaded" << std::endl;
   return true;
 }
@@ -84,38 +143,127 @@ const std::vector<std::string> &ClangASTManager::getCommandLineArgs() const {
   return args;
 }
 
-bool ClangASTManager::processAST(
-    const std::string &source_path,
-    std::function<void(clang::ASTContext &)> callback) {
-  // 使用Clang的Tooling功能创建编译数据库
-  int argc = args.size();
-  std::vector<const char *> argv;
-
-  // 转换参数为C风格字符串数组
-  for (const auto &arg : args)
-    argv.push_back(arg.c_str());
-
-  // 创建编译数据库
+bool ClangASTManager::loadCompilationDatabase() {
   std::string errorMsg;
-  std::unique_ptr<clang::tooling::FixedCompilationDatabase> compdbPtr =
-      clang::tooling::FixedCompilationDatabase::loadFromCommandLine(
-          argc, argv.data(), errorMsg);
+
+  if (compileCommandsPath.empty()) {
+    // 使用Clang的Tooling功能, 由固定参数创建编译数据库
+    int argc = args.size();
+    std::vector<const char *> argv;
+
+    // 转换参数为C风格字符串数组
+    for (const auto &arg : args)
+      argv.push_back(arg.c_str());
+
+    compileDatabase =
+        clang::tooling::FixedCompilationDatabase::loadFromCommandLine(
+            argc, argv.data(), errorMsg);
+  } else if (std::filesystem::is_directory(compileCommandsPath)) {
+    compileDatabase = clang::tooling::CompilationDatabase::loadFromDirectory(
+        compileCommandsPath, errorMsg);
+  } else {
+    compileDatabase = clang::tooling::JSONCompilationDatabase::loadFromFile(
+        compileCommandsPath, errorMsg,
+        clang::tooling::JSONCommandLineSyntax::AutoDetect);
+  }
 
   if (!errorMsg.empty())
     LOG_DEBUG << "Compilation database message: " << errorMsg << std::endl;
 
-  if (!compdbPtr) {
+  if (!compileDatabase) {
     LOG_ERROR << "Failed to create compilation database: " << errorMsg
               << std::endl;
     return false;
   }
-  clang::tooling::ClangTool tool(*compdbPtr, {source_path});
+
+  if (!compileCommandsPath.empty())
+    LOG_INFO << "Compilation database loaded: " << compileCommandsPath
+             << std::endl;
+  return true;
+}
+
+std::vector<std::string>
+ClangASTManager::collectSourcePaths(const std::string &source_path) const {
+  PERF_SPAN("frontend.collect_sources");
+  if (compileCommandsPath.empty())
+    return {source_path};
+
+  // source_path 为文件时只处理该TU, 为目录时处理其下的全部TU
+  std::string target;
+  if (!source_path.empty()) {
+    target =
+        std::filesystem::absolute(source_path).lexically_normal().string();
+    while (target.size() > 1 && target.back() == '/')
+      target.pop_back();
+  }
+
+  std::vector<std::string> allFiles = compileDatabase->getAllFiles();
+  std::vector<std::string> sources;
+  for (const auto &file : allFiles) {
+    std::string normalized =
+        std::filesystem::path(file).lexically_normal().string();
+    if (!target.empty() && normalized != target &&
+        normalized.rfind(target + "/", 0) != 0)
+      continue;
+    if (!matchesSourceFilters(normalized))
+      continue;
+    sources.push_back(file);
+  }
+
+  LOG_INFO << "Selected " << sources.size() << " of " << allFiles.size()
+           << " compilation database entries" << std::endl;
+  return sources;
+}
+
+bool ClangASTManager::matchesSourceFilters(const std::string &file) const {
+  if (sourceFilters.empty())
+    return true;
+
+  for (const auto &pattern : sourceFilters)
+    if (pattern.match(file))
+      return true;
+  return false;
+}
+
+bool ClangASTManager::processAST(
+    const std::vector<std::string> &source_paths,
+    std::function<void(clang::ASTContext &)> callback) {
+  if (!compileDatabase) {
+    LOG_ERROR << "Compilation database is not loaded" << std::endl;
+    return false;
+  }
+
+  if (source_paths.empty()) {
+    LOG_WARNING << "No source file selected for extraction" << std::endl;
+    return true;
+  }
+
+  // ClangTool 依次解析每个TU, 每个TU拥有独立的 ASTContext
+  // 使用独立工作目录的物理文件系统, 避免并行解析时 chdir 影响整个进程
+  clang::tooling::ClangTool tool(
+      *compileDatabase, source_paths,
+      std::make_shared<clang::PCHContainerOperations>(),
+      llvm::vfs::createPhysicalFileSystem());
+
+  // 沿用或生成预编译头, 相对路径按编译命令的工作目录解析
+  tool.appendArgumentsAdjuster(
+      [this](const clang::tooling::CommandLineArguments &commandLine,
+             llvm::StringRef file) {
+        std::string directory;
+        auto commands = compileDatabase->getCompileCommands(file);
+        if (!commands.empty())
+          directory = commands.front().Directory;
+        return pchCache.adjust(commandLine, file.str(), directory);
+      });
 
   // 运行工具并处理AST
-  int result = tool.run(new CustomFrontendActionFactory(callback));
+  CustomFrontendActionFactory factory(callback, extractPreprocessor);
+  int result = tool.run(&factory);
 
   if (result != 0) {
-    LOG_ERROR << "Failed to process AST for: " << source_path << std::endl;
+    // 单个TU失败不会中断其余TU的解析
+    LOG_ERROR << "Failed to process AST for some of the " << source_paths.size()
+              << " source file(s)" << std::endl;
     return false;
   }
 
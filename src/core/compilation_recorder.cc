@@ -3,10 +3,17 @@
 #include "model/db/compilation.h"
 #include "model/db/container.h"
 #include "util/id_generator.h"
+#include "util/logger/macros.h"
+#include "util/processor_metrics.h"
+#include <clang/Basic/SourceManager.h>
+#include <filesystem>
 
 using namespace DbModel;
 
-int CompRecorder::createCompilation(const std::string &working_directory) {
+thread_local int64_t CompRecorder::current_source_file_id_ = -1;
+
+int64_t
+CompRecorder::createCompilation(const std::string &working_directory) {
   Compilation comp_model = {GENID(Compilation), working_directory};
   STG.insertClassObj(comp_model);
   return compilation_id_ = comp_model.id;
@@ -26,17 +33,85 @@ void CompRecorder::recordTime(CompTimeKind kind, double seconds) {
   STG.insertClassObj(comp_time);
 }
 
-int CompRecorder::recordFile(const std::string &file) {
+void CompRecorder::recordProcessorMetrics() {
+  ProcessorMetrics &metrics = ProcessorMetrics::getInstance();
+  for (size_t i = 0; i < static_cast<size_t>(ProcessorKind::Count); ++i) {
+    const auto kind = static_cast<ProcessorKind>(i);
+    const ProcessorCounters counters = metrics.total(kind);
+    CompilationMetric metric = {compilation_id_,
+                                ProcessorMetrics::name(kind),
+                                static_cast<int64_t>(counters.nodes),
+                                static_cast<int64_t>(counters.rows),
+                                static_cast<int64_t>(counters.cache_hits),
+                                static_cast<int64_t>(counters.cache_misses),
+                                counters.time_ns / 1e9};
+    STG.insertClassObj(metric);
+  }
+}
+
+int64_t CompRecorder::insertFile(const std::string &normalized_path) {
+  std::string file =
+      std::filesystem::path(normalized_path).filename().string();
   File file_model = {GENID(File), file};
   Container container_model = {GENID(Container), file_model.id,
                                static_cast<int>(ContainerType::File)};
   STG.insertClassObj(file_model);
   STG.insertClassObj(container_model);
-  source_file_id_ = file_model.id;
-  return source_file_id_;
+  source_file_ids_[normalized_path] = file_model.id;
+  return file_model.id;
+}
+
+int64_t CompRecorder::recordFile(const std::string &path) {
+  std::lock_guard<std::mutex> lock(files_mutex_);
+  std::string normalized_path = normalizePath(path);
+  auto it = source_file_ids_.find(normalized_path);
+  if (it != source_file_ids_.end())
+    return source_file_id_ = it->second;
+  return source_file_id_ = insertFile(normalized_path);
+}
+
+void CompRecorder::registerFile(const std::string &path, int64_t id) {
+  std::lock_guard<std::mutex> lock(files_mutex_);
+  source_file_ids_[normalizePath(path)] = id;
+}
+
+int64_t CompRecorder::resolveFile(const std::string &path) {
+  std::lock_guard<std::mutex> lock(files_mutex_);
+  std::string normalized_path = normalizePath(path);
+  auto it = source_file_ids_.find(normalized_path);
+  if (it != source_file_ids_.end())
+    return it->second;
+  return insertFile(normalized_path);
+}
+
+void CompRecorder::enterSourceFile(const std::string &path) {
+  std::lock_guard<std::mutex> lock(files_mutex_);
+  auto it = source_file_ids_.find(normalizePath(path));
+  if (it == source_file_ids_.end()) {
+    LOG_WARNING << "Source file was not recorded before parsing: " << path
+                << std::endl;
+    return;
+  }
+  current_source_file_id_ = it->second;
+}
+
+std::string CompRecorder::normalizePath(const std::string &path) {
+  return std::filesystem::absolute(path).lexically_normal().string();
+}
+
+std::string
+CompRecorder::entryPath(clang::FileEntryRef entry,
+                        const clang::SourceManager &sourceManager) {
+  // ClangTool 将虚拟文件系统的工作目录设为编译命令的 directory,
+  // 进程当前目录与之无关; 不解析符号链接, 与 recordFile 的记录保持一致
+  llvm::SmallString<256> path(entry.getName());
+  sourceManager.getFileManager().makeAbsolutePath(path);
+  return normalizePath(path.str().str());
 }
 
-std::optional<int> CompRecorder::getSourceFileId() const {
+std::optional<int64_t> CompRecorder::getSourceFileId() const {
+  if (current_source_file_id_ >= 0)
+    return current_source_file_id_;
   if (source_file_id_ < 0) {
     return std::nullopt;
   }
@@ -47,4 +122,5 @@ void CompRecorder::finalize(double total_cpu, double total_elapsed) {
   CompilationFinished finshed_model = {GENID(CompilationFinished), total_cpu,
                                        total_elapsed};
   STG.insertClassObj(finshed_model);
+  STG.finalizeSchema();
 }
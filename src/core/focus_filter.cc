@@ -0,0 +1,64 @@
+#include "core/focus_filter.h"
+#include "util/logger/macros.h"
+#include <clang/AST/DeclBase.h>
+#include <clang/Basic/SourceManager.h>
+#include <filesystem>
+
+thread_local llvm::DenseMap<clang::FileID, bool> FocusFilter::focused_files_;
+
+void FocusFilter::configure(const CompilationConfig &config) {
+  skip_system_headers_ = config.skip_system_headers;
+  patterns_.clear();
+  for (const auto &path : config.focus_paths) {
+    auto pattern = llvm::GlobPattern::create(path);
+    if (!pattern) {
+      LOG_WARNING << "Ignore invalid focus path '" << path
+                  << "': " << llvm::toString(pattern.takeError())
+                  << std::endl;
+      continue;
+    }
+    patterns_.push_back(std::move(*pattern));
+  }
+}
+
+void FocusFilter::enterTranslationUnit() { focused_files_.clear(); }
+
+bool FocusFilter::isInFocus(clang::SourceLocation loc,
+                            const clang::SourceManager &sourceManager) {
+  if (patterns_.empty() || loc.isInvalid())
+    return true;
+
+  const clang::FileID fileID =
+      sourceManager.getFileID(sourceManager.getExpansionLoc(loc));
+  if (fileID == sourceManager.getMainFileID())
+    return true;
+
+  auto [it, inserted] = focused_files_.try_emplace(fileID, true);
+  if (!inserted)
+    return it->second;
+
+  auto fileEntry = sourceManager.getFileEntryRefForID(fileID);
+  if (!fileEntry)
+    return true;
+
+  // 与 source_filters 一致, 按规范化后的绝对路径匹配
+  llvm::StringRef name = fileEntry->getFileEntry().tryGetRealPathName();
+  if (name.empty())
+    name = fileEntry->getName();
+  std::string path =
+      std::filesystem::absolute(name.str()).lexically_normal().string();
+
+  it->second = false;
+  for (const auto &pattern : patterns_)
+    if (pattern.match(path)) {
+      it->second = true;
+      break;
+    }
+  return it->second;
+}
+
+bool FocusFilter::isSkippedSystemDecl(
+    const clang::Decl *decl, const clang::SourceManager &sourceManager) const {
+  return skip_system_headers_ && decl->getLocation().isValid() &&
+         sourceManager.isInSystemHeader(decl->getLocation());
+}
@@ -0,0 +1,134 @@
+#include "core/header_registry.h"
+#include <clang/Basic/SourceManager.h>
+#include <clang/Lex/MacroInfo.h>
+#include <clang/Lex/PPCallbacks.h>
+#include <clang/Lex/Preprocessor.h>
+
+thread_local std::uint64_t HeaderRegistry::tu_ = 0;
+thread_local Fingerprint HeaderRegistry::macro_state_;
+thread_local llvm::DenseMap<clang::FileID, bool>
+    HeaderRegistry::skipped_files_;
+thread_local llvm::DenseMap<clang::FileID, FingerprintBuilder>
+    HeaderRegistry::file_macros_;
+thread_local llvm::DenseMap<const clang::MacroInfo *, Fingerprint>
+    HeaderRegistry::macro_definitions_;
+
+// 文件中的声明取决于其中被测试或展开的宏, 同一文件在不同宏定义下被包含
+// (X-macro .def/.inc) 会得到不同的指纹
+class HeaderRegistry::MacroTracker : public clang::PPCallbacks {
+public:
+  explicit MacroTracker(const clang::Preprocessor &PP) : pp_(PP) {}
+
+  void MacroExpands(const clang::Token &MacroNameTok,
+                    const clang::MacroDefinition &MD, clang::SourceRange Range,
+                    const clang::MacroArgs *Args) override {
+    record(MacroNameTok, MD);
+  }
+  void Defined(const clang::Token &MacroNameTok,
+               const clang::MacroDefinition &MD,
+               clang::SourceRange Range) override {
+    record(MacroNameTok, MD);
+  }
+  void Ifdef(clang::SourceLocation Loc, const clang::Token &MacroNameTok,
+             const clang::MacroDefinition &MD) override {
+    record(MacroNameTok, MD);
+  }
+  void Ifndef(clang::SourceLocation Loc, const clang::Token &MacroNameTok,
+              const clang::MacroDefinition &MD) override {
+    record(MacroNameTok, MD);
+  }
+
+private:
+  void record(const clang::Token &name, const clang::MacroDefinition &MD) {
+    const clang::SourceManager &sourceManager = pp_.getSourceManager();
+    const clang::FileID fileID = sourceManager.getFileID(
+        sourceManager.getExpansionLoc(name.getLocation()));
+    if (fileID.isInvalid() || fileID == sourceManager.getMainFileID())
+      return;
+
+    FingerprintBuilder &builder = file_macros_[fileID];
+    if (const clang::IdentifierInfo *identifier = name.getIdentifierInfo())
+      builder.add(identifier->getName());
+    builder.addBytes("", 1);
+    if (const clang::MacroInfo *info = MD.getMacroInfo())
+      builder.add(definition(info));
+    else
+      builder.addBytes("", 1); // 未定义
+  }
+
+  Fingerprint definition(const clang::MacroInfo *info) {
+    auto [it, inserted] = macro_definitions_.try_emplace(info);
+    if (!inserted)
+      return it->second;
+    FingerprintBuilder builder;
+    if (info->isFunctionLike()) {
+      builder.add("(");
+      for (const clang::IdentifierInfo *param : info->params())
+        builder.add(param->getName()).add(",");
+      if (info->isVariadic())
+        builder.add("...");
+      builder.add(")");
+    }
+    for (const clang::Token &token : info->tokens())
+      builder.addBytes(" ", 1).add(pp_.getSpelling(token));
+    it->second = builder.finish();
+    return it->second;
+  }
+
+  const clang::Preprocessor &pp_;
+};
+
+void HeaderRegistry::enterTranslationUnit(llvm::StringRef predefines) {
+  tu_ = next_tu_.fetch_add(1, std::memory_order_relaxed);
+  macro_state_ = Fingerprint::of(predefines);
+  skipped_files_.clear();
+  file_macros_.clear();
+  macro_definitions_.clear();
+}
+
+std::unique_ptr<clang::PPCallbacks>
+HeaderRegistry::createMacroTracker(const clang::Preprocessor &PP) {
+  return std::make_unique<MacroTracker>(PP);
+}
+
+bool HeaderRegistry::claim(const Fingerprint &header) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto [it, inserted] = claimed_.try_emplace(header, tu_);
+  return inserted || it->second == tu_;
+}
+
+bool HeaderRegistry::isExtractedElsewhere(
+    clang::SourceLocation loc, const clang::SourceManager &sourceManager) {
+  if (!enabled_ || loc.isInvalid())
+    return false;
+
+  // 宏展开产生的声明归属于展开位置所在的文件
+  const clang::FileID fileID =
+      sourceManager.getFileID(sourceManager.getExpansionLoc(loc));
+  if (fileID == sourceManager.getMainFileID())
+    return false;
+
+  auto [it, inserted] = skipped_files_.try_emplace(fileID, false);
+  if (!inserted)
+    return it->second;
+
+  auto fileEntry = sourceManager.getFileEntryRefForID(fileID);
+  auto buffer = sourceManager.getBufferDataOrNone(fileID);
+  if (!fileEntry || !buffer)
+    return false;
+
+  // 优先使用真实路径, 不同TU以不同相对路径包含同一头文件时也能命中
+  llvm::StringRef path = fileEntry->getFileEntry().tryGetRealPathName();
+  if (path.empty())
+    path = fileEntry->getName();
+
+  FingerprintBuilder builder;
+  builder.add(path);
+  builder.add(Fingerprint::of(*buffer));
+  builder.add(macro_state_);
+  auto macros = file_macros_.find(fileID);
+  if (macros != file_macros_.end())
+    builder.add(macros->second.finish());
+  it->second = !claim(builder.finish());
+  return it->second;
+}
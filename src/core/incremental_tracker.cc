@@ -0,0 +1,177 @@
+#include "core/incremental_tracker.h"
+#include "core/compilation_recorder.h"
+#include "core/srcloc_recorder.h"
+#include "db/cache_repository.h"
+#include "db/dependency_manager.h"
+#include "db/storage.h"
+#include "db/storage_facade.h"
+#include "model/db/incremental.h"
+#include "util/fingerprint.h"
+#include "util/id_generator.h"
+#include "util/logger/macros.h"
+#include <clang/Basic/SourceManager.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+const char *const kNextIdState = "last_id";
+
+// 不按TU归属删除的表: 编译记录、文件与容器(头文件被多个TU共享)以及簿记表本身
+const std::unordered_set<std::string> kKeptTables = {
+    "compilations",     "compilation_args", "compilation_build_mode",
+    "compilation_time", "compilation_finished", "container",
+    "files",            "folders",          "file_hashes",
+    "tu_files",         "tu_row_ranges",    "incremental_state",
+    "cache_sizes",      "compilation_metrics"};
+
+} // namespace
+
+void IncrementalTracker::loadState() {
+  if (!enabled_ || !Storage::getInstance().isReused())
+    return;
+  auto storage = Storage::getInstance().getStorage();
+
+  CompRecorder &recorder = CompRecorder::getInstance();
+  for (auto &row : storage->get_all<DbModel::FileHash>()) {
+    recorder.registerFile(row.path, row.file);
+    recorded_paths_.emplace(row.file, row.path);
+    recorded_hashes_.emplace(std::move(row.path), std::move(row.hash));
+  }
+
+  if (auto state = storage->get_pointer<DbModel::IncrementalState>(
+          std::string(kNextIdState)))
+    IDGenerator::resumeAfter(state->value);
+}
+
+std::vector<std::string>
+IncrementalTracker::selectSources(const std::vector<std::string> &sources) {
+  if (!enabled_)
+    return sources;
+
+  std::unordered_set<std::string> requested;
+  for (const auto &source : sources)
+    requested.insert(CompRecorder::normalizePath(source));
+
+  auto storage = Storage::getInstance().getStorage();
+  std::unordered_map<int64_t, std::vector<int64_t>> tu_files;
+  for (const auto &row : storage->get_all<DbModel::TuFile>())
+    tu_files[row.tu].push_back(row.file);
+
+  // 主文件仍在本次的源文件中且读取过的文件内容均未变化的TU保持不变
+  auto isUpToDate = [&](int64_t file) {
+    auto it = recorded_paths_.find(file);
+    return it != recorded_paths_.end() &&
+           currentHash(it->second) == recorded_hashes_[it->second];
+  };
+  std::unordered_set<std::string> up_to_date;
+  std::unordered_set<int64_t> stale_tus;
+  for (const auto &[tu, files] : tu_files) {
+    auto path = recorded_paths_.find(tu);
+    bool unchanged = path != recorded_paths_.end() &&
+                     requested.count(path->second) &&
+                     std::all_of(files.begin(), files.end(), isUpToDate);
+    if (unchanged)
+      up_to_date.insert(path->second);
+    else
+      stale_tus.insert(tu);
+  }
+
+  if (!stale_tus.empty()) {
+    std::vector<DbModel::TuRowRange> stale_ranges;
+    for (auto &range : storage->get_all<DbModel::TuRowRange>())
+      if (stale_tus.count(range.tu))
+        stale_ranges.push_back(std::move(range));
+    size_t deleted = Storage::getInstance().deleteRowRanges(stale_ranges);
+    std::vector<int64_t> tus(stale_tus.begin(), stale_tus.end());
+    storage->remove_all<DbModel::TuFile>(
+        where(in(&DbModel::TuFile::tu, tus)));
+    storage->remove_all<DbModel::TuRowRange>(
+        where(in(&DbModel::TuRowRange::tu, tus)));
+    LOG_INFO << "Removed " << deleted << " rows of " << stale_tus.size()
+             << " outdated translation units" << std::endl;
+  }
+
+  std::vector<std::string> selected;
+  for (const auto &source : sources)
+    if (!up_to_date.count(CompRecorder::normalizePath(source)))
+      selected.push_back(source);
+  LOG_INFO << "Incremental extraction: " << selected.size() << " of "
+           << sources.size() << " translation units need extracting"
+           << std::endl;
+  return selected;
+}
+
+void IncrementalTracker::beginTranslationUnit() {
+  // 此前缓冲的记录先落库, 本TU的行从各表当前最大的 rowid 之后开始
+  STG.flushThreadBatch();
+  tu_last_rowids_ = Storage::getInstance().lastRowids();
+  tu_files_.clear();
+}
+
+void IncrementalTracker::collectFiles(
+    const clang::SourceManager &sourceManager) {
+  if (!enabled_)
+    return;
+  for (auto it = sourceManager.fileinfo_begin();
+       it != sourceManager.fileinfo_end(); ++it)
+    tu_files_.push_back(CompRecorder::entryPath(it->first, sourceManager));
+}
+
+void IncrementalTracker::endTranslationUnit(const std::string &source_path) {
+  // 本TU的回填只会引用本TU的记录, 缓存清空后下一个TU从头记录
+  DependencyManager::instance().resolveDependencies();
+  CacheManager::instance().clearAll();
+  SrcLocRecorder::clearInterned();
+  STG.flushThreadBatch();
+
+  // 各表的归属由写入顺序决定, 无需假定哪一列是所属实体
+  CompRecorder &recorder = CompRecorder::getInstance();
+  int64_t tu = recorder.resolveFile(source_path);
+  for (const auto &[table, last] : Storage::getInstance().lastRowids()) {
+    int64_t first = tu_last_rowids_[table] + 1;
+    if (last < first || kKeptTables.count(table))
+      continue;
+    DbModel::TuRowRange range = {tu, table, first, last};
+    STG.insertClassObj(range);
+  }
+
+  for (const auto &normalized_path : tu_files_) {
+    DbModel::TuFile tu_file = {tu, recorder.resolveFile(normalized_path)};
+    STG.insertClassObj(tu_file);
+    if (!hashed_files_.insert(tu_file.file).second)
+      continue;
+    DbModel::FileHash file_hash = {tu_file.file, normalized_path,
+                                   currentHash(normalized_path)};
+    STG.insertClassObj(file_hash);
+  }
+  tu_files_.clear();
+}
+
+void IncrementalTracker::finish() {
+  if (!enabled_)
+    return;
+  DbModel::IncrementalState state = {kNextIdState,
+                                     IDGenerator::discardThreadBlock()};
+  Storage::getInstance().getStorage()->replace(state);
+}
+
+const std::string &
+IncrementalTracker::currentHash(const std::string &normalized_path) {
+  auto [it, inserted] = current_hashes_.try_emplace(normalized_path);
+  if (!inserted)
+    return it->second;
+
+  std::ifstream file(normalized_path, std::ios::binary);
+  if (!file)
+    return it->second;
+  std::string content((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+  std::ostringstream hash;
+  hash << Fingerprint::of(content);
+  it->second = hash.str();
+  return it->second;
+}
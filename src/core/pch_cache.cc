@@ -0,0 +1,183 @@
+#include "core/pch_cache.h"
+#include "util/logger/macros.h"
+#include <clang/Basic/FileManager.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Tooling/Tooling.h>
+#include <exception>
+#include <fstream>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <sstream>
+
+namespace {
+
+std::filesystem::path resolvePath(const std::string &path,
+                                  const std::string &directory) {
+  std::filesystem::path result(path);
+  if (result.is_relative() && !directory.empty())
+    result = std::filesystem::path(directory) / result;
+  return result.lexically_normal();
+}
+
+bool startsWith(const std::string &text, const char *prefix) {
+  return text.rfind(prefix, 0) == 0;
+}
+
+} // namespace
+
+void PchCache::configure(const Configuration &config) {
+  const CompilationConfig &compilation = config.compilation;
+  module_cache_path_ = compilation.module_cache_path;
+  pch_dir_ = compilation.pch_dir.empty()
+                 ? std::filesystem::temp_directory_path() / "sqlite-ast-pch"
+                 : std::filesystem::path(compilation.pch_dir);
+
+  prefix_headers_.clear();
+  for (const auto &header : compilation.prefix_headers)
+    prefix_headers_.push_back(
+        std::filesystem::absolute(header).lexically_normal().string());
+
+  // PCH中的头文件不会出现在TU的文件列表里, 增量模式无法感知它们的变化
+  if (!prefix_headers_.empty() && config.database.incremental) {
+    LOG_WARNING << "Prefix header precompilation is disabled in incremental "
+                   "mode"
+                << std::endl;
+    prefix_headers_.clear();
+  }
+}
+
+std::vector<std::string> PchCache::adjust(const std::vector<std::string> &args,
+                                          const std::string &file,
+                                          const std::string &directory) {
+  std::vector<std::string> result;
+  result.reserve(args.size() + 3);
+  bool has_pch = false, has_module_cache = false, uses_modules = false;
+
+  for (size_t i = 0; i < args.size(); ++i) {
+    const std::string &arg = args[i];
+    uses_modules |= arg == "-fmodules" || arg == "-fcxx-modules";
+    has_module_cache |= startsWith(arg, "-fmodules-cache-path=");
+
+    // -include-pch <pch> 或 -Xclang -include-pch -Xclang <pch>
+    bool xclang = arg == "-Xclang" && i + 1 < args.size() &&
+                  args[i + 1] == "-include-pch";
+    if (arg != "-include-pch" && !xclang) {
+      result.push_back(arg);
+      continue;
+    }
+    size_t last = xclang ? i + 3 : i + 1;
+    if (last >= args.size()) {
+      result.push_back(arg);
+      continue;
+    }
+    // 构建目录已清理时PCH可能不存在, 此时退回到直接解析头文件
+    if (std::filesystem::exists(resolvePath(args[last], directory))) {
+      has_pch = true;
+      result.insert(result.end(), args.begin() + i, args.begin() + last + 1);
+    } else {
+      LOG_WARNING << "Ignore missing precompiled header " << args[last]
+                  << " of " << file << std::endl;
+    }
+    i = last;
+  }
+
+  if (uses_modules && !has_module_cache && !module_cache_path_.empty())
+    result.push_back("-fmodules-cache-path=" + module_cache_path_);
+
+  if (!has_pch && !prefix_headers_.empty()) {
+    std::string pch = obtain(result, file, directory);
+    if (!pch.empty()) {
+      result.push_back("-include-pch");
+      result.push_back(pch);
+    }
+  }
+  return result;
+}
+
+std::string PchCache::obtain(const std::vector<std::string> &args,
+                             const std::string &file,
+                             const std::string &directory) {
+  // 去掉源文件与决定输出类型的选项, 剩余参数(及工作目录)决定PCH能否复用
+  const auto source = resolvePath(file, directory);
+  std::vector<std::string> command;
+  FingerprintBuilder key;
+  key.add(directory).addBytes("", 1);
+  for (size_t i = 0; i < args.size(); ++i) {
+    const std::string &arg = args[i];
+    if (arg == "-fsyntax-only" || arg == "-c" || arg == "-S" || arg == "-E")
+      continue;
+    if (i > 0 && !startsWith(arg, "-") &&
+        resolvePath(arg, directory) == source)
+      continue;
+    command.push_back(arg);
+    key.add(arg).addBytes("", 1);
+  }
+  for (const auto &header : prefix_headers_)
+    key.add(header).addBytes("", 1);
+
+  const Fingerprint pch_key = key.finish();
+  std::promise<std::string> promise;
+  std::shared_future<std::string> pch;
+  bool owner = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = pch_files_.try_emplace(pch_key);
+    if (inserted)
+      it->second = promise.get_future().share();
+    pch = it->second;
+    owner = inserted;
+  }
+  // 生成一个PCH是一次完整编译, 不持锁进行, 其他参数的TU可同时生成各自的PCH
+  if (owner) {
+    try {
+      promise.set_value(build(std::move(command), file, directory, pch_key));
+    } catch (...) {
+      promise.set_exception(std::current_exception());
+    }
+  }
+  return pch.get();
+}
+
+std::string PchCache::build(std::vector<std::string> command,
+                            const std::string &file,
+                            const std::string &directory,
+                            const Fingerprint &key) {
+  std::ostringstream name;
+  name << key;
+  std::error_code error;
+  std::filesystem::create_directories(pch_dir_, error);
+  const auto header = pch_dir_ / (name.str() + ".h");
+  const auto pch = pch_dir_ / (name.str() + ".pch");
+  {
+    std::ofstream out(header);
+    for (const auto &prefix : prefix_headers_)
+      out << "#include \"" << prefix << "\"\n";
+    if (!out) {
+      LOG_WARNING << "Failed to write prefix header " << header << std::endl;
+      return "";
+    }
+  }
+
+  // C 源文件对应的PCH需按C头文件编译, 否则语言选项与TU不一致
+  bool is_c = std::filesystem::path(file).extension() == ".c";
+  command.insert(command.end(), {"-x", is_c ? "c-header" : "c++-header",
+                                 header.string(), "-o", pch.string()});
+
+  llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fs =
+      llvm::vfs::createPhysicalFileSystem();
+  if (!directory.empty())
+    fs->setCurrentWorkingDirectory(directory);
+  llvm::IntrusiveRefCntPtr<clang::FileManager> files(
+      new clang::FileManager(clang::FileSystemOptions(), fs));
+  clang::tooling::ToolInvocation invocation(
+      std::move(command), std::make_unique<clang::GeneratePCHAction>(),
+      files.get(), std::make_shared<clang::PCHContainerOperations>());
+  if (!invocation.run()) {
+    LOG_WARNING << "Failed to precompile prefix headers for " << file
+                << ", parsing them in every TU instead" << std::endl;
+    return "";
+  }
+
+  LOG_INFO << "Precompiled " << prefix_headers_.size()
+           << " prefix header(s) into " << pch << std::endl;
+  return pch.string();
+}
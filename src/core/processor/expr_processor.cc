@@ -15,29 +15,29 @@
 #include <clang/AST/ExprConcepts.h>
 #include <clang/AST/ExprCXX.h>
 
-int ExprProcessor::processBaseExpr(Expr *expr, ExprKind exprKind) {
+int64_t ExprProcessor::processBaseExpr(Expr *expr, ExprKind exprKind) {
   KeyType exprKey = KeyGen::Expr_::makeKey(expr, ast_context_);
-  LocIdPair *locIdPair = SrcLocRecorder::processExpr(expr, ast_context_);
+  LocIdPair locIdPair = SrcLocRecorder::processExpr(expr, ast_context_);
 
   DbModel::Expr exprModel = {GENID(Expr), static_cast<int>(exprKind),
-                             locIdPair->spec_id};
+                             locIdPair.spec_id};
 
-  INSERT_EXPR_CACHE(exprKey, exprModel.id);
-  STG.insertClassObj(exprModel);
-  return exprModel.id;
+  const int64_t exprId = INSERT_EXPR_CACHE(exprKey, exprModel.id);
+  if (exprId == exprModel.id)
+    STG.insertClassObj(exprModel);
+  return exprId;
 }
 
 void ExprProcessor::processDeclRef(DeclRefExpr *expr) {
+  PROCESSOR_SCOPE();
   ValueDecl *valueDecl = expr->getDecl();
 
   if (auto *VD = dyn_cast<clang::VarDecl>(valueDecl)) {
     // Original behavior: create VARACCESS expr + VarBind
-    int exprId = processBaseExpr(expr, ExprKind::VARACCESS);
+    int64_t exprId = processBaseExpr(expr, ExprKind::VARACCESS);
 
-    KeyType varKey = KeyGen::Var::makeKey(VD, ast_context_);
-    LOG_DEBUG << "Searching variable cache for " << varKey << std::endl;
-    int cachedVarId = -1;
-    if (auto cachedId = SEARCH_VARIABLE_CACHE(varKey))
+    int64_t cachedVarId = -1;
+    if (auto cachedId = KeyGen::Var::findId(VD, ast_context_))
       cachedVarId = *cachedId;
     LOG_DEBUG << "Found variable ID: " << cachedVarId << std::endl;
 
@@ -54,6 +54,7 @@ void ExprProcessor::processDeclRef(DeclRefExpr *expr) {
 }
 
 void ExprProcessor::processUnaryOperator(const UnaryOperator *op) {
+  PROCESSOR_SCOPE();
   ExprKind exprType;
   switch (op->getOpcode()) {
   // 1.1.1. 自增/自减运算
@@ -100,6 +101,7 @@ void ExprProcessor::processUnaryOperator(const UnaryOperator *op) {
 }
 
 void ExprProcessor::processBinaryOperator(const BinaryOperator *op) {
+  PROCESSOR_SCOPE();
   ExprKind expr_type = ExprKind::_UNKNOWN_;
 
   switch (op->getOpcode()) {
@@ -196,6 +198,7 @@ void ExprProcessor::processBinaryOperator(const BinaryOperator *op) {
 }
 
 void ExprProcessor::processConditionalOperator(const ConditionalOperator *op) {
+  PROCESSOR_SCOPE();
   processBaseExpr(const_cast<ConditionalOperator *>(op),
                   ExprKind::CONDITIONALEXPR);
   // Traverse(op->getCond());
@@ -326,7 +329,8 @@ void ExprProcessor::processAssignExpr(const BinaryOperator *op) {
 }
 
 void ExprProcessor::processStringLiteral(const StringLiteral *literal) {
-  int exprId =
+  PROCESSOR_SCOPE();
+  int64_t exprId =
       processBaseExpr(const_cast<StringLiteral *>(literal), ExprKind::LITERAL);
 
   std::string value = literal->getString().str();
@@ -336,7 +340,8 @@ void ExprProcessor::processStringLiteral(const StringLiteral *literal) {
 }
 
 void ExprProcessor::processIntegerLiteral(const IntegerLiteral *literal) {
-  int exprId =
+  PROCESSOR_SCOPE();
+  int64_t exprId =
       processBaseExpr(const_cast<IntegerLiteral *>(literal), ExprKind::LITERAL);
 
   std::string value = std::to_string(literal->getValue().getSExtValue());
@@ -346,8 +351,9 @@ void ExprProcessor::processIntegerLiteral(const IntegerLiteral *literal) {
 }
 
 void ExprProcessor::processFloatingLiteral(const FloatingLiteral *literal) {
-  int exprId = processBaseExpr(const_cast<FloatingLiteral *>(literal),
-                               ExprKind::LITERAL);
+  PROCESSOR_SCOPE();
+  int64_t exprId = processBaseExpr(const_cast<FloatingLiteral *>(literal),
+                                   ExprKind::LITERAL);
 
   llvm::SmallVector<char, 16> buffer;
   literal->getValue().toString(buffer);
@@ -358,8 +364,9 @@ void ExprProcessor::processFloatingLiteral(const FloatingLiteral *literal) {
 }
 
 void ExprProcessor::processCharacterLiteral(const CharacterLiteral *literal) {
-  int exprId = processBaseExpr(const_cast<CharacterLiteral *>(literal),
-                               ExprKind::LITERAL);
+  PROCESSOR_SCOPE();
+  int64_t exprId = processBaseExpr(const_cast<CharacterLiteral *>(literal),
+                                   ExprKind::LITERAL);
 
   std::string value = std::to_string(literal->getValue());
   std::string text =
@@ -369,8 +376,9 @@ void ExprProcessor::processCharacterLiteral(const CharacterLiteral *literal) {
 }
 
 void ExprProcessor::processBoolLiteral(const CXXBoolLiteralExpr *literal) {
-  int exprId = processBaseExpr(const_cast<CXXBoolLiteralExpr *>(literal),
-                               ExprKind::LITERAL);
+  PROCESSOR_SCOPE();
+  int64_t exprId = processBaseExpr(const_cast<CXXBoolLiteralExpr *>(literal),
+                                   ExprKind::LITERAL);
 
   std::string value = literal->getValue() ? "1" : "0";
   std::string text = literal->getValue() ? "true" : "false";
@@ -378,23 +386,23 @@ void ExprProcessor::processBoolLiteral(const CXXBoolLiteralExpr *literal) {
   processLiteralValue(value, text, exprId);
 }
 
-int ExprProcessor::processLiteralValue(const std::string &value,
-                                       const std::string &text, int exprId) {
+int64_t ExprProcessor::processLiteralValue(const std::string &value,
+                                           const std::string &text,
+                                           int64_t exprId) {
   // Create Values entry
+  // 相同的值与文本共用一条记录, 只由登记成功的一方写入
   KeyType valueKey = KeyGen::Values::makeKey(value);
-  int valueId = GENID(Values);
-
-  DbModel::Values valuesModel = {valueId, value};
-  INSERT_VALUES_CACHE(valueKey, valueId);
-  STG.insertClassObj(valuesModel);
+  DbModel::Values valuesModel = {GENID(Values), value};
+  const int64_t valueId = INSERT_VALUES_CACHE(valueKey, valuesModel.id);
+  if (valueId == valuesModel.id)
+    STG.insertClassObj(valuesModel);
 
   // Create ValueText entry
   KeyType textKey = KeyGen::ValueText::makeKey(text);
-  int textId = GENID(ValueText);
-
-  DbModel::ValueText valueTextModel = {textId, text};
-  INSERT_VALUETEXT_CACHE(textKey, textId);
-  STG.insertClassObj(valueTextModel);
+  DbModel::ValueText valueTextModel = {GENID(ValueText), text};
+  const int64_t textId = INSERT_VALUETEXT_CACHE(textKey, valueTextModel.id);
+  if (textId == valueTextModel.id)
+    STG.insertClassObj(valueTextModel);
 
   // Create ValueBind to link expression with value
   recordValueBindExpr(valueId, exprId);
@@ -402,24 +410,21 @@ int ExprProcessor::processLiteralValue(const std::string &value,
   return valueId;
 }
 
-void ExprProcessor::recordValueBindExpr(int valueId, int exprId) {
+void ExprProcessor::recordValueBindExpr(int64_t valueId, int64_t exprId) {
   DbModel::ValueBind valueBindModel = {valueId, exprId};
   STG.insertClassObj(valueBindModel);
 }
 
 void ExprProcessor::processCallExpr(const CallExpr *expr) {
-  int exprId =
+  PROCESSOR_SCOPE();
+  int64_t exprId =
       processBaseExpr(const_cast<CallExpr *>(expr), ExprKind::CALLEXPR);
 
   // Get the called function
   const FunctionDecl *callee = expr->getDirectCallee();
   if (callee) {
-    // Generate key for the called function
-    KeyType funcKey = KeyGen::Function::makeKey(callee, ast_context_);
-    LOG_DEBUG << "CallExpr function key: " << funcKey << std::endl;
-
     // Check if function is in cache
-    if (auto cachedFuncId = SEARCH_FUNCTION_CACHE(funcKey)) {
+    if (auto cachedFuncId = KeyGen::Function::findId(callee, ast_context_)) {
       // Create FunBind record linking expression to function
       DbModel::FunBind funBindModel = {exprId, *cachedFuncId};
       STG.insertClassObj(funBindModel);
@@ -428,12 +433,10 @@ void ExprProcessor::processCallExpr(const CallExpr *expr) {
       DbModel::FunBind funBindModel = {exprId, -1};
       STG.insertClassObj(funBindModel);
 
-      PendingUpdate update{
-          funcKey, CacheType::FUNCTION, [exprId](int resolvedId) {
-            DbModel::FunBind updated_record = {exprId, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      KeyType funcKey = KeyGen::Function::makeKey(callee, ast_context_);
+      LOG_DEBUG << "CallExpr function key: " << funcKey << std::endl;
+      DependencyManager::instance().addDependency(
+          funcKey, CacheType::FUNCTION, funBindModel, &DbModel::FunBind::fun);
     }
   }
 
@@ -444,6 +447,7 @@ void ExprProcessor::processCallExpr(const CallExpr *expr) {
 }
 
 void ExprProcessor::processImplicitCastExpr(const ImplicitCastExpr *ICE) {
+  PROCESSOR_SCOPE();
   if (!ICE)
     return;
 
@@ -455,13 +459,15 @@ void ExprProcessor::processImplicitCastExpr(const ImplicitCastExpr *ICE) {
 }
 
 void ExprProcessor::processArraySubscriptExpr(const ArraySubscriptExpr *expr) {
+  PROCESSOR_SCOPE();
   processBaseExpr(const_cast<ArraySubscriptExpr *>(expr),
                   ExprKind::SUBSCRIPTEXPR);
 }
 
 void ExprProcessor::processInitListExpr(const InitListExpr *expr) {
-  int exprId = processBaseExpr(const_cast<InitListExpr *>(expr),
-                               ExprKind::BRACED_INIT_LIST);
+  PROCESSOR_SCOPE();
+  int64_t exprId = processBaseExpr(const_cast<InitListExpr *>(expr),
+                                   ExprKind::BRACED_INIT_LIST);
 
   QualType initType = expr->getType();
 
@@ -474,7 +480,7 @@ void ExprProcessor::processInitListExpr(const InitListExpr *expr) {
   }
 }
 
-void ExprProcessor::recordAggregateArrayInit(int initListExprId,
+void ExprProcessor::recordAggregateArrayInit(int64_t initListExprId,
                                              const InitListExpr *expr) {
   unsigned numInits = expr->getNumInits();
 
@@ -483,7 +489,7 @@ void ExprProcessor::recordAggregateArrayInit(int initListExprId,
     if (!init) continue;
 
     KeyType initKey = KeyGen::Expr_::makeKey(init, ast_context_);
-    int initExprId = SEARCH_EXPR_CACHE(initKey).value_or(-1);
+    int64_t initExprId = SEARCH_EXPR_CACHE(initKey).value_or(-1);
 
     if (initExprId == -1) {
       LOG_WARNING << "Init expression not in cache for index " << i << std::endl;
@@ -500,7 +506,7 @@ void ExprProcessor::recordAggregateArrayInit(int initListExprId,
   }
 }
 
-void ExprProcessor::recordAggregateFieldInit(int initListExprId,
+void ExprProcessor::recordAggregateFieldInit(int64_t initListExprId,
                                              const InitListExpr *expr) {
   const RecordType *recordType = expr->getType()->getAs<RecordType>();
   if (!recordType || !recordType->getDecl()) {
@@ -524,11 +530,10 @@ void ExprProcessor::recordAggregateFieldInit(int initListExprId,
 
     // 获取初始化表达式 ID
     KeyType initKey = KeyGen::Expr_::makeKey(init, ast_context_);
-    int initExprId = SEARCH_EXPR_CACHE(initKey).value_or(-1);
+    int64_t initExprId = SEARCH_EXPR_CACHE(initKey).value_or(-1);
 
     // 使用标准的键生成器查找字段 ID (@membervariable ref)
-    KeyType fieldKey = KeyGen::Var::makeKey(field, ast_context_);
-    int fieldId = SEARCH_MEMBERVAR_CACHE(fieldKey).value_or(-1);
+    int64_t fieldId = KeyGen::Var::findId(field, ast_context_).value_or(-1);
 
     if (fieldId == -1) {
       // Create placeholder with field = -1
@@ -541,17 +546,9 @@ void ExprProcessor::recordAggregateFieldInit(int initListExprId,
       STG.insertClassObj(initModel);
 
       // Add dependency to be resolved later
-      PendingUpdate update{
-        fieldKey, CacheType::MEMBERVERY, [initListExprId, initExprId, fieldIndex](int resolvedFieldId) {
-          DbModel::AggregateFieldInit updatedModel = {
-            initListExprId,  // aggregate (@aggregateliteral ref)
-            initExprId,      // initializer (@expr ref)
-            resolvedFieldId, // resolved field ID
-            fieldIndex       // position (int ref)
-          };
-          STG.insertClassObj(updatedModel);
-        }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          KeyGen::Var::makeKey(field, ast_context_), CacheType::MEMBERVERY,
+          initModel, &DbModel::AggregateFieldInit::field);
 
       std::string fieldName = field->getNameAsString();
       std::string recordName = recordDecl->getNameAsString();
@@ -573,6 +570,7 @@ void ExprProcessor::recordAggregateFieldInit(int initListExprId,
 }
 
 void ExprProcessor::processUnaryExprOrTypeTraitExpr(const UnaryExprOrTypeTraitExpr *expr) {
+  PROCESSOR_SCOPE();
   UnaryExprOrTypeTrait kind = expr->getKind();
 
   if (kind != UETT_SizeOf && kind != UETT_AlignOf) {
@@ -582,17 +580,19 @@ void ExprProcessor::processUnaryExprOrTypeTraitExpr(const UnaryExprOrTypeTraitEx
 
   ExprKind exprKind = (kind == UETT_SizeOf) ? ExprKind::RUNTIME_SIZEOF : ExprKind::RUNTIME_ALIGNOF;
 
-  int exprId = processBaseExpr(const_cast<UnaryExprOrTypeTraitExpr *>(expr), exprKind);
+  int64_t exprId =
+      processBaseExpr(const_cast<UnaryExprOrTypeTraitExpr *>(expr), exprKind);
   recordSizeOfBind(exprId, expr);
 }
 
-void ExprProcessor::recordSizeOfBind(int exprId, const UnaryExprOrTypeTraitExpr *expr) {
+void ExprProcessor::recordSizeOfBind(int64_t exprId,
+                                     const UnaryExprOrTypeTraitExpr *expr) {
   if (expr->isArgumentType()) {
     // sizeof(type) or alignof(type)
     QualType typeQual = expr->getArgumentType();
     const Type *type = typeQual.getTypePtr();
 
-    int typeId = -1;
+    int64_t typeId = -1;
     if (type_processor_) {
       typeId = type_processor_->processType(type);
     } else {
@@ -614,7 +614,7 @@ void ExprProcessor::recordSizeOfBind(int exprId, const UnaryExprOrTypeTraitExpr
     QualType typeQual = argExpr->getType();
     const Type *type = typeQual.getTypePtr();
 
-    int typeId = -1;
+    int64_t typeId = -1;
     if (type_processor_) {
       typeId = type_processor_->processType(type);
     } else {
@@ -626,8 +626,9 @@ void ExprProcessor::recordSizeOfBind(int exprId, const UnaryExprOrTypeTraitExpr
   }
 }
 
-int ExprProcessor::processConceptSpecializationExpr(
-    const ConceptSpecializationExpr *expr, int conceptId) {
+int64_t ExprProcessor::processConceptSpecializationExpr(
+    const ConceptSpecializationExpr *expr, int64_t conceptId) {
+  PROCESSOR_SCOPE();
   if (!expr || conceptId == -1)
     return -1;
 
@@ -635,18 +636,20 @@ int ExprProcessor::processConceptSpecializationExpr(
   if (auto cachedId = SEARCH_EXPR_CACHE(exprKey))
     return *cachedId;
 
-  LocIdPair *locIdPair = SrcLocRecorder::processExpr(expr, ast_context_);
+  LocIdPair locIdPair = SrcLocRecorder::processExpr(expr, ast_context_);
   DbModel::Expr exprModel = {conceptId,
                              static_cast<int>(ExprKind::CONCEPT_ID),
-                             locIdPair->spec_id};
+                             locIdPair.spec_id};
 
-  INSERT_EXPR_CACHE(exprKey, exprModel.id);
-  STG.insertClassObj(exprModel);
-  return exprModel.id;
+  const int64_t exprId = INSERT_EXPR_CACHE(exprKey, exprModel.id);
+  if (exprId == exprModel.id)
+    STG.insertClassObj(exprModel);
+  return exprId;
 }
 
-int ExprProcessor::processNonTypeTemplateParmDecl(
+int64_t ExprProcessor::processNonTypeTemplateParmDecl(
     const NonTypeTemplateParmDecl *decl) {
+  PROCESSOR_SCOPE();
   if (!decl)
     return -1;
 
@@ -658,13 +661,14 @@ int ExprProcessor::processNonTypeTemplateParmDecl(
   if (auto cachedId = SEARCH_EXPR_CACHE(exprKey))
     return *cachedId;
 
-  int exprId = IDGenerator::generateId<DbModel::Expr>();
-  LocIdPair *locIdPair = SrcLocRecorder::processExpr(decl, ast_context_);
+  int64_t exprId = IDGenerator::generateId<DbModel::Expr>();
+  LocIdPair locIdPair = SrcLocRecorder::processExpr(decl, ast_context_);
   DbModel::Expr exprModel = {exprId,
                              static_cast<int>(ExprKind::NONTYPE_TEMPLATE_PARAMETER),
-                             locIdPair->spec_id};
+                             locIdPair.spec_id};
 
-  INSERT_EXPR_CACHE(exprKey, exprModel.id);
-  STG.insertClassObj(exprModel);
-  return exprModel.id;
+  const int64_t exprId = INSERT_EXPR_CACHE(exprKey, exprModel.id);
+  if (exprId == exprModel.id)
+    STG.insertClassObj(exprModel);
+  return exprId;
 }
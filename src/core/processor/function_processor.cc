@@ -24,15 +24,17 @@ Stmt *getFirstNonCompoundStmt(clang::Stmt *S);
 void FunctionProcessor::handleBaseFunc(const FunctionDecl *decl,
                                        const FuncType type) {
   _locIdPair = PROC_DEFT(cast<Decl>(decl), ast_context_);
-  std::string name = decl->getNameAsString();
-  DbModel::Function function = {_funcId = GENID(Function), name,
+  InternedString name = INTERN(decl->getNameAsString());
+  DbModel::Function function = {GENID(Function), name,
                                 static_cast<int>(type)};
   _funcDeclId = GENID(FunDecl); // Generate ID early for dependency capturing
 
-  // Insert Cache
+  // Insert Cache. 同一函数的其他声明(或其他工作线程)已登记时沿用其ID,
+  // 只记录本处声明
   KeyType funcKey = KeyGen::Function::makeKey(decl, ast_context_);
   LOG_DEBUG << "Function FunctionKey: " << funcKey << std::endl;
-  INSERT_FUNCTION_CACHE(funcKey, _funcId);
+  _funcId = INSERT_FUNCTION_CACHE(funcKey, function.id);
+  _funcClaimed = _funcId == function.id;
 
   KeyType elementKey = KeyGen::Element::makeKeyFromFuncKey(funcKey);
   DbModel::ParameterizedElement parameterizedElement = {
@@ -42,6 +44,7 @@ void FunctionProcessor::handleBaseFunc(const FunctionDecl *decl,
 
   // Record @purefunction @function_deleted @function_defaulted
   // @function_prototyped
+  // 各声明分别记录: 类外 = default 等性质只出现在定义上, 记录以函数ID为主键
   recordBasicInfo(decl);
 
   // Record @function_entry_point stmt
@@ -60,11 +63,13 @@ void FunctionProcessor::handleBaseFunc(const FunctionDecl *decl,
   recordCoroutine(decl);
 
   DbModel::FunDecl fun_decl = {_funcDeclId, _funcId, _typeId, name,
-                               _locIdPair->spec_id};
+                               _locIdPair.spec_id};
 
-  STG.insertClassObj(function);
+  if (_funcClaimed) {
+    STG.insertClassObj(function);
+    STG.insertClassObj(parameterizedElement);
+  }
   STG.insertClassObj(fun_decl);
-  STG.insertClassObj(parameterizedElement);
 }
 
 void FunctionProcessor::recordEntryPoint(const FunctionDecl *decl) const {
@@ -72,7 +77,7 @@ void FunctionProcessor::recordEntryPoint(const FunctionDecl *decl) const {
     return;
   Stmt *body = decl->getBody();
   Stmt *entryStmt = getFirstNonCompoundStmt(body);
-  std::string stmtKey = KeyGen::Stmt_::makeKey(entryStmt, ast_context_);
+  KeyType stmtKey = KeyGen::Stmt_::makeKey(entryStmt, ast_context_);
   LOG_DEBUG << "Function entry point StmtKey: " << stmtKey << std::endl;
 
   if (auto cachedId = SEARCH_STMT_CACHE(stmtKey)) {
@@ -81,12 +86,9 @@ void FunctionProcessor::recordEntryPoint(const FunctionDecl *decl) const {
   } else {
     DbModel::FuncEntryPt funcEntryPt = {_funcId, -1};
     STG.insertClassObj(funcEntryPt);
-    PendingUpdate update{
-        stmtKey, CacheType::STMT, [_funcId = _funcId](int resolvedId) {
-          DbModel::FuncEntryPt updated_record = {_funcId, resolvedId};
-          STG.insertClassObj(updated_record);
-        }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        stmtKey, CacheType::STMT, funcEntryPt,
+        &DbModel::FuncEntryPt::entry_point);
   }
 }
 
@@ -119,36 +121,32 @@ void FunctionProcessor::recordBasicInfo(const FunctionDecl *decl) const {
 
 void FunctionProcessor::recordReturnType(const FunctionDecl *decl) {
   // Check Type cache for Id for returnType
-  KeyType typeKey = KeyGen::Type::makeKey(decl->getReturnType(), ast_context_);
-  LOG_DEBUG << "Function TypeKey: " << typeKey << std::endl;
-
-  if (auto cachedId = SEARCH_TYPE_CACHE(typeKey)) {
+  std::optional<KeyType> typeKey;
+  if (auto cachedId =
+          KeyGen::Type::findId(decl->getReturnType(), ast_context_)) {
     _typeId = *cachedId;
   } else {
     _typeId = -1;
+    typeKey = KeyGen::Type::makeKey(decl->getReturnType(), ast_context_);
+    LOG_DEBUG << "Function TypeKey: " << *typeKey << std::endl;
     // Register dependency for FunDecl table
-    PendingUpdate funDeclUpdate{
-        typeKey, CacheType::TYPE,
-        [_funcDeclId = _funcDeclId, _funcId = _funcId,
-         name = decl->getNameAsString(),
-         spec_id = _locIdPair->spec_id](int resolvedId) {
-          DbModel::FunDecl updated_record = {_funcDeclId, _funcId, resolvedId,
-                                             name, spec_id};
-          STG.insertClassObj(updated_record);
-        }};
-    DependencyManager::instance().addDependency(funDeclUpdate);
+    DependencyManager::instance().addDependency(
+        *typeKey, CacheType::TYPE,
+        DbModel::FunDecl{_funcDeclId, _funcId, -1,
+                         INTERN(decl->getNameAsString()), _locIdPair.spec_id},
+        &DbModel::FunDecl::type_id);
   }
+  // 函数级记录, 只由首个登记该函数的声明写入
+  if (!_funcClaimed)
+    return;
   // This record always needs to be inserted, either with a real ID or a
   // dependency
   DbModel::FuncRetType func_ret_type = {_funcId, _typeId};
   STG.insertClassObj(func_ret_type);
   if (_typeId == -1) {
-    PendingUpdate funcRetUpdate{
-        typeKey, CacheType::TYPE, [_funcId = _funcId](int resolvedId) {
-          DbModel::FuncRetType updated_record = {_funcId, resolvedId};
-          STG.insertClassObj(updated_record);
-        }};
-    DependencyManager::instance().addDependency(funcRetUpdate);
+    DependencyManager::instance().addDependency(
+        *typeKey, CacheType::TYPE, func_ret_type,
+        &DbModel::FuncRetType::return_type);
   }
 }
 
@@ -171,21 +169,15 @@ void FunctionProcessor::recordException(const clang::FunctionDecl *decl) const {
     // 处理 throw(Type1, Type2, ...)
     int index = 0;
     for (const auto &qt : funcProtoType->exceptions()) {
-      KeyType typeKey = KeyGen::Type::makeKey(qt, ast_context_);
-      if (auto cachedId = SEARCH_TYPE_CACHE(typeKey)) {
+      if (auto cachedId = KeyGen::Type::findId(qt, ast_context_)) {
         DbModel::FunDeclThrow funDeclThrow = {_funcDeclId, index, *cachedId};
         STG.insertClassObj(funDeclThrow);
       } else {
         DbModel::FunDeclThrow funDeclThrow = {_funcDeclId, index, -1};
         STG.insertClassObj(funDeclThrow);
-        PendingUpdate update{
-            typeKey, CacheType::TYPE,
-            [_funcDeclId = _funcDeclId, index = index](int resolvedId) {
-              DbModel::FunDeclThrow updated_record = {_funcDeclId, index,
-                                                      resolvedId};
-              STG.insertClassObj(updated_record);
-            }};
-        DependencyManager::instance().addDependency(update);
+        DependencyManager::instance().addDependency(
+            KeyGen::Type::makeKey(qt, ast_context_), CacheType::TYPE,
+            funDeclThrow, &DbModel::FunDeclThrow::type_id);
       }
       index++;
     }
@@ -209,13 +201,9 @@ void FunctionProcessor::recordException(const clang::FunctionDecl *decl) const {
       } else {
         DbModel::FunDeclNoexcept funDeclNoexcept = {_funcDeclId, -1};
         STG.insertClassObj(funDeclNoexcept);
-        PendingUpdate update{exprKey, CacheType::EXPR,
-                             [_funcDeclId = _funcDeclId](int resolvedId) {
-                               DbModel::FunDeclNoexcept updated_record = {
-                                   _funcDeclId, resolvedId};
-                               STG.insertClassObj(updated_record);
-                             }};
-        DependencyManager::instance().addDependency(update);
+        DependencyManager::instance().addDependency(
+            exprKey, CacheType::EXPR, funDeclNoexcept,
+            &DbModel::FunDeclNoexcept::constant);
       }
     } else if (funcProtoType->getExceptionSpecType() == EST_DependentNoexcept) {
       // If noexcepExpr is a nullptr, treat as fun_decl_empty_noexcept
@@ -242,13 +230,9 @@ void FunctionProcessor::recordTypedef(const FunctionDecl *decl) const {
       } else {
         DbModel::FunDeclTypedefType funDeclTypedefType = {_funcDeclId, -1};
         STG.insertClassObj(funDeclTypedefType);
-        PendingUpdate update{userTypekey, CacheType::USERTYPE,
-                             [_funcDeclId = _funcDeclId](int resolvedId) {
-                               DbModel::FunDeclTypedefType updated_record = {
-                                   _funcDeclId, resolvedId};
-                               STG.insertClassObj(updated_record);
-                             }};
-        DependencyManager::instance().addDependency(update);
+        DependencyManager::instance().addDependency(
+            userTypekey, CacheType::USERTYPE, funDeclTypedefType,
+            &DbModel::FunDeclTypedefType::tyepdeftype_id);
       }
     }
   };
@@ -284,12 +268,8 @@ void FunctionProcessor::recordCoroutine(const FunctionDecl *FD) {
   } else {
     DbModel::Coroutine coroutine = {_funcId, -1};
     STG.insertClassObj(coroutine);
-    PendingUpdate update{
-        typeKey, CacheType::TYPE, [_funcId = _funcId](int resolvedId) {
-          DbModel::Coroutine updated_record = {_funcId, resolvedId};
-          STG.insertClassObj(updated_record);
-        }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        typeKey, CacheType::TYPE, coroutine, &DbModel::Coroutine::traits);
   }
 
   FunctionDecl *NewFD = getCoroutineNewFunction(FD);
@@ -302,12 +282,9 @@ void FunctionProcessor::recordCoroutine(const FunctionDecl *FD) {
     } else {
       DbModel::CoroutineNew couroutine_new = {_funcId, -1};
       STG.insertClassObj(couroutine_new);
-      PendingUpdate update{
-          newFuncKey, CacheType::FUNCTION, [_funcId = _funcId](int resolvedId) {
-            DbModel::CoroutineNew updated_record = {_funcId, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          newFuncKey, CacheType::FUNCTION, couroutine_new,
+          &DbModel::CoroutineNew::new_);
     }
   }
 
@@ -321,19 +298,17 @@ void FunctionProcessor::recordCoroutine(const FunctionDecl *FD) {
     } else {
       DbModel::CoroutineDelete couroutine_delete = {_funcId, -1};
       STG.insertClassObj(couroutine_delete);
-      PendingUpdate update{
-          delFuncKey, CacheType::FUNCTION, [_funcId = _funcId](int resolvedId) {
-            DbModel::CoroutineDelete updated_record = {_funcId, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          delFuncKey, CacheType::FUNCTION, couroutine_delete,
+          &DbModel::CoroutineDelete::delete_);
     }
   }
 }
 
 // Router to process functions of @operator @builtin_function
 // @user_defined_function, @normal_function
-int FunctionProcessor::routerProcess(const clang::FunctionDecl *decl) {
+int64_t FunctionProcessor::routerProcess(const clang::FunctionDecl *decl) {
+  PROCESSOR_SCOPE();
   auto kind = decl->getKind();
   // Return first, will be processed by other functions
   if (kind == Decl::CXXConstructor || kind == Decl::CXXDestructor ||
@@ -376,47 +351,53 @@ int FunctionProcessor::routerProcess(const clang::FunctionDecl *decl) {
   return processNormalFunc(cast<FunctionDecl>(decl));
 }
 
-int FunctionProcessor::processBuiltinFunc(const clang::FunctionDecl *decl) {
+int64_t FunctionProcessor::processBuiltinFunc(const clang::FunctionDecl *decl) {
   handleBaseFunc(cast<FunctionDecl>(decl), FuncType::BUILDIN_FUNC);
   return _funcId;
 }
 
-int FunctionProcessor::processUserDefinedLiteral(
+int64_t FunctionProcessor::processUserDefinedLiteral(
     const clang::FunctionDecl *decl) {
 
   handleBaseFunc(cast<FunctionDecl>(decl), FuncType::USER_DEFINED_LITERAL);
   return _funcId;
 }
 
-int FunctionProcessor::processOperatorFunc(const clang::FunctionDecl *decl) {
+int64_t FunctionProcessor::processOperatorFunc(
+    const clang::FunctionDecl *decl) {
 
   handleBaseFunc(cast<FunctionDecl>(decl), FuncType::OPERATOR);
   return _funcId;
 }
 
-int FunctionProcessor::processNormalFunc(const clang::FunctionDecl *decl) {
+int64_t FunctionProcessor::processNormalFunc(const clang::FunctionDecl *decl) {
 
   handleBaseFunc(cast<FunctionDecl>(decl), FuncType::NORM_FUNC);
   return _funcId;
 }
 
-int FunctionProcessor::processCXXConstructor(const CXXConstructorDecl *decl) {
+int64_t FunctionProcessor::processCXXConstructor(
+    const CXXConstructorDecl *decl) {
+  PROCESSOR_SCOPE();
   handleBaseFunc(cast<FunctionDecl>(decl), FuncType::CONSTRUCTOR);
   return _funcId;
 }
 
-int FunctionProcessor::processCXXDestructor(const CXXDestructorDecl *decl) {
+int64_t FunctionProcessor::processCXXDestructor(const CXXDestructorDecl *decl) {
+  PROCESSOR_SCOPE();
   handleBaseFunc(cast<FunctionDecl>(decl), FuncType::DESTRUCTOR);
   return _funcId;
 }
 
-int FunctionProcessor::processCXXConversion(const CXXConversionDecl *decl) {
+int64_t FunctionProcessor::processCXXConversion(const CXXConversionDecl *decl) {
+  PROCESSOR_SCOPE();
   handleBaseFunc(cast<FunctionDecl>(decl), FuncType::CONVERSION_FUNC);
   return _funcId;
 }
 
-int FunctionProcessor::processCXXDeductionGuide(
+int64_t FunctionProcessor::processCXXDeductionGuide(
     const CXXDeductionGuideDecl *decl) {
+  PROCESSOR_SCOPE();
   handleBaseFunc(cast<FunctionDecl>(decl), FuncType::DEDUCTION_GUIDE);
   KeyType key = KeyGen::Type::makeKey(decl->getDeducedTemplate(), ast_context_);
   LOG_DEBUG << "Deduction Guide Key: " << key << std::endl;
@@ -426,13 +407,9 @@ int FunctionProcessor::processCXXDeductionGuide(
   } else {
     DbModel::DeductionGuideForClass deducGuide = {_funcId, -1};
     STG.insertClassObj(deducGuide);
-    PendingUpdate update{key, CacheType::USERTYPE,
-                         [_funcId = _funcId](int resolvedId) {
-                           DbModel::DeductionGuideForClass updated_record = {
-                               _funcId, resolvedId};
-                           STG.insertClassObj(updated_record);
-                         }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        key, CacheType::USERTYPE, deducGuide,
+        &DbModel::DeductionGuideForClass::class_template);
   }
   return _funcId;
 }
@@ -11,19 +11,20 @@
 #include <clang/AST/Type.h>
 #include <string>
 
-std::string InheritanceProcessor::makeDerivationKey(int sub_id, int index,
-                                                    int super_id) {
+std::string InheritanceProcessor::makeDerivationKey(int64_t sub_id, int index,
+                                                    int64_t super_id) {
   return std::to_string(sub_id) + ":" + std::to_string(index) + ":" +
          std::to_string(super_id);
 }
 
 void InheritanceProcessor::processCXXRecordDecl(
     const clang::CXXRecordDecl *decl) {
+  PROCESSOR_SCOPE();
   const clang::CXXRecordDecl *definition = getProcessableDefinition(decl);
   if (!definition || !type_processor_)
     return;
 
-  const int subId = resolveRecordTypeId(definition);
+  const int64_t subId = resolveRecordTypeId(definition);
   if (subId == -1)
     return;
 
@@ -47,7 +48,7 @@ InheritanceProcessor::getProcessableDefinition(
   return definition;
 }
 
-int InheritanceProcessor::resolveRecordTypeId(
+int64_t InheritanceProcessor::resolveRecordTypeId(
     const clang::CXXRecordDecl *decl) {
   if (!decl || !type_processor_)
     return -1;
@@ -59,7 +60,7 @@ int InheritanceProcessor::resolveRecordTypeId(
   return type_processor_->processRecordDeclType(decl);
 }
 
-int InheritanceProcessor::resolveBaseTypeId(
+int64_t InheritanceProcessor::resolveBaseTypeId(
     const clang::CXXBaseSpecifier &base, bool &is_dependent,
     std::string &dependent_super_name) {
   is_dependent = false;
@@ -90,13 +91,14 @@ int InheritanceProcessor::resolveBaseTypeId(
 }
 
 void InheritanceProcessor::processBaseSpecifier(
-    const clang::CXXBaseSpecifier &base, int index, int sub_id) {
+    const clang::CXXBaseSpecifier &base, int index, int64_t sub_id) {
   if (sub_id == -1 || base.isPackExpansion())
     return;
 
   bool isDependent = false;
   std::string dependentSuperName;
-  const int superId = resolveBaseTypeId(base, isDependent, dependentSuperName);
+  const int64_t superId =
+      resolveBaseTypeId(base, isDependent, dependentSuperName);
   if (superId == -1)
     return;
 
@@ -108,13 +110,11 @@ void InheritanceProcessor::processBaseSpecifier(
   if (repo.find(key))
     return;
 
-  int locationId = -1;
+  int64_t locationId = -1;
   if (base.getBeginLoc().isValid() && base.getEndLoc().isValid()) {
-    LocIdPair *locIdPair =
-        SrcLocRecorder::processDefault(base.getBeginLoc(), base.getEndLoc(),
-                                       ast_context_);
-    if (locIdPair)
-      locationId = locIdPair->spec_id;
+    locationId = SrcLocRecorder::processDefault(base.getBeginLoc(),
+                                                base.getEndLoc(), ast_context_)
+                     .spec_id;
   }
 
   DbModel::Derivation derivation = {GENID(Derivation),
@@ -124,18 +124,19 @@ void InheritanceProcessor::processBaseSpecifier(
                                     locationId,
                                     isDependent ? 1 : 0,
                                     dependentSuperName};
-  repo.insert(key, derivation.id);
+  if (repo.insert(key, derivation.id) != derivation.id)
+    return; // 其他工作线程已记录同一继承关系
   STG.insertClassObj(derivation);
 
   recordDerivationSpecifiers(derivation.id, base);
 }
 
 void InheritanceProcessor::recordDerivationSpecifiers(
-    int derivation_id, const clang::CXXBaseSpecifier &base) {
+    int64_t derivation_id, const clang::CXXBaseSpecifier &base) {
   if (derivation_id == -1 || !specifier_processor_)
     return;
 
-  for (int specId : specifier_processor_->processBaseSpecifiers(base)) {
+  for (int64_t specId : specifier_processor_->processBaseSpecifiers(base)) {
     DbModel::DerSpecifier derSpecifier = {derivation_id, specId};
     STG.insertClassObj(derSpecifier);
   }
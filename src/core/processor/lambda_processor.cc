@@ -19,10 +19,11 @@ Lambda_Processor::~Lambda_Processor() {
 }
 
 void Lambda_Processor::processLambdaExpr(clang::LambdaExpr *expr) {
+  PROCESSOR_SCOPE();
   if (!expr)
     return;
 
-  int lambdaExprId = getOrCreateLambdaExprId(expr);
+  int64_t lambdaExprId = getOrCreateLambdaExprId(expr);
   if (lambdaExprId == -1)
     return;
 
@@ -36,7 +37,7 @@ void Lambda_Processor::processLambdaExpr(clang::LambdaExpr *expr) {
   }
 }
 
-int Lambda_Processor::getOrCreateLambdaExprId(clang::LambdaExpr *expr) {
+int64_t Lambda_Processor::getOrCreateLambdaExprId(clang::LambdaExpr *expr) {
   if (!expr || !ast_context_)
     return -1;
 
@@ -44,15 +45,15 @@ int Lambda_Processor::getOrCreateLambdaExprId(clang::LambdaExpr *expr) {
   if (auto cachedId = SEARCH_EXPR_CACHE(exprKey))
     return *cachedId;
 
-  LocIdPair *locIdPair = SrcLocRecorder::processExpr(expr, ast_context_);
-  int locationId = locIdPair ? locIdPair->spec_id : -1;
+  int64_t locationId = SrcLocRecorder::processExpr(expr, ast_context_).spec_id;
 
   DbModel::Expr exprModel = {GENID(Expr),
                              static_cast<int>(ExprKind::LAMBDAEXPR),
                              locationId};
-  INSERT_EXPR_CACHE(exprKey, exprModel.id);
-  STG.insertClassObj(exprModel);
-  return exprModel.id;
+  const int64_t exprId = INSERT_EXPR_CACHE(exprKey, exprModel.id);
+  if (exprId == exprModel.id)
+    STG.insertClassObj(exprModel);
+  return exprId;
 }
 
 std::string
@@ -73,7 +74,7 @@ Lambda_Processor::getDefaultCaptureString(const clang::LambdaExpr *expr) const {
 }
 
 void Lambda_Processor::recordCaptures(const clang::LambdaExpr *expr,
-                                      int lambdaExprId) {
+                                      int64_t lambdaExprId) {
   if (!expr || lambdaExprId == -1)
     return;
 
@@ -82,14 +83,14 @@ void Lambda_Processor::recordCaptures(const clang::LambdaExpr *expr,
                            unsigned captureIndex) {
     const clang::FieldDecl *field =
         resolveCaptureField(expr, capture, captureIndex);
-    int fieldId = resolveCaptureFieldId(field);
+    int64_t fieldId = resolveCaptureFieldId(field);
     if (fieldId == -1) {
       LOG_DEBUG << "Skipping lambda capture without stable member field"
                 << std::endl;
       return;
     }
 
-    int locationId = getCaptureLocationId(capture);
+    int64_t locationId = getCaptureLocationId(capture);
     if (locationId == -1) {
       LOG_DEBUG << "Skipping lambda capture without stable source location"
                 << std::endl;
@@ -127,7 +128,7 @@ void Lambda_Processor::recordCaptures(const clang::LambdaExpr *expr,
 }
 
 void Lambda_Processor::recordFieldOnlyCaptures(const clang::LambdaExpr *expr,
-                                               int lambdaExprId) {
+                                               int64_t lambdaExprId) {
   if (!expr || lambdaExprId == -1)
     return;
 
@@ -142,8 +143,8 @@ void Lambda_Processor::recordFieldOnlyCaptures(const clang::LambdaExpr *expr,
       continue;
     }
 
-    int fieldId = resolveCaptureFieldId(field);
-    int locationId = getFieldLocationId(field);
+    int64_t fieldId = resolveCaptureFieldId(field);
+    int64_t locationId = getFieldLocationId(field);
     if (fieldId == -1 || locationId == -1) {
       ++fieldIndex;
       continue;
@@ -209,16 +210,16 @@ const clang::FieldDecl *Lambda_Processor::resolveCaptureFieldByIndex(
   return nullptr;
 }
 
-int Lambda_Processor::resolveCaptureFieldId(
+int64_t Lambda_Processor::resolveCaptureFieldId(
     const clang::FieldDecl *field) const {
   if (!field || !type_processor_ || !variable_processor_)
     return -1;
 
-  int typeId = type_processor_->processType(field->getType().getTypePtr());
+  int64_t typeId = type_processor_->processType(field->getType().getTypePtr());
   return variable_processor_->resolveMemberVarId(field, typeId);
 }
 
-int Lambda_Processor::getCaptureLocationId(
+int64_t Lambda_Processor::getCaptureLocationId(
     const clang::LambdaCapture *capture) const {
   if (!capture || !ast_context_)
     return -1;
@@ -227,11 +228,11 @@ int Lambda_Processor::getCaptureLocationId(
   if (loc.isInvalid())
     return -1;
 
-  LocIdPair *locIdPair = SrcLocRecorder::processDefault(loc, loc, ast_context_);
-  return locIdPair ? locIdPair->spec_id : -1;
+  return SrcLocRecorder::processDefault(loc, loc, ast_context_).spec_id;
 }
 
-int Lambda_Processor::getFieldLocationId(const clang::FieldDecl *field) const {
+int64_t Lambda_Processor::getFieldLocationId(
+    const clang::FieldDecl *field) const {
   if (!field || !ast_context_)
     return -1;
 
@@ -239,8 +240,7 @@ int Lambda_Processor::getFieldLocationId(const clang::FieldDecl *field) const {
   if (loc.isInvalid())
     return -1;
 
-  LocIdPair *locIdPair = SrcLocRecorder::processDefault(loc, loc, ast_context_);
-  return locIdPair ? locIdPair->spec_id : -1;
+  return SrcLocRecorder::processDefault(loc, loc, ast_context_).spec_id;
 }
 
 bool Lambda_Processor::isCapturedByReference(
@@ -13,6 +13,7 @@
 
 void NamespaceProcessor::processNamespaceDecl(
     const clang::NamespaceDecl *decl) {
+  PROCESSOR_SCOPE();
   // Process the namespace itself
   processNamespace(decl);
 
@@ -29,20 +30,23 @@ void NamespaceProcessor::processNamespaceDecl(
 }
 
 void NamespaceProcessor::processUsingDecl(const clang::UsingDecl *decl) {
+  PROCESSOR_SCOPE();
   recordUsing(decl, 1);
 }
 
 void NamespaceProcessor::processUsingDirectiveDecl(
     const clang::UsingDirectiveDecl *decl) {
+  PROCESSOR_SCOPE();
   recordUsing(decl, 2);
 }
 
 void NamespaceProcessor::processUnresolvedUsingTypenameDecl(
     const clang::UnresolvedUsingTypenameDecl *decl) {
+  PROCESSOR_SCOPE();
   recordUsing(decl, 1);
 }
 
-int NamespaceProcessor::getOrCreateNamespaceId(
+int64_t NamespaceProcessor::getOrCreateNamespaceId(
     const clang::NamespaceDecl *decl) {
   if (!decl) {
     return -1;
@@ -54,7 +58,7 @@ int NamespaceProcessor::getOrCreateNamespaceId(
     return existing->second;
   }
 
-  int namespace_id = GENID(Namespace);
+  int64_t namespace_id = GENID(Namespace);
   std::string name = canonical_decl->getNameAsString();
 
   DbModel::Namespace namespace_record = {namespace_id, name};
@@ -72,21 +76,20 @@ void NamespaceProcessor::processNamespace(const clang::NamespaceDecl *decl) {
 
 void NamespaceProcessor::recordNamespaceDecl(
     const clang::NamespaceDecl *decl) {
-  int namespace_id = getOrCreateNamespaceId(decl);
+  int64_t namespace_id = getOrCreateNamespaceId(decl);
   if (namespace_id < 0) {
     return;
   }
 
-  LocIdPair *decl_loc = PROC_DEFT(decl, ast_context_);
+  LocIdPair decl_loc = PROC_DEFT(decl, ast_context_);
   clang::SourceLocation rbrace_loc = decl->getRBraceLoc();
   if (rbrace_loc.isInvalid()) {
     rbrace_loc = decl->getEndLoc();
   }
-  LocIdPair *body_loc = PROC_DEFT(rbrace_loc, rbrace_loc, ast_context_);
+  LocIdPair body_loc = PROC_DEFT(rbrace_loc, rbrace_loc, ast_context_);
 
   DbModel::NamespaceDecl namespace_decl_record = {
-      GENID(NamespaceDecl), namespace_id, decl_loc ? decl_loc->spec_id : -1,
-      body_loc ? body_loc->spec_id : -1};
+      GENID(NamespaceDecl), namespace_id, decl_loc.spec_id, body_loc.spec_id};
 
   StorageFacade::getInstance().insertClassObj(namespace_decl_record);
 
@@ -97,7 +100,7 @@ void NamespaceProcessor::recordNamespaceDecl(
 
 void NamespaceProcessor::processNamespaceInline(
     const clang::NamespaceDecl *decl) {
-  int namespace_id = getOrCreateNamespaceId(decl);
+  int64_t namespace_id = getOrCreateNamespaceId(decl);
   if (namespace_id < 0) {
     return;
   }
@@ -128,9 +131,8 @@ void NamespaceProcessor::recordUsing(const clang::Decl *decl, int kind) {
     return;
   }
 
-  LocIdPair *decl_loc = PROC_DEFT(decl, ast_context_);
-  DbModel::Using using_record = {GENID(Using), -1,
-                                 decl_loc ? decl_loc->spec_id : -1, kind};
+  LocIdPair decl_loc = PROC_DEFT(decl, ast_context_);
+  DbModel::Using using_record = {GENID(Using), -1, decl_loc.spec_id, kind};
 
   StorageFacade::getInstance().insertClassObj(using_record);
 
@@ -146,7 +148,7 @@ void NamespaceProcessor::recordUsing(const clang::Decl *decl, int kind) {
             << " and kind: " << kind << std::endl;
 }
 
-std::optional<int> NamespaceProcessor::resolveUsingOwnerElement(
+std::optional<int64_t> NamespaceProcessor::resolveUsingOwnerElement(
     const clang::DeclContext *context) {
   if (!context) {
     return std::nullopt;
@@ -154,7 +156,7 @@ std::optional<int> NamespaceProcessor::resolveUsingOwnerElement(
 
   if (const auto *namespace_decl =
           llvm::dyn_cast<clang::NamespaceDecl>(context)) {
-    int namespace_id = getOrCreateNamespaceId(namespace_decl);
+    int64_t namespace_id = getOrCreateNamespaceId(namespace_decl);
     if (namespace_id >= 0) {
       return namespace_id;
     }
@@ -170,12 +172,12 @@ std::optional<int> NamespaceProcessor::resolveUsingOwnerElement(
 
 void NamespaceProcessor::processNamespaceMember(
     const clang::NamespaceDecl *parent_ns, const clang::Decl *member) {
-  int parent_id = getOrCreateNamespaceId(parent_ns);
+  int64_t parent_id = getOrCreateNamespaceId(parent_ns);
   if (parent_id < 0) {
     return;
   }
 
-  int member_id = -1;
+  int64_t member_id = -1;
   if (const auto *member_ns =
           llvm::dyn_cast_or_null<clang::NamespaceDecl>(member)) {
     member_id = getOrCreateNamespaceId(member_ns);
@@ -15,7 +15,8 @@ using namespace DbModel;
 PreprocessorProcessor::PreprocessorProcessor(ASTContext *ast_context,
                                              const PrintingPolicy pp,
                                              class Preprocessor *preprocessor)
-    : BaseProcessor(ast_context, pp), preprocessor_(preprocessor) {
+    : BaseProcessor(ast_context, pp, ProcessorKind::Preprocessor),
+      preprocessor_(preprocessor) {
   LOG_INFO << "PreprocessorProcessor initialized" << std::endl;
 }
 
@@ -26,9 +27,10 @@ PreprocessorProcessor::PreprocessorProcessor(ASTContext *ast_context,
 void PreprocessorProcessor::Ifndef(SourceLocation Loc,
                                    const Token &MacroNameTok,
                                    const MacroDefinition &MD) {
+  PROCESSOR_SCOPE();
   recordMacroInvocation(MacroNameTok, Loc, kOtherMacroReferenceKind);
 
-  int dir_id = processDirective(Loc, PreprocDirectKind::IFNDEF);
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::IFNDEF);
   branch_stack_.push({dir_id, PreprocDirectKind::IFNDEF, Loc});
 
   // #ifndef macro is NOT defined -> branch is true
@@ -40,9 +42,10 @@ void PreprocessorProcessor::Ifndef(SourceLocation Loc,
 
 void PreprocessorProcessor::Ifdef(SourceLocation Loc, const Token &MacroNameTok,
                                   const MacroDefinition &MD) {
+  PROCESSOR_SCOPE();
   recordMacroInvocation(MacroNameTok, Loc, kOtherMacroReferenceKind);
 
-  int dir_id = processDirective(Loc, PreprocDirectKind::IFDEF);
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::IFDEF);
   branch_stack_.push({dir_id, PreprocDirectKind::IFDEF, Loc});
 
   // #ifdef macro IS defined -> branch is true
@@ -54,7 +57,8 @@ void PreprocessorProcessor::Ifdef(SourceLocation Loc, const Token &MacroNameTok,
 
 void PreprocessorProcessor::If(SourceLocation Loc, SourceRange ConditionRange,
                                ConditionValueKind ConditionValue) {
-  int dir_id = processDirective(Loc, PreprocDirectKind::IF);
+  PROCESSOR_SCOPE();
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::IF);
   branch_stack_.push({dir_id, PreprocDirectKind::IF, Loc});
 
   // Check if condition evaluated to true
@@ -67,7 +71,8 @@ void PreprocessorProcessor::If(SourceLocation Loc, SourceRange ConditionRange,
 void PreprocessorProcessor::Elif(SourceLocation Loc, SourceRange ConditionRange,
                                  ConditionValueKind ConditionValue,
                                  SourceLocation IfLoc) {
-  int dir_id = processDirective(Loc, PreprocDirectKind::ELIF);
+  PROCESSOR_SCOPE();
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::ELIF);
 
   // Pop the previous branch (if/elif) and record pair
   if (!branch_stack_.empty()) {
@@ -87,7 +92,8 @@ void PreprocessorProcessor::Elif(SourceLocation Loc, SourceRange ConditionRange,
 }
 
 void PreprocessorProcessor::Else(SourceLocation Loc, SourceLocation IfLoc) {
-  int dir_id = processDirective(Loc, PreprocDirectKind::ELSE);
+  PROCESSOR_SCOPE();
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::ELSE);
 
   // Pop the previous branch (if/elif) and record pair
   if (!branch_stack_.empty()) {
@@ -103,7 +109,8 @@ void PreprocessorProcessor::Else(SourceLocation Loc, SourceLocation IfLoc) {
 }
 
 void PreprocessorProcessor::Endif(SourceLocation Loc, SourceLocation IfLoc) {
-  int dir_id = processDirective(Loc, PreprocDirectKind::ENDIF);
+  PROCESSOR_SCOPE();
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::ENDIF);
 
   // Pop the previous branch (if/elif/else) and record pair
   if (!branch_stack_.empty()) {
@@ -124,6 +131,7 @@ void PreprocessorProcessor::InclusionDirective(
     bool IsAngled, CharSourceRange FilenameRange, OptionalFileEntryRef File,
     StringRef SearchPath, StringRef RelativePath, const Module *SuggestedModule,
     bool ModuleImported, SrcMgr::CharacteristicKind FileType) {
+  PROCESSOR_SCOPE();
 
   // Determine include kind
   PreprocDirectKind kind;
@@ -142,13 +150,13 @@ void PreprocessorProcessor::InclusionDirective(
     break;
   }
 
-  int dir_id = processDirective(HashLoc, kind);
+  int64_t dir_id = processDirective(HashLoc, kind);
   extractDirectiveText(HashLoc, dir_id, kind);
 
   // Resolve and record included file
   if (File) {
     std::string included_path = File->getName().str();
-    int file_id = resolveIncludeFile(included_path);
+    int64_t file_id = resolveIncludeFile(included_path);
 
     Includes include = {dir_id, file_id};
     STG.insertClassObj(include);
@@ -163,10 +171,11 @@ void PreprocessorProcessor::MacroExpands(const Token &MacroNameTok,
                                          const MacroDefinition &MD,
                                          SourceRange Range,
                                          const MacroArgs *Args) {
+  PROCESSOR_SCOPE();
   (void)MD;
 
   SourceLocation child_loc = Range.getBegin();
-  int invocation_id =
+  int64_t invocation_id =
       recordMacroInvocation(MacroNameTok, child_loc, kMacroExpansionKind);
   if (invocation_id < 0) {
     return;
@@ -182,7 +191,7 @@ void PreprocessorProcessor::MacroExpands(const Token &MacroNameTok,
       unsigned parent_key = makeMacroLocationKey(parent_loc);
       auto parent_it = macro_invocation_by_loc_key_.find(parent_key);
       if (parent_it != macro_invocation_by_loc_key_.end()) {
-        int parent_id = parent_it->second;
+        int64_t parent_id = parent_it->second;
         if (parent_id != invocation_id &&
             shouldInsertMacroParentRow(invocation_id)) {
           MacroParent parent_row = {invocation_id, parent_id};
@@ -211,13 +220,13 @@ void PreprocessorProcessor::MacroExpands(const Token &MacroNameTok,
 
     if (shouldInsertMacroArgumentRow(invocation_id, static_cast<int>(i), false)) {
       MacroArgumentUnexpanded unexpanded_row = {
-          invocation_id, static_cast<int>(i), unexpanded_text};
+          invocation_id, static_cast<int>(i), INTERN(unexpanded_text)};
       STG.insertClassObj(unexpanded_row);
     }
 
     if (shouldInsertMacroArgumentRow(invocation_id, static_cast<int>(i), true)) {
       MacroArgumentExpanded expanded_row = {
-          invocation_id, static_cast<int>(i), expanded_text};
+          invocation_id, static_cast<int>(i), INTERN(expanded_text)};
       STG.insertClassObj(expanded_row);
     }
   }
@@ -225,6 +234,7 @@ void PreprocessorProcessor::MacroExpands(const Token &MacroNameTok,
 
 void PreprocessorProcessor::MacroDefined(const Token &MacroNameTok,
                                          const MacroDirective *MD) {
+  PROCESSOR_SCOPE();
   const auto *identifier = MacroNameTok.getIdentifierInfo();
   if (!identifier)
     return;
@@ -238,8 +248,9 @@ void PreprocessorProcessor::MacroDefined(const Token &MacroNameTok,
     return;
 
   const std::string macro_name = identifier->getName().str();
-  int dir_id = processDirective(Loc, PreprocDirectKind::DEFINE, macro_name);
-  macro_define_id_by_name_[macro_name] = dir_id;
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::DEFINE, macro_name);
+  const InternedString interned_name = INTERN(macro_name);
+  macro_define_id_by_name_[interned_name] = dir_id;
 
   // Build macro body directly from MacroInfo replacement tokens.
   std::string macro_body;
@@ -260,13 +271,14 @@ void PreprocessorProcessor::MacroDefined(const Token &MacroNameTok,
     }
   }
 
-  Preproctext text = {dir_id, macro_name, macro_body};
+  Preproctext text = {dir_id, interned_name, INTERN(macro_body)};
   STG.insertClassObj(text);
 }
 
 void PreprocessorProcessor::MacroUndefined(const Token &MacroNameTok,
                                            const MacroDefinition &MD,
                                            const MacroDirective *Undef) {
+  PROCESSOR_SCOPE();
   (void)MD;
   (void)Undef;
 
@@ -274,18 +286,19 @@ void PreprocessorProcessor::MacroUndefined(const Token &MacroNameTok,
                         kOtherMacroReferenceKind);
 
   if (const auto *identifier = MacroNameTok.getIdentifierInfo()) {
-    macro_define_id_by_name_.erase(identifier->getName().str());
+    macro_define_id_by_name_.erase(identifier->getName());
   }
 
   // Keep UNDEF behavior unchanged: record directive and raw text only.
   SourceLocation Loc = MacroNameTok.getLocation();
-  int dir_id = processDirective(Loc, PreprocDirectKind::UNDEF);
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::UNDEF);
   extractDirectiveText(Loc, dir_id, PreprocDirectKind::UNDEF);
 }
 
 void PreprocessorProcessor::Defined(const Token &MacroNameTok,
                                     const MacroDefinition &MD,
                                     SourceRange Range) {
+  PROCESSOR_SCOPE();
   (void)MD;
   recordMacroInvocation(MacroNameTok, Range.getBegin(), kOtherMacroReferenceKind);
 }
@@ -296,7 +309,8 @@ void PreprocessorProcessor::Defined(const Token &MacroNameTok,
 
 void PreprocessorProcessor::PragmaDirective(SourceLocation Loc,
                                             PragmaIntroducerKind Introducer) {
-  int dir_id = processDirective(Loc, PreprocDirectKind::PRAGMA);
+  PROCESSOR_SCOPE();
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::PRAGMA);
   extractDirectiveText(Loc, dir_id, PreprocDirectKind::PRAGMA);
 }
 
@@ -304,16 +318,18 @@ void PreprocessorProcessor::PragmaMessage(SourceLocation Loc,
                                           StringRef Namespace,
                                           PragmaMessageKind Kind,
                                           StringRef Str) {
+  PROCESSOR_SCOPE();
   // #pragma warning or #pragma message
   PreprocDirectKind kind = (Kind == PMK_Warning) ? PreprocDirectKind::WARNING
                                                  : PreprocDirectKind::ERROR;
-  int dir_id = processDirective(Loc, kind);
+  int64_t dir_id = processDirective(Loc, kind);
   extractDirectiveText(Loc, dir_id, kind);
 }
 
 void PreprocessorProcessor::PragmaDebug(SourceLocation Loc,
                                         StringRef DebugType) {
-  int dir_id = processDirective(Loc, PreprocDirectKind::PRAGMA);
+  PROCESSOR_SCOPE();
+  int64_t dir_id = processDirective(Loc, PreprocDirectKind::PRAGMA);
   extractDirectiveText(Loc, dir_id, PreprocDirectKind::PRAGMA);
 }
 
@@ -321,9 +337,9 @@ void PreprocessorProcessor::PragmaDebug(SourceLocation Loc,
 // Helper Methods
 //////////////////////////////////////////////////////////////////////////////
 
-int PreprocessorProcessor::processDirective(SourceLocation Loc,
-                                            PreprocDirectKind kind,
-                                            const std::string &key_suffix) {
+int64_t PreprocessorProcessor::processDirective(SourceLocation Loc,
+                                                PreprocDirectKind kind,
+                                                const std::string &key_suffix) {
   const SourceManager &SM = preprocessor_->getSourceManager();
   // Normalize to file location for stable key generation.
   SourceLocation file_loc = SM.getFileLoc(Loc);
@@ -340,16 +356,18 @@ int PreprocessorProcessor::processDirective(SourceLocation Loc,
   }
 
   // Generate ID and create directive
-  int dir_id = GENID(Preprocdirect);
+  int64_t dir_id = GENID(Preprocdirect);
 
   // Record location (preprocessor directives are at a single location)
-  LocIdPair *loc_pair = PROC_DEFT(Loc, Loc, ast_context_);
+  LocIdPair loc_pair = PROC_DEFT(Loc, Loc, ast_context_);
 
-  Preprocdirect directive = {dir_id, static_cast<int>(kind), loc_pair->spec_id};
-  STG.insertClassObj(directive);
+  // Insert into cache, 并发登记同一指令时沿用胜出的ID
+  if (const int64_t winner = INSERT_PREPROC_CACHE(key, dir_id);
+      winner != dir_id)
+    return winner;
 
-  // Insert into cache
-  INSERT_PREPROC_CACHE(key, dir_id);
+  Preprocdirect directive = {dir_id, static_cast<int>(kind), loc_pair.spec_id};
+  STG.insertClassObj(directive);
 
   LOG_DEBUG << "Preprocessor directive kind=" << static_cast<int>(kind)
             << " id=" << dir_id << std::endl;
@@ -358,7 +376,7 @@ int PreprocessorProcessor::processDirective(SourceLocation Loc,
 }
 
 void PreprocessorProcessor::extractDirectiveText(SourceLocation Loc,
-                                                 int directive_id,
+                                                 int64_t directive_id,
                                                  PreprocDirectKind kind) {
   const SourceManager &SM = ast_context_->getSourceManager();
 
@@ -410,11 +428,11 @@ void PreprocessorProcessor::extractDirectiveText(SourceLocation Loc,
     }
   }
 
-  Preproctext text = {directive_id, head, body};
+  Preproctext text = {directive_id, INTERN(head), INTERN(body)};
   STG.insertClassObj(text);
 }
 
-void PreprocessorProcessor::recordBranchPair(int begin_id, int end_id) {
+void PreprocessorProcessor::recordBranchPair(int64_t begin_id, int64_t end_id) {
   Preprocpair pair = {begin_id, end_id};
   STG.insertClassObj(pair);
 
@@ -422,7 +440,7 @@ void PreprocessorProcessor::recordBranchPair(int begin_id, int end_id) {
             << std::endl;
 }
 
-void PreprocessorProcessor::recordBranchEvaluation(int branch_id,
+void PreprocessorProcessor::recordBranchEvaluation(int64_t branch_id,
                                                    bool is_true) {
   // Persist branch evaluation result for control-flow reconstruction.
   branch_evaluation_[branch_id] = is_true;
@@ -436,11 +454,11 @@ void PreprocessorProcessor::recordBranchEvaluation(int branch_id,
   }
 }
 
-int PreprocessorProcessor::resolveIncludeFile(const std::string &filename) {
+int64_t PreprocessorProcessor::resolveIncludeFile(const std::string &filename) {
   // For now, create a new file entry each time
   // TODO: Check if file already exists in database to avoid duplicates
 
-  int file_id = GENID(File);
+  int64_t file_id = GENID(File);
   // Store only basename to keep file table compact and stable.
   std::string file_name = std::filesystem::path(filename).filename().string();
 
@@ -508,7 +526,7 @@ PreprocessorProcessor::tokensToText(const std::vector<Token> &tokens) const {
   return text;
 }
 
-bool PreprocessorProcessor::shouldInsertMacroArgumentRow(int invocation_id,
+bool PreprocessorProcessor::shouldInsertMacroArgumentRow(int64_t invocation_id,
                                                          int argument_index,
                                                          bool is_expanded) {
   const std::string key =
@@ -517,14 +535,14 @@ bool PreprocessorProcessor::shouldInsertMacroArgumentRow(int invocation_id,
   return macro_argument_dedup_cache_.insert(key).second;
 }
 
-bool PreprocessorProcessor::shouldInsertMacroLocationBindRow(int invocation_id,
-                                                             int location_id) {
+bool PreprocessorProcessor::shouldInsertMacroLocationBindRow(
+    int64_t invocation_id, int64_t location_id) {
   const std::string key =
       std::to_string(invocation_id) + ":" + std::to_string(location_id);
   return macrolocationbind_dedup_cache_.insert(key).second;
 }
 
-bool PreprocessorProcessor::shouldInsertMacroParentRow(int child_id) {
+bool PreprocessorProcessor::shouldInsertMacroParentRow(int64_t child_id) {
   return macroparent_child_dedup_cache_.insert(child_id).second;
 }
 
@@ -535,14 +553,15 @@ unsigned PreprocessorProcessor::makeMacroLocationKey(SourceLocation loc) const {
   return loc.getRawEncoding();
 }
 
-int PreprocessorProcessor::recordMacroInvocation(const Token &MacroNameTok,
-                                                 SourceLocation Loc, int kind) {
+int64_t PreprocessorProcessor::recordMacroInvocation(const Token &MacroNameTok,
+                                                     SourceLocation Loc,
+                                                     int kind) {
   const auto *identifier = MacroNameTok.getIdentifierInfo();
   if (!identifier) {
     return -1;
   }
 
-  auto it = macro_define_id_by_name_.find(identifier->getName().str());
+  auto it = macro_define_id_by_name_.find(identifier->getName());
   if (it == macro_define_id_by_name_.end()) {
     return -1;
   }
@@ -553,14 +572,14 @@ int PreprocessorProcessor::recordMacroInvocation(const Token &MacroNameTok,
     return -1;
   }
 
-  LocIdPair *loc_pair = PROC_DEFT(file_loc, file_loc, ast_context_);
-  int invocation_id = GENID(MacroInvocation);
-  MacroInvocation invocation = {invocation_id, it->second, loc_pair->spec_id, kind};
+  LocIdPair loc_pair = PROC_DEFT(file_loc, file_loc, ast_context_);
+  int64_t invocation_id = GENID(MacroInvocation);
+  MacroInvocation invocation = {invocation_id, it->second, loc_pair.spec_id, kind};
   STG.insertClassObj(invocation);
 
   if (loc_pair &&
-      shouldInsertMacroLocationBindRow(invocation_id, loc_pair->location_id)) {
-    MacroLocationBind location_bind = {invocation_id, loc_pair->location_id};
+      shouldInsertMacroLocationBindRow(invocation_id, loc_pair.location_id)) {
+    MacroLocationBind location_bind = {invocation_id, loc_pair.location_id};
     STG.insertClassObj(location_bind);
   }
   return invocation_id;
@@ -26,11 +26,12 @@
 
 void RecordLayoutProcessor::processCXXRecordDecl(
     const clang::CXXRecordDecl *decl) {
+  PROCESSOR_SCOPE();
   const clang::CXXRecordDecl *definition = getLayoutReadyDefinition(decl);
   if (!definition || !type_processor_)
     return;
 
-  const int subId = resolveRecordTypeId(definition);
+  const int64_t subId = resolveRecordTypeId(definition);
   if (subId == -1)
     return;
 
@@ -70,7 +71,7 @@ const clang::CXXRecordDecl *RecordLayoutProcessor::getLayoutReadyDefinition(
   return definition;
 }
 
-int RecordLayoutProcessor::resolveRecordTypeId(
+int64_t RecordLayoutProcessor::resolveRecordTypeId(
     const clang::CXXRecordDecl *decl) {
   if (!decl || !type_processor_)
     return -1;
@@ -82,9 +83,8 @@ int RecordLayoutProcessor::resolveRecordTypeId(
   return type_processor_->processRecordDeclType(decl);
 }
 
-std::optional<int> RecordLayoutProcessor::findDerivationId(int sub_id,
-                                                           int index,
-                                                           int super_id) {
+std::optional<int64_t> RecordLayoutProcessor::findDerivationId(
+    int64_t sub_id, int index, int64_t super_id) {
   const std::string key =
       InheritanceProcessor::makeDerivationKey(sub_id, index, super_id);
   return CacheManager::instance()
@@ -134,7 +134,7 @@ int RecordLayoutProcessor::toIntFlag(bool value) const { return value ? 1 : 0; }
 
 void RecordLayoutProcessor::recordLayoutMetadata(
     const clang::CXXRecordDecl *decl, const clang::ASTRecordLayout &layout,
-    int sub_id) {
+    int64_t sub_id) {
   if (!decl || sub_id == -1 || !ast_context_)
     return;
 
@@ -160,7 +160,7 @@ void RecordLayoutProcessor::recordLayoutMetadata(
 
 void RecordLayoutProcessor::recordDirectBaseOffsets(
     const clang::CXXRecordDecl *decl, const clang::ASTRecordLayout &layout,
-    int sub_id) {
+    int64_t sub_id) {
   if (!decl || sub_id == -1)
     return;
 
@@ -189,8 +189,8 @@ void RecordLayoutProcessor::recordDirectBaseOffsets(
       continue;
     }
 
-    const int superId = resolveRecordTypeId(baseDefinition);
-    const std::optional<int> derivationId =
+    const int64_t superId = resolveRecordTypeId(baseDefinition);
+    const std::optional<int64_t> derivationId =
         findDerivationId(sub_id, index, superId);
     if (!derivationId) {
       LOG_WARNING << "Skipping direct base offset because derivation was not "
@@ -225,7 +225,7 @@ void RecordLayoutProcessor::recordDirectBaseOffsets(
 
 void RecordLayoutProcessor::recordVirtualBaseOffsets(
     const clang::CXXRecordDecl *decl, const clang::ASTRecordLayout &layout,
-    int sub_id) {
+    int64_t sub_id) {
   if (!decl || sub_id == -1)
     return;
 
@@ -245,7 +245,7 @@ void RecordLayoutProcessor::recordVirtualBaseOffsets(
     if (!baseDefinition)
       continue;
 
-    const int superId = resolveRecordTypeId(baseDefinition);
+    const int64_t superId = resolveRecordTypeId(baseDefinition);
     if (superId == -1)
       continue;
 
@@ -272,9 +272,9 @@ void RecordLayoutProcessor::recordFieldOffsets(
     if (fieldIndex >= layout.getFieldCount())
       continue;
 
-    const int typeId =
+    const int64_t typeId =
         type_processor_->processType(field->getType().getTypePtr());
-    const int memberVarId =
+    const int64_t memberVarId =
         variable_processor_->resolveMemberVarId(field, typeId);
     if (memberVarId == -1)
       continue;
@@ -294,7 +294,7 @@ void RecordLayoutProcessor::recordFieldOffsets(
 }
 
 void RecordLayoutProcessor::recordBitField(const clang::FieldDecl *field,
-                                           int member_var_id) {
+                                           int64_t member_var_id) {
   if (!field || member_var_id == -1 || !field->isBitField() ||
       field->isUnnamedBitField() || !ast_context_)
     return;
@@ -307,7 +307,7 @@ void RecordLayoutProcessor::recordBitField(const clang::FieldDecl *field,
 
 void RecordLayoutProcessor::recordFieldLayoutTraits(
     const clang::CXXRecordDecl *parent, const clang::FieldDecl *field,
-    int member_var_id) {
+    int64_t member_var_id) {
   if (!parent || !field || member_var_id == -1 || !ast_context_)
     return;
 
@@ -323,7 +323,7 @@ void RecordLayoutProcessor::recordFieldLayoutTraits(
 }
 
 void RecordLayoutProcessor::recordIndirectFieldPaths(
-    const clang::CXXRecordDecl *decl, int sub_id) {
+    const clang::CXXRecordDecl *decl, int64_t sub_id) {
   if (!decl || sub_id == -1 || !type_processor_ || !variable_processor_)
     return;
 
@@ -336,8 +336,10 @@ void RecordLayoutProcessor::recordIndirectFieldPaths(
     if (!leaf || leaf->isInvalidDecl())
       continue;
 
-    const int typeId = type_processor_->processType(leaf->getType().getTypePtr());
-    const int leafId = variable_processor_->resolveMemberVarId(leaf, typeId);
+    const int64_t typeId =
+        type_processor_->processType(leaf->getType().getTypePtr());
+    const int64_t leafId =
+        variable_processor_->resolveMemberVarId(leaf, typeId);
     if (leafId == -1)
       continue;
 
@@ -7,64 +7,76 @@
 #include <clang/AST/DeclCXX.h>
 #include <vector>
 
-int SpecifierProcessor::getOrCreateSpecifier(const std::string &str) {
+int64_t SpecifierProcessor::getOrCreateSpecifier(const std::string &str) {
   auto &repo = CacheManager::instance()
                    .getRepository<CacheRepository<DbModel::Specifier>>();
   if (auto cachedId = repo.find(str))
     return *cachedId;
 
   DbModel::Specifier specifier = {GENID(Specifier), str};
-  repo.insert(str, specifier.id);
-  STG.insertClassObj(specifier);
-  return specifier.id;
+  const int64_t specId = repo.insert(str, specifier.id);
+  if (specId == specifier.id)
+    STG.insertClassObj(specifier);
+  return specId;
 }
 
-void SpecifierProcessor::processTypeQualifiers(int type_id, QualType qualType) {
+void SpecifierProcessor::processTypeQualifiers(int64_t type_id,
+                                               QualType qualType) {
+  PROCESSOR_SCOPE();
+  const unsigned cvr = qualType.getCVRQualifiers();
+  if (cvr == 0)
+    return;
+  unsigned &recorded = type_qualifiers_[type_id];
+  if ((cvr & ~recorded) == 0)
+    return;
+  recorded |= cvr;
+
   if (qualType.isConstQualified()) {
-    int spec_id = getOrCreateSpecifier("const");
+    int64_t spec_id = getOrCreateSpecifier("const");
     insertTypeSpecifiers(type_id, spec_id);
   }
 
   if (qualType.isVolatileQualified()) {
-    int spec_id = getOrCreateSpecifier("volatile");
+    int64_t spec_id = getOrCreateSpecifier("volatile");
     insertTypeSpecifiers(type_id, spec_id);
   }
 
   if (qualType.isRestrictQualified()) {
-    int spec_id = getOrCreateSpecifier("restrict");
+    int64_t spec_id = getOrCreateSpecifier("restrict");
     insertTypeSpecifiers(type_id, spec_id);
   }
 }
 
-void SpecifierProcessor::processFunctionSpecifiers(int func_id,
+void SpecifierProcessor::processFunctionSpecifiers(int64_t func_id,
                                                    const FunctionDecl *FD) {
+  PROCESSOR_SCOPE();
   // static (仅成员函数)
   if (FD->isStatic()) {
-    int spec_id = getOrCreateSpecifier("static");
+    int64_t spec_id = getOrCreateSpecifier("static");
     insertFunSpecifiers(func_id, spec_id);
   }
 
   // virtual
   if (FD->isVirtualAsWritten()) {
-    int spec_id = getOrCreateSpecifier("virtual");
+    int64_t spec_id = getOrCreateSpecifier("virtual");
     insertFunSpecifiers(func_id, spec_id);
   }
 
   // inline
   if (FD->isInlineSpecified()) {
-    int spec_id = getOrCreateSpecifier("inline");
+    int64_t spec_id = getOrCreateSpecifier("inline");
     insertFunSpecifiers(func_id, spec_id);
   }
 
   // constexpr
   if (FD->isConstexprSpecified()) {
-    int spec_id = getOrCreateSpecifier("constexpr");
+    int64_t spec_id = getOrCreateSpecifier("constexpr");
     insertFunSpecifiers(func_id, spec_id);
   }
 
   // pure virtual (= 0)
   if (FD->isPureVirtual()) {
-    int spec_id = getOrCreateSpecifier("pure_virtual");
+    int64_t spec_id = getOrCreateSpecifier("pure_virtual");
     insertFunSpecifiers(func_id, spec_id);
   }
 
@@ -86,8 +98,9 @@ void SpecifierProcessor::processFunctionSpecifiers(int func_id,
   }
 }
 
-void SpecifierProcessor::processVariableSpecifiers(int var_id,
+void SpecifierProcessor::processVariableSpecifiers(int64_t var_id,
                                                    const VarDecl *VD) {
+  PROCESSOR_SCOPE();
   // 处理存储类说明符（storage class specifiers）
   StorageClass storageClass = VD->getStorageClass();
   if (storageClass != SC_None) {
@@ -164,8 +177,9 @@ void SpecifierProcessor::processVariableSpecifiers(int var_id,
   }
 }
 
-void SpecifierProcessor::processVariableSpecifiers(int var_id,
+void SpecifierProcessor::processVariableSpecifiers(int64_t var_id,
                                                    const FieldDecl *FD) {
+  PROCESSOR_SCOPE();
   // FieldDecl 继承自 DeclaratorDecl，提供类似 VarDecl 的接口
 
   // 处理类型限定符（type qualifiers）
@@ -204,9 +218,10 @@ void SpecifierProcessor::processVariableSpecifiers(int var_id,
   }
 }
 
-std::vector<int>
+std::vector<int64_t>
 SpecifierProcessor::processBaseSpecifiers(const CXXBaseSpecifier &base) {
-  std::vector<int> specIds;
+  PROCESSOR_SCOPE();
+  std::vector<int64_t> specIds;
 
   switch (base.getAccessSpecifier()) {
   case AS_public:
@@ -228,17 +243,18 @@ SpecifierProcessor::processBaseSpecifiers(const CXXBaseSpecifier &base) {
   return specIds;
 }
 
-void SpecifierProcessor::insertTypeSpecifiers(int type_id, int spec_id) {
+void SpecifierProcessor::insertTypeSpecifiers(int64_t type_id,
+                                              int64_t spec_id) {
   DbModel::TypeSpecifiers ts = {type_id, spec_id};
   STG.insertClassObj(ts);
 }
 
-void SpecifierProcessor::insertFunSpecifiers(int func_id, int spec_id) {
+void SpecifierProcessor::insertFunSpecifiers(int64_t func_id, int64_t spec_id) {
   DbModel::FunSpecifiers fs = {func_id, spec_id};
   STG.insertClassObj(fs);
 }
 
-void SpecifierProcessor::insertVarSpecifiers(int var_id, int spec_id) {
+void SpecifierProcessor::insertVarSpecifiers(int64_t var_id, int64_t spec_id) {
   DbModel::VarSpecifiers vs = {var_id, spec_id};
   STG.insertClassObj(vs);
 }
@@ -13,20 +13,22 @@
 #include <clang/AST/StmtCXX.h>
 #include <clang/Basic/LLVM.h>
 
-int StmtProcessor::getStmtId(Stmt *stmt, StmtKind stmtKind) {
+int64_t StmtProcessor::getStmtId(Stmt *stmt, StmtKind stmtKind) {
   KeyType stmtKey = KeyGen::Stmt_::makeKey(stmt, ast_context_);
-  LocIdPair *locIdPair = SrcLocRecorder::processStmt(stmt, ast_context_);
+  LocIdPair locIdPair = SrcLocRecorder::processStmt(stmt, ast_context_);
 
   DbModel::Stmt stmtModel = {GENID(Stmt), static_cast<int>(stmtKind),
-                             locIdPair->spec_id};
+                             locIdPair.spec_id};
 
-  INSERT_STMT_CACHE(stmtKey, stmtModel.id);
-  STG.insertClassObj(stmtModel);
-  return stmtModel.id;
+  const int64_t stmtId = INSERT_STMT_CACHE(stmtKey, stmtModel.id);
+  if (stmtId == stmtModel.id)
+    STG.insertClassObj(stmtModel);
+  return stmtId;
 }
 
 void StmtProcessor::processIfStmt(IfStmt *ifStmt) {
-  int if_stmt_id = getStmtId(ifStmt, StmtKind::IF);
+  PROCESSOR_SCOPE();
+  int64_t if_stmt_id = getStmtId(ifStmt, StmtKind::IF);
 
   // 1. 处理初始化部分
   if (Stmt *init = ifStmt->getInit()) {
@@ -37,12 +39,8 @@ void StmtProcessor::processIfStmt(IfStmt *ifStmt) {
     } else {
       DbModel::IfInit ifInitModel = {if_stmt_id, -1};
       STG.insertClassObj(ifInitModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [if_stmt_id](int resolvedId) {
-            DbModel::IfInit updated_record = {if_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, ifInitModel, &DbModel::IfInit::init_id);
     }
   }
 
@@ -55,12 +53,8 @@ void StmtProcessor::processIfStmt(IfStmt *ifStmt) {
     } else {
       DbModel::IfThen ifThenModel = {if_stmt_id, -1};
       STG.insertClassObj(ifThenModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [if_stmt_id](int resolvedId) {
-            DbModel::IfThen updated_record = {if_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, ifThenModel, &DbModel::IfThen::then_id);
     }
   }
 
@@ -73,20 +67,17 @@ void StmtProcessor::processIfStmt(IfStmt *ifStmt) {
     } else {
       DbModel::IfElse ifElseModel = {if_stmt_id, -1};
       STG.insertClassObj(ifElseModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [if_stmt_id](int resolvedId) {
-            DbModel::IfElse updated_record = {if_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, ifElseModel, &DbModel::IfElse::else_id);
     }
   }
 }
 
 void StmtProcessor::processForStmt(ForStmt *forStmt) {
-  int for_stmt_id = getStmtId(forStmt, StmtKind::FOR);
+  PROCESSOR_SCOPE();
+  int64_t for_stmt_id = getStmtId(forStmt, StmtKind::FOR);
 
-  // int for_or_range_id = GENID(StmtForOrRangeBased);
+  // int64_t for_or_range_id = GENID(StmtForOrRangeBased);
   // DbModel::StmtForOrRangeBased stmtForOrRangeBasedModel = {
   //     for_or_range_id, static_cast<int>(ForType::FOR), for_stmt_id};
   // STG.insertClassObj(stmtForOrRangeBasedModel);
@@ -100,12 +91,8 @@ void StmtProcessor::processForStmt(ForStmt *forStmt) {
     } else {
       DbModel::ForInit forInitModel = {for_stmt_id, -1};
       STG.insertClassObj(forInitModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [for_stmt_id](int resolvedId) {
-            DbModel::ForInit updated_record = {for_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, forInitModel, &DbModel::ForInit::init_id);
     }
   }
 
@@ -118,12 +105,9 @@ void StmtProcessor::processForStmt(ForStmt *forStmt) {
     } else {
       DbModel::ForCond forCondModel = {for_stmt_id, -1};
       STG.insertClassObj(forCondModel);
-      PendingUpdate update{
-          exprKey, CacheType::EXPR, [for_stmt_id](int resolvedId) {
-            DbModel::ForCond updated_record = {for_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          exprKey, CacheType::EXPR, forCondModel,
+          &DbModel::ForCond::condition_id);
     }
   }
 
@@ -136,12 +120,9 @@ void StmtProcessor::processForStmt(ForStmt *forStmt) {
     } else {
       DbModel::ForUpdate forUpdateModel = {for_stmt_id, -1};
       STG.insertClassObj(forUpdateModel);
-      PendingUpdate update{
-          exprKey, CacheType::EXPR, [for_stmt_id](int resolvedId) {
-            DbModel::ForUpdate updated_record = {for_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          exprKey, CacheType::EXPR, forUpdateModel,
+          &DbModel::ForUpdate::update_id);
     }
   }
 
@@ -154,20 +135,17 @@ void StmtProcessor::processForStmt(ForStmt *forStmt) {
     } else {
       DbModel::ForBody forBodyModel = {for_stmt_id, -1};
       STG.insertClassObj(forBodyModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [for_stmt_id](int resolvedId) {
-            DbModel::ForBody updated_record = {for_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, forBodyModel, &DbModel::ForBody::body_id);
     }
   }
 }
 
 void StmtProcessor::processCXXForRangeStmt(CXXForRangeStmt *rangeForStmt) {
-  int for_stmt_id = getStmtId((Stmt *)rangeForStmt, StmtKind::FOR);
+  PROCESSOR_SCOPE();
+  int64_t for_stmt_id = getStmtId((Stmt *)rangeForStmt, StmtKind::FOR);
 
-  // int for_or_range_id = GENID(StmtForOrRangeBased);
+  // int64_t for_or_range_id = GENID(StmtForOrRangeBased);
   // DbModel::StmtForOrRangeBased stmtForOrRangeBasedModel = {
   //     for_or_range_id, static_cast<int>(ForType::RANGE_BASED_FOR),
   //     for_stmt_id};
@@ -182,18 +160,15 @@ void StmtProcessor::processCXXForRangeStmt(CXXForRangeStmt *rangeForStmt) {
     } else {
       DbModel::ForInit forInitModel = {for_stmt_id, -1};
       STG.insertClassObj(forInitModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [for_stmt_id](int resolvedId) {
-            DbModel::ForInit updated_record = {for_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, forInitModel, &DbModel::ForInit::init_id);
     }
   }
 }
 
 void StmtProcessor::processWhileStmt(WhileStmt *whileStmt) {
-  int while_stmt_id = getStmtId(whileStmt, StmtKind::WHILE);
+  PROCESSOR_SCOPE();
+  int64_t while_stmt_id = getStmtId(whileStmt, StmtKind::WHILE);
 
   // 处理循环体
   if (Stmt *body = whileStmt->getBody()) {
@@ -204,18 +179,16 @@ void StmtProcessor::processWhileStmt(WhileStmt *whileStmt) {
     } else {
       DbModel::WhileBody whileBodyModel = {while_stmt_id, -1};
       STG.insertClassObj(whileBodyModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [while_stmt_id](int resolvedId) {
-            DbModel::WhileBody updated_record = {while_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, whileBodyModel,
+          &DbModel::WhileBody::body_id);
     }
   }
 }
 
 void StmtProcessor::processDoStmt(DoStmt *doStmt) {
-  int do_stmt_id = getStmtId(doStmt, StmtKind::END_TEST_WHILE);
+  PROCESSOR_SCOPE();
+  int64_t do_stmt_id = getStmtId(doStmt, StmtKind::END_TEST_WHILE);
 
   // 处理循环体
   if (Stmt *body = doStmt->getBody()) {
@@ -226,18 +199,15 @@ void StmtProcessor::processDoStmt(DoStmt *doStmt) {
     } else {
       DbModel::DoBody doBodyModel = {do_stmt_id, -1};
       STG.insertClassObj(doBodyModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [do_stmt_id](int resolvedId) {
-            DbModel::DoBody updated_record = {do_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, doBodyModel, &DbModel::DoBody::body_id);
     }
   }
 }
 
 void StmtProcessor::processSwitchStmt(SwitchStmt *switchStmt) {
-  int switch_stmt_id = getStmtId(switchStmt, StmtKind::SWITCH);
+  PROCESSOR_SCOPE();
+  int64_t switch_stmt_id = getStmtId(switchStmt, StmtKind::SWITCH);
 
   // 1. 处理初始化部分
   if (Stmt *init = switchStmt->getInit()) {
@@ -248,12 +218,9 @@ void StmtProcessor::processSwitchStmt(SwitchStmt *switchStmt) {
     } else {
       DbModel::SwitchInit switchInitModel = {switch_stmt_id, -1};
       STG.insertClassObj(switchInitModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [switch_stmt_id](int resolvedId) {
-            DbModel::SwitchInit updated_record = {switch_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, switchInitModel,
+          &DbModel::SwitchInit::init_id);
     }
   }
 
@@ -266,12 +233,9 @@ void StmtProcessor::processSwitchStmt(SwitchStmt *switchStmt) {
     } else {
       DbModel::SwitchBody switchBodyModel = {switch_stmt_id, -1};
       STG.insertClassObj(switchBodyModel);
-      PendingUpdate update{
-          stmtKey, CacheType::STMT, [switch_stmt_id](int resolvedId) {
-            DbModel::SwitchBody updated_record = {switch_stmt_id, resolvedId};
-            STG.insertClassObj(updated_record);
-          }};
-      DependencyManager::instance().addDependency(update);
+      DependencyManager::instance().addDependency(
+          stmtKey, CacheType::STMT, switchBodyModel,
+          &DbModel::SwitchBody::body_id);
     }
 
     // 3. 处理 case 部分 - 遍历 body 中的 case 语句
@@ -279,7 +243,7 @@ void StmtProcessor::processSwitchStmt(SwitchStmt *switchStmt) {
       int case_index = 0;
       for (Stmt *child : compoundBody->children()) {
         if (SwitchCase *switchCase = dyn_cast<SwitchCase>(child)) {
-          int case_id = getStmtId(switchCase, StmtKind::SWITCH_CASE);
+          int64_t case_id = getStmtId(switchCase, StmtKind::SWITCH_CASE);
           KeyType caseKey = KeyGen::Stmt_::makeKey(switchCase, ast_context_);
           if (auto cachedId = SEARCH_STMT_CACHE(caseKey)) {
             DbModel::SwitchCase switchCaseModel = {switch_stmt_id, case_index,
@@ -289,13 +253,9 @@ void StmtProcessor::processSwitchStmt(SwitchStmt *switchStmt) {
             DbModel::SwitchCase switchCaseModel = {switch_stmt_id, case_index,
                                                    -1};
             STG.insertClassObj(switchCaseModel);
-            PendingUpdate update{caseKey, CacheType::STMT,
-                                 [switch_stmt_id, case_index](int resolvedId) {
-                                   DbModel::SwitchCase updated_record = {
-                                       switch_stmt_id, case_index, resolvedId};
-                                   STG.insertClassObj(updated_record);
-                                 }};
-            DependencyManager::instance().addDependency(update);
+            DependencyManager::instance().addDependency(
+                caseKey, CacheType::STMT, switchCaseModel,
+                &DbModel::SwitchCase::case_id);
           }
           case_index++;
         }
@@ -305,15 +265,18 @@ void StmtProcessor::processSwitchStmt(SwitchStmt *switchStmt) {
 }
 
 void StmtProcessor::processBlockStmt(CompoundStmt *blockStmt) {
-  int block_stmt_id = getStmtId(blockStmt, StmtKind::BLOCK);
+  PROCESSOR_SCOPE();
+  int64_t block_stmt_id = getStmtId(blockStmt, StmtKind::BLOCK);
 }
 
 void StmtProcessor::processReturnStmt(ReturnStmt *returnStmt) {
+  PROCESSOR_SCOPE();
   // Just call getStmtId to create ReturnStmt record
   getStmtId(returnStmt, StmtKind::RETURN);
 }
 
 void StmtProcessor::processDeclStmt(DeclStmt *declStmt) {
+  PROCESSOR_SCOPE();
   // Just call getStmtId to create DeclStmt record
   getStmtId(declStmt, StmtKind::DECL);
 }
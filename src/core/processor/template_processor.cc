@@ -17,6 +17,7 @@
 #include "model/db/variable.h"
 #include "util/id_generator.h"
 #include "util/key_generator/expr.h"
+#include "util/key_generator/fingerprint_ostream.h"
 #include "util/key_generator/function.h"
 #include "util/key_generator/type.h"
 #include "util/key_generator/variable.h"
@@ -36,151 +37,144 @@
 namespace {
 
 struct ConceptSpecializationId {
-  int id;
+  int64_t id;
 };
 
 } // namespace
 
-std::string TemplateProcessor::makePairKey(int first, int second) {
-  return std::to_string(first) + ":" + std::to_string(second);
-}
-
-std::string TemplateProcessor::makeTripleKey(int first, int second,
-                                             int third) {
-  return std::to_string(first) + ":" + std::to_string(second) + ":" +
-         std::to_string(third);
-}
-
-bool TemplateProcessor::shouldInsertClassInstantiation(int to, int from) {
+bool TemplateProcessor::shouldInsertClassInstantiation(int64_t to,
+                                                       int64_t from) {
   return classInstantiationDedup.insert(makePairKey(to, from)).second;
 }
 
-bool TemplateProcessor::shouldInsertClassTemplateArgument(int typeId, int index,
-                                                          int argType) {
+bool TemplateProcessor::shouldInsertClassTemplateArgument(int64_t typeId,
+                                                          int index,
+                                                          int64_t argType) {
   return classTemplateArgumentDedup
       .insert(makeTripleKey(typeId, index, argType))
       .second;
 }
 
-bool TemplateProcessor::shouldInsertClassTemplateArgumentValue(int typeId,
-                                                               int index,
-                                                               int argValue) {
+bool TemplateProcessor::shouldInsertClassTemplateArgumentValue(
+    int64_t typeId, int index, int64_t argValue) {
   return classTemplateArgumentValueDedup
       .insert(makeTripleKey(typeId, index, argValue))
       .second;
 }
 
-bool TemplateProcessor::shouldInsertFunctionInstantiation(int to, int from) {
+bool TemplateProcessor::shouldInsertFunctionInstantiation(int64_t to,
+                                                          int64_t from) {
   return functionInstantiationDedup.insert(makePairKey(to, from)).second;
 }
 
-bool TemplateProcessor::shouldInsertFunctionTemplateArgument(int functionId,
+bool TemplateProcessor::shouldInsertFunctionTemplateArgument(int64_t functionId,
                                                              int index,
-                                                             int argType) {
+                                                             int64_t argType) {
   return functionTemplateArgumentDedup
       .insert(makeTripleKey(functionId, index, argType))
       .second;
 }
 
 bool TemplateProcessor::shouldInsertFunctionTemplateArgumentValue(
-    int functionId, int index, int argValue) {
+    int64_t functionId, int index, int64_t argValue) {
   return functionTemplateArgumentValueDedup
       .insert(makeTripleKey(functionId, index, argValue))
       .second;
 }
 
-bool TemplateProcessor::shouldInsertVariableTemplate(int variableId) {
-  return variableTemplateDedup.insert(std::to_string(variableId)).second;
+bool TemplateProcessor::shouldInsertVariableTemplate(int64_t variableId) {
+  return variableTemplateDedup.insert(variableId).second;
 }
 
-bool TemplateProcessor::shouldInsertVariableInstantiation(int to, int from) {
+bool TemplateProcessor::shouldInsertVariableInstantiation(int64_t to,
+                                                          int64_t from) {
   return variableInstantiationDedup
       .insert(makePairKey(to, from))
       .second;
 }
 
-bool TemplateProcessor::shouldInsertVariableTemplateArgument(int variableId,
+bool TemplateProcessor::shouldInsertVariableTemplateArgument(int64_t variableId,
                                                              int index,
-                                                             int argType) {
+                                                             int64_t argType) {
   return variableTemplateArgumentDedup
       .insert(makeTripleKey(variableId, index, argType))
       .second;
 }
 
 bool TemplateProcessor::shouldInsertVariableTemplateArgumentValue(
-    int variableId, int index, int argValue) {
+    int64_t variableId, int index, int64_t argValue) {
   return variableTemplateArgumentValueDedup
       .insert(makeTripleKey(variableId, index, argValue))
       .second;
 }
 
-bool TemplateProcessor::shouldInsertTemplateTemplateInstantiation(int to,
-                                                                  int from) {
+bool TemplateProcessor::shouldInsertTemplateTemplateInstantiation(
+    int64_t to, int64_t from) {
   return templateTemplateInstantiationDedup.insert(makePairKey(to, from))
       .second;
 }
 
-bool TemplateProcessor::shouldInsertTemplateTemplateArgument(int typeId,
+bool TemplateProcessor::shouldInsertTemplateTemplateArgument(int64_t typeId,
                                                              int index,
-                                                             int argType) {
+                                                             int64_t argType) {
   return templateTemplateArgumentDedup
       .insert(makeTripleKey(typeId, index, argType))
       .second;
 }
 
-bool TemplateProcessor::shouldInsertConceptInstantiation(int conceptId,
-                                                         int templateId) {
+bool TemplateProcessor::shouldInsertConceptInstantiation(int64_t conceptId,
+                                                         int64_t templateId) {
   return conceptInstantiationDedup.insert(makePairKey(conceptId, templateId))
       .second;
 }
 
-bool TemplateProcessor::shouldInsertConceptTemplateArgument(int conceptId,
+bool TemplateProcessor::shouldInsertConceptTemplateArgument(int64_t conceptId,
                                                             int index,
-                                                            int argType) {
+                                                            int64_t argType) {
   return conceptTemplateArgumentDedup
       .insert(makeTripleKey(conceptId, index, argType))
       .second;
 }
 
 bool TemplateProcessor::shouldInsertTypeTemplateTypeConstraint(
-    int typeId, int constraintId) {
+    int64_t typeId, int64_t constraintId) {
   return typeTemplateTypeConstraintDedup
       .insert(makePairKey(typeId, constraintId))
       .second;
 }
 
-bool TemplateProcessor::shouldInsertIsTypeConstraint(int conceptId) {
+bool TemplateProcessor::shouldInsertIsTypeConstraint(int64_t conceptId) {
   return isTypeConstraintDedup.insert(conceptId).second;
 }
 
-bool TemplateProcessor::shouldInsertNontypeTemplateParameter(int id) {
+bool TemplateProcessor::shouldInsertNontypeTemplateParameter(int64_t id) {
   return nontypeTemplateParameterDedup.insert(id).second;
 }
 
 bool TemplateProcessor::shouldInsertConceptTemplateArgumentValue(
-    int conceptId, int index, int argValue) {
+    int64_t conceptId, int index, int64_t argValue) {
   return conceptTemplateArgumentValueDedup
       .insert(makeTripleKey(conceptId, index, argValue))
       .second;
 }
 
-std::string
+Fingerprint
 TemplateProcessor::makeConceptTemplateKey(const clang::ConceptDecl *decl,
                                           clang::ASTContext *context) {
   if (!decl || !context)
-    return "";
+    return {};
 
   const clang::ConceptDecl *canonicalDecl = decl->getCanonicalDecl();
   return KeyGen::Type::makeKey(canonicalDecl, context);
 }
 
-int TemplateProcessor::resolveConceptTemplateId(
+int64_t TemplateProcessor::resolveConceptTemplateId(
     const clang::ConceptDecl *decl, clang::ASTContext *context) {
   if (!decl || !context)
     return -1;
 
   const clang::ConceptDecl *canonicalDecl = decl->getCanonicalDecl();
-  std::string conceptKey = makeConceptTemplateKey(canonicalDecl, context);
+  Fingerprint conceptKey = makeConceptTemplateKey(canonicalDecl, context);
   if (conceptKey.empty())
     return -1;
 
@@ -188,21 +182,19 @@ int TemplateProcessor::resolveConceptTemplateId(
       it != conceptTemplateIds.end())
     return it->second;
 
-  LocIdPair *locIdPair = SrcLocRecorder::processDefault(canonicalDecl, context);
+  LocIdPair locIdPair = SrcLocRecorder::processDefault(canonicalDecl, context);
   DbModel::ConceptTemplate conceptTemplate = {
-      GENID(ConceptTemplate), canonicalDecl->getNameAsString(),
-      locIdPair->spec_id};
+      GENID(ConceptTemplate), INTERN(canonicalDecl->getNameAsString()),
+      locIdPair.spec_id};
 
   conceptTemplateIds.emplace(conceptKey, conceptTemplate.id);
   STG.insertClassObj(conceptTemplate);
   return conceptTemplate.id;
 }
 
-std::string TemplateProcessor::makeTemplateArgumentListKey(
-    llvm::ArrayRef<clang::TemplateArgument> args,
-    clang::ASTContext *context) {
-  std::string key;
-  llvm::raw_string_ostream os(key);
+void TemplateProcessor::printTemplateArgumentListKey(
+    llvm::ArrayRef<clang::TemplateArgument> args, clang::ASTContext *context,
+    llvm::raw_ostream &os) {
   clang::PrintingPolicy policy(context->getLangOpts());
 
   for (unsigned index = 0; index < args.size(); ++index) {
@@ -210,20 +202,18 @@ std::string TemplateProcessor::makeTemplateArgumentListKey(
       os << ",";
     args[index].print(policy, os, true);
   }
-
-  return os.str();
 }
 
-std::string TemplateProcessor::makeConceptSpecializationKey(
+Fingerprint TemplateProcessor::makeConceptSpecializationKey(
     const clang::ConceptSpecializationExpr *expr,
     clang::ASTContext *context) {
   if (!expr || !context)
-    return "";
+    return {};
 
-  std::string conceptKey = makeConceptTemplateKey(expr->getNamedConcept(),
+  Fingerprint conceptKey = makeConceptTemplateKey(expr->getNamedConcept(),
                                                   context);
   if (conceptKey.empty())
-    return "";
+    return {};
 
   const clang::SourceManager &sourceManager = context->getSourceManager();
   clang::SourceLocation beginLoc =
@@ -231,27 +221,27 @@ std::string TemplateProcessor::makeConceptSpecializationKey(
   clang::SourceLocation endLoc =
       sourceManager.getSpellingLoc(expr->getEndLoc());
 
-  std::string locationKey;
+  // concept<实参列表>@位置
+  FingerprintOStream os;
+  os.add(conceptKey) << "<";
+  printTemplateArgumentListKey(expr->getTemplateArguments(), context, os);
+  os << ">@";
   if (beginLoc.isValid() && endLoc.isValid()) {
-    locationKey =
-        beginLoc.printToString(sourceManager) + "-" +
-        endLoc.printToString(sourceManager);
+    beginLoc.print(os, sourceManager);
+    os << "-";
+    endLoc.print(os, sourceManager);
   } else if (const auto *specializationDecl = expr->getSpecializationDecl()) {
-    locationKey = "implicit-decl-" + std::to_string(specializationDecl->getID());
+    os << "implicit-decl-" << specializationDecl->getID();
   } else {
-    locationKey =
-        "addr-" + std::to_string(reinterpret_cast<std::uintptr_t>(expr));
+    os << "addr-" << reinterpret_cast<std::uintptr_t>(expr);
   }
-
-  return conceptKey + "<" +
-         makeTemplateArgumentListKey(expr->getTemplateArguments(), context) +
-         ">@" + locationKey;
+  return os.finish();
 }
 
-int TemplateProcessor::resolveConceptSpecializationId(
+int64_t TemplateProcessor::resolveConceptSpecializationId(
     const clang::ConceptSpecializationExpr *expr,
     clang::ASTContext *context) {
-  std::string specializationKey = makeConceptSpecializationKey(expr, context);
+  Fingerprint specializationKey = makeConceptSpecializationKey(expr, context);
   if (specializationKey.empty())
     return -1;
 
@@ -259,32 +249,31 @@ int TemplateProcessor::resolveConceptSpecializationId(
       it != conceptSpecializationIds.end())
     return it->second;
 
-  int conceptId = IDGenerator::generateId<ConceptSpecializationId>();
+  int64_t conceptId = IDGenerator::generateId<ConceptSpecializationId>();
   conceptSpecializationIds.emplace(specializationKey, conceptId);
   return conceptId;
 }
 
-int TemplateProcessor::resolveVariableEntityId(const clang::VarDecl *decl) {
+int64_t TemplateProcessor::resolveVariableEntityId(const clang::VarDecl *decl) {
   if (!decl || !variable_processor_ || !ast_context_)
     return -1;
 
-  KeyType variableKey = KeyGen::Var::makeKey(decl, ast_context_);
-  if (auto cachedId = SEARCH_VARIABLE_CACHE(variableKey))
+  if (auto cachedId = KeyGen::Var::findId(decl, ast_context_))
     return *cachedId;
 
   variable_processor_->processVarDecl(decl);
-  if (auto cachedId = SEARCH_VARIABLE_CACHE(variableKey))
+  if (auto cachedId = KeyGen::Var::findId(decl, ast_context_))
     return *cachedId;
 
   return -1;
 }
 
-int TemplateProcessor::resolveTemplateArgumentTypeId(clang::QualType argType) {
+int64_t TemplateProcessor::resolveTemplateArgumentTypeId(
+    clang::QualType argType) {
   if (argType.isNull() || !type_processor_ || !ast_context_)
     return -1;
 
-  KeyType typeKey = KeyGen::Type::makeKey(argType, ast_context_);
-  if (auto cachedId = SEARCH_TYPE_CACHE(typeKey))
+  if (auto cachedId = KeyGen::Type::findId(argType, ast_context_))
     return *cachedId;
 
   if (const auto *builtinType = argType->getAs<clang::BuiltinType>())
@@ -292,40 +281,39 @@ int TemplateProcessor::resolveTemplateArgumentTypeId(clang::QualType argType) {
 
   if (const auto *recordType = argType->getAs<clang::RecordType>()) {
     type_processor_->processRecordType(recordType);
-    if (auto cachedId = SEARCH_TYPE_CACHE(typeKey))
+    if (auto cachedId = KeyGen::Type::findId(argType, ast_context_))
       return *cachedId;
   }
 
-  int typeId = type_processor_->processType(argType.getTypePtr());
+  int64_t typeId = type_processor_->processType(argType.getTypePtr());
   if (typeId != -1)
     return typeId;
 
-  if (auto cachedId = SEARCH_TYPE_CACHE(typeKey))
+  if (auto cachedId = KeyGen::Type::findId(argType, ast_context_))
     return *cachedId;
 
   return -1;
 }
 
-int TemplateProcessor::resolveTemplateTemplateParmId(
+int64_t TemplateProcessor::resolveTemplateTemplateParmId(
     const clang::TemplateTemplateParmDecl *decl) {
   if (!decl || !type_processor_ || !ast_context_)
     return -1;
 
-  KeyType typeKey = KeyGen::Type::makeKey(decl, ast_context_);
-  if (auto cachedId = SEARCH_TYPE_CACHE(typeKey))
+  if (auto cachedId = KeyGen::Type::findId(decl, ast_context_))
     return *cachedId;
 
-  int typeId = type_processor_->processTemplateTemplateParmDecl(decl);
+  int64_t typeId = type_processor_->processTemplateTemplateParmDecl(decl);
   if (typeId != -1)
     return typeId;
 
-  if (auto cachedId = SEARCH_TYPE_CACHE(typeKey))
+  if (auto cachedId = KeyGen::Type::findId(decl, ast_context_))
     return *cachedId;
 
   return -1;
 }
 
-int TemplateProcessor::resolveTemplateTemplateArgumentTypeId(
+int64_t TemplateProcessor::resolveTemplateTemplateArgumentTypeId(
     const clang::TemplateArgument &arg) {
   if (arg.getKind() != clang::TemplateArgument::Template || !type_processor_ ||
       !ast_context_)
@@ -340,15 +328,15 @@ int TemplateProcessor::resolveTemplateTemplateArgumentTypeId(
 
   const clang::CXXRecordDecl *templatedDecl =
       classTemplateDecl->getTemplatedDecl();
-  KeyType templateTypeKey = KeyGen::Type::makeKey(templatedDecl, ast_context_);
-  if (auto cachedId = SEARCH_TYPE_CACHE(templateTypeKey))
+  if (auto cachedId = KeyGen::Type::findId(templatedDecl, ast_context_))
     return *cachedId;
 
-  int templateTypeId = type_processor_->processRecordDeclType(templatedDecl);
+  int64_t templateTypeId =
+      type_processor_->processRecordDeclType(templatedDecl);
   if (templateTypeId != -1)
     return templateTypeId;
 
-  if (auto cachedId = SEARCH_TYPE_CACHE(templateTypeKey))
+  if (auto cachedId = KeyGen::Type::findId(templatedDecl, ast_context_))
     return *cachedId;
 
   return -1;
@@ -368,7 +356,7 @@ const clang::Expr *TemplateProcessor::getTemplateArgumentSourceExpr(
   }
 }
 
-int TemplateProcessor::resolveTemplateArgumentExprId(
+int64_t TemplateProcessor::resolveTemplateArgumentExprId(
     const clang::Expr *sourceExpr) {
   if (!sourceExpr || !expr_processor_ || !ast_context_)
     return -1;
@@ -405,7 +393,7 @@ int TemplateProcessor::resolveTemplateArgumentExprId(
 }
 
 void TemplateProcessor::recordClassTemplateTypeArguments(
-    int typeId, const clang::TemplateArgumentList &templateArgs) {
+    int64_t typeId, const clang::TemplateArgumentList &templateArgs) {
   if (typeId == -1)
     return;
 
@@ -414,7 +402,7 @@ void TemplateProcessor::recordClassTemplateTypeArguments(
     if (arg.getKind() != clang::TemplateArgument::Type)
       continue;
 
-    int argTypeId =
+    int64_t argTypeId =
         this->resolveTemplateArgumentTypeId(arg.getAsType());
     if (argTypeId == -1)
       continue;
@@ -430,7 +418,8 @@ void TemplateProcessor::recordClassTemplateTypeArguments(
 }
 
 void TemplateProcessor::recordClassTemplateArgumentValues(
-    int typeId, const clang::ASTTemplateArgumentListInfo *templateArgs) {
+    int64_t typeId, const clang::ASTTemplateArgumentListInfo *templateArgs) {
+  PROCESSOR_SCOPE();
   if (typeId == -1 || !templateArgs)
     return;
 
@@ -439,7 +428,7 @@ void TemplateProcessor::recordClassTemplateArgumentValues(
     const clang::TemplateArgumentLoc &argLoc = (*templateArgs)[index];
     const clang::Expr *sourceExpr =
         this->getTemplateArgumentSourceExpr(argLoc);
-    int exprId =
+    int64_t exprId =
         this->resolveTemplateArgumentExprId(sourceExpr);
     if (exprId == -1)
       continue;
@@ -455,7 +444,8 @@ void TemplateProcessor::recordClassTemplateArgumentValues(
 }
 
 void TemplateProcessor::recordClassTemplateArgumentValues(
-    int typeId, clang::TemplateSpecializationTypeLoc templateArgs) {
+    int64_t typeId, clang::TemplateSpecializationTypeLoc templateArgs) {
+  PROCESSOR_SCOPE();
   if (typeId == -1 || !templateArgs)
     return;
 
@@ -463,7 +453,7 @@ void TemplateProcessor::recordClassTemplateArgumentValues(
     const clang::TemplateArgumentLoc &argLoc = templateArgs.getArgLoc(index);
     const clang::Expr *sourceExpr =
         this->getTemplateArgumentSourceExpr(argLoc);
-    int exprId =
+    int64_t exprId =
         this->resolveTemplateArgumentExprId(sourceExpr);
     if (exprId == -1)
       continue;
@@ -479,13 +469,13 @@ void TemplateProcessor::recordClassTemplateArgumentValues(
 }
 
 void TemplateProcessor::recordTemplateTemplateArguments(
-    int typeId, const clang::TemplateArgumentList &templateArgs) {
+    int64_t typeId, const clang::TemplateArgumentList &templateArgs) {
   if (typeId == -1)
     return;
 
   for (unsigned index = 0; index < templateArgs.size(); ++index) {
     const clang::TemplateArgument &arg = templateArgs[index];
-    int argTypeId =
+    int64_t argTypeId =
         this->resolveTemplateTemplateArgumentTypeId(arg);
     if (argTypeId == -1)
       continue;
@@ -529,8 +519,8 @@ void TemplateProcessor::recordTemplateTemplateInstantiations(
     if (!llvm::isa_and_nonnull<clang::ClassTemplateDecl>(templateDecl))
       continue;
 
-    int paramId = this->resolveTemplateTemplateParmId(param);
-    int argTypeId =
+    int64_t paramId = this->resolveTemplateTemplateParmId(param);
+    int64_t argTypeId =
         this->resolveTemplateTemplateArgumentTypeId(arg);
     if (paramId == -1 || argTypeId == -1)
       continue;
@@ -546,7 +536,7 @@ void TemplateProcessor::recordTemplateTemplateInstantiations(
 }
 
 void TemplateProcessor::recordFunctionTemplateTypeArguments(
-    int functionId, const clang::TemplateArgumentList *templateArgs) {
+    int64_t functionId, const clang::TemplateArgumentList *templateArgs) {
   if (functionId == -1 || !templateArgs)
     return;
 
@@ -555,7 +545,7 @@ void TemplateProcessor::recordFunctionTemplateTypeArguments(
     if (arg.getKind() != clang::TemplateArgument::Type)
       continue;
 
-    int argTypeId =
+    int64_t argTypeId =
         this->resolveTemplateArgumentTypeId(arg.getAsType());
     if (argTypeId == -1)
       continue;
@@ -571,7 +561,9 @@ void TemplateProcessor::recordFunctionTemplateTypeArguments(
 }
 
 void TemplateProcessor::recordFunctionTemplateArgumentValues(
-    int functionId, const clang::ASTTemplateArgumentListInfo *templateArgs) {
+    int64_t functionId,
+    const clang::ASTTemplateArgumentListInfo *templateArgs) {
+  PROCESSOR_SCOPE();
   if (functionId == -1 || !templateArgs)
     return;
 
@@ -580,7 +572,7 @@ void TemplateProcessor::recordFunctionTemplateArgumentValues(
     const clang::TemplateArgumentLoc &argLoc = (*templateArgs)[index];
     const clang::Expr *sourceExpr =
         this->getTemplateArgumentSourceExpr(argLoc);
-    int exprId =
+    int64_t exprId =
         this->resolveTemplateArgumentExprId(sourceExpr);
     if (exprId == -1)
       continue;
@@ -596,8 +588,9 @@ void TemplateProcessor::recordFunctionTemplateArgumentValues(
 }
 
 void TemplateProcessor::recordFunctionTemplateArgumentValues(
-    int functionId, const clang::TemplateArgumentLoc *templateArgs,
+    int64_t functionId, const clang::TemplateArgumentLoc *templateArgs,
     unsigned numTemplateArgs) {
+  PROCESSOR_SCOPE();
   if (functionId == -1 || !templateArgs)
     return;
 
@@ -605,7 +598,7 @@ void TemplateProcessor::recordFunctionTemplateArgumentValues(
     const clang::TemplateArgumentLoc &argLoc = templateArgs[index];
     const clang::Expr *sourceExpr =
         this->getTemplateArgumentSourceExpr(argLoc);
-    int exprId =
+    int64_t exprId =
         this->resolveTemplateArgumentExprId(sourceExpr);
     if (exprId == -1)
       continue;
@@ -621,7 +614,7 @@ void TemplateProcessor::recordFunctionTemplateArgumentValues(
 }
 
 void TemplateProcessor::recordVariableTemplateTypeArguments(
-    int variableId, const clang::TemplateArgumentList &templateArgs) {
+    int64_t variableId, const clang::TemplateArgumentList &templateArgs) {
   if (variableId == -1)
     return;
 
@@ -630,7 +623,7 @@ void TemplateProcessor::recordVariableTemplateTypeArguments(
     if (arg.getKind() != clang::TemplateArgument::Type)
       continue;
 
-    int argTypeId =
+    int64_t argTypeId =
         this->resolveTemplateArgumentTypeId(arg.getAsType());
     if (argTypeId == -1)
       continue;
@@ -646,7 +639,8 @@ void TemplateProcessor::recordVariableTemplateTypeArguments(
 }
 
 void TemplateProcessor::recordVariableTemplateArgumentValues(
-    int variableId, const clang::ASTTemplateArgumentListInfo *templateArgs) {
+    int64_t variableId,
+    const clang::ASTTemplateArgumentListInfo *templateArgs) {
   if (variableId == -1 || !templateArgs)
     return;
 
@@ -655,7 +649,7 @@ void TemplateProcessor::recordVariableTemplateArgumentValues(
     const clang::TemplateArgumentLoc &argLoc = (*templateArgs)[index];
     const clang::Expr *sourceExpr =
         this->getTemplateArgumentSourceExpr(argLoc);
-    int exprId =
+    int64_t exprId =
         this->resolveTemplateArgumentExprId(sourceExpr);
     if (exprId == -1)
       continue;
@@ -671,7 +665,7 @@ void TemplateProcessor::recordVariableTemplateArgumentValues(
 }
 
 void TemplateProcessor::recordConceptTemplateTypeArguments(
-    int conceptId, llvm::ArrayRef<clang::TemplateArgument> templateArgs) {
+    int64_t conceptId, llvm::ArrayRef<clang::TemplateArgument> templateArgs) {
   if (conceptId == -1)
     return;
 
@@ -680,7 +674,7 @@ void TemplateProcessor::recordConceptTemplateTypeArguments(
     if (arg.getKind() != clang::TemplateArgument::Type)
       continue;
 
-    int argTypeId =
+    int64_t argTypeId =
         this->resolveTemplateArgumentTypeId(arg.getAsType());
     if (argTypeId == -1)
       continue;
@@ -696,7 +690,7 @@ void TemplateProcessor::recordConceptTemplateTypeArguments(
 }
 
 void TemplateProcessor::recordConceptTemplateArgumentValues(
-    int conceptId, const clang::ConceptSpecializationExpr *expr) {
+    int64_t conceptId, const clang::ConceptSpecializationExpr *expr) {
   if (conceptId == -1 || !expr || !expr_processor_ || !ast_context_)
     return;
 
@@ -730,7 +724,7 @@ void TemplateProcessor::recordConceptTemplateArgumentValues(
     if (llvm::isa<clang::SubstNonTypeTemplateParmExpr>(sourceExpr))
       continue;
 
-    int exprId =
+    int64_t exprId =
         this->resolveTemplateArgumentExprId(sourceExpr);
     if (exprId == -1)
       continue;
@@ -748,6 +742,7 @@ void TemplateProcessor::recordConceptTemplateArgumentValues(
 
 void TemplateProcessor::recordTemplateTypeConstraint(
     const clang::TemplateTypeParmDecl *decl) {
+  PROCESSOR_SCOPE();
   if (!decl || !expr_processor_ || !ast_context_)
     return;
 
@@ -762,17 +757,17 @@ void TemplateProcessor::recordTemplateTypeConstraint(
   if (!conceptExpr)
     return;
 
-  KeyType templateParamKey = KeyGen::Type::makeKey(decl, ast_context_);
-  int templateParamId = SEARCH_TYPE_CACHE(templateParamKey).value_or(-1);
+  int64_t templateParamId =
+      KeyGen::Type::findId(decl, ast_context_).value_or(-1);
   if (templateParamId == -1)
     return;
 
-  int conceptId = this->resolveConceptSpecializationId(conceptExpr,
-                                                       ast_context_);
+  int64_t conceptId = this->resolveConceptSpecializationId(conceptExpr,
+                                                           ast_context_);
   if (conceptId == -1)
     return;
 
-  int constraintExprId =
+  int64_t constraintExprId =
       expr_processor_->processConceptSpecializationExpr(conceptExpr, conceptId);
   if (constraintExprId == -1)
     return;
@@ -791,10 +786,11 @@ void TemplateProcessor::recordTemplateTypeConstraint(
 }
 
 void TemplateProcessor::processFunctionTemplateSpecialization(
-    const clang::FunctionDecl *decl, int functionId) {
+    const clang::FunctionDecl *decl, int64_t functionId) {
+  PROCESSOR_SCOPE();
   if (decl && decl->isFunctionTemplateSpecialization()) {
     KeyType functionKey = KeyGen::Function::makeKey(decl, ast_context_);
-    int specializationId = functionId;
+    int64_t specializationId = functionId;
     if (auto cachedId = SEARCH_FUNCTION_CACHE(functionKey))
       specializationId = *cachedId;
     if (specializationId == -1)
@@ -814,20 +810,13 @@ void TemplateProcessor::processFunctionTemplateSpecialization(
               specializationId, *cachedId};
           STG.insertClassObj(instantiation);
         }
-      } else {
-        PendingUpdate update{
-            templateKey, CacheType::FUNCTION,
-            [specializationId,
-             templateProcessor = this](int resolvedId) {
-              if (!templateProcessor->shouldInsertFunctionInstantiation(
-                      specializationId, resolvedId))
-                return;
-
-              DbModel::FunctionInstantiation instantiation = {
-                  specializationId, resolvedId};
-              STG.insertClassObj(instantiation);
-            }};
-        DependencyManager::instance().addDependency(update);
+      } else if (this->shouldInsertFunctionInstantiation(specializationId,
+                                                         -1)) {
+        DbModel::FunctionInstantiation instantiation = {specializationId, -1};
+        STG.insertClassObj(instantiation);
+        DependencyManager::instance().addDependency(
+            templateKey, CacheType::FUNCTION, instantiation,
+            &DbModel::FunctionInstantiation::from);
       }
     }
 
@@ -840,9 +829,10 @@ void TemplateProcessor::processFunctionTemplateSpecialization(
 
 void TemplateProcessor::processVarTemplateSpecialization(
     const clang::VarTemplateSpecializationDecl *decl, int) {
+  PROCESSOR_SCOPE();
   if (const auto *specialization =
           llvm::dyn_cast_or_null<clang::VarTemplateSpecializationDecl>(decl)) {
-    int variableId =
+    int64_t variableId =
         this->resolveVariableEntityId(specialization);
     if (variableId == -1)
       return;
@@ -850,7 +840,7 @@ void TemplateProcessor::processVarTemplateSpecialization(
     const clang::VarTemplateDecl *primaryTemplate =
         specialization->getSpecializedTemplate();
     if (primaryTemplate && primaryTemplate->getTemplatedDecl()) {
-      int templateId = this->resolveVariableEntityId(
+      int64_t templateId = this->resolveVariableEntityId(
           primaryTemplate->getTemplatedDecl());
       if (templateId != -1 &&
           this->shouldInsertVariableInstantiation(variableId,
@@ -870,6 +860,7 @@ void TemplateProcessor::processVarTemplateSpecialization(
 
 void TemplateProcessor::processClassTemplateSpecialization(
     const clang::ClassTemplateSpecializationDecl *decl) {
+  PROCESSOR_SCOPE();
   if (!decl)
     return;
 
@@ -895,8 +886,8 @@ void TemplateProcessor::processClassTemplateSpecialization(
   if (!SEARCH_TYPE_CACHE(templateKey))
     type_processor_->processRecordDeclType(templatedDecl);
 
-  int specializationId = -1;
-  int templateId = -1;
+  int64_t specializationId = -1;
+  int64_t templateId = -1;
 
   if (auto cachedId = SEARCH_TYPE_CACHE(specializationKey))
     specializationId = *cachedId;
@@ -923,28 +914,28 @@ void TemplateProcessor::processClassTemplateSpecialization(
 }
 
 void TemplateProcessor::processFriendDecl(const clang::FriendDecl *decl) {
+  PROCESSOR_SCOPE();
   if (!decl)
     return;
 
-  LocIdPair *locIdPair = SrcLocRecorder::processDefault(decl, ast_context_);
-  const int friendDeclId = GENID(FriendDecl);
-  int typeId = -1;
-  int declId = -1;
+  LocIdPair locIdPair = SrcLocRecorder::processDefault(decl, ast_context_);
+  const int64_t friendDeclId = GENID(FriendDecl);
+  int64_t typeId = -1;
+  int64_t declId = -1;
 
-  auto resolveRecordType = [&](const clang::RecordType *recordType) -> int {
+  auto resolveRecordType = [&](const clang::RecordType *recordType) -> int64_t {
     if (!recordType || !recordType->getDecl())
       return -1;
 
     type_processor_->processRecordType(recordType);
-    KeyType typeKey = KeyGen::Type::makeKey(recordType->getDecl(),
-                                            ast_context_);
-    if (auto cachedId = SEARCH_TYPE_CACHE(typeKey))
+    if (auto cachedId =
+            KeyGen::Type::findId(recordType->getDecl(), ast_context_))
       return *cachedId;
 
     return -1;
   };
 
-  auto resolveFriendType = [&](clang::QualType friendType) -> int {
+  auto resolveFriendType = [&](clang::QualType friendType) -> int64_t {
     if (friendType.isNull())
       return -1;
 
@@ -964,15 +955,10 @@ void TemplateProcessor::processFriendDecl(const clang::FriendDecl *decl) {
       if (auto cachedId = SEARCH_FUNCTION_CACHE(functionKey)) {
         declId = *cachedId;
       } else {
-        PendingUpdate update{
+        DependencyManager::instance().addDependency(
             functionKey, CacheType::FUNCTION,
-            [friendDeclId, typeId, location = locIdPair->spec_id](
-                int resolvedId) {
-              DbModel::FriendDecl updatedRecord = {friendDeclId, typeId,
-                                                   resolvedId, location};
-              STG.insertClassObj(updatedRecord);
-            }};
-        DependencyManager::instance().addDependency(update);
+            DbModel::FriendDecl{friendDeclId, typeId, -1, locIdPair.spec_id},
+            &DbModel::FriendDecl::decl_id);
       }
     } else if (const auto *typeDecl =
                    llvm::dyn_cast<clang::TypeDecl>(friendNamedDecl)) {
@@ -987,26 +973,28 @@ void TemplateProcessor::processFriendDecl(const clang::FriendDecl *decl) {
   }
 
   DbModel::FriendDecl friendDeclModel = {friendDeclId, typeId, declId,
-                                         locIdPair->spec_id};
+                                         locIdPair.spec_id};
   STG.insertClassObj(friendDeclModel);
 }
 
 void TemplateProcessor::processConceptSpecialization(
     const clang::ConceptSpecializationExpr *expr) {
+  PROCESSOR_SCOPE();
   if (!expr)
     return;
 
-  int templateId = this->resolveConceptTemplateId(
+  int64_t templateId = this->resolveConceptTemplateId(
       expr->getNamedConcept(), ast_context_);
   if (templateId == -1)
     return;
 
-  int conceptId = this->resolveConceptSpecializationId(expr,
-                                                       ast_context_);
+  int64_t conceptId = this->resolveConceptSpecializationId(expr, ast_context_);
   if (conceptId == -1)
     return;
 
-  expr_processor_->processConceptSpecializationExpr(expr, conceptId);
+  // 未抽取 exprs 表族时不记录表达式本身, 实例化关系照常写入
+  if (expr_processor_)
+    expr_processor_->processConceptSpecializationExpr(expr, conceptId);
 
   if (this->shouldInsertConceptInstantiation(conceptId,
                                              templateId)) {
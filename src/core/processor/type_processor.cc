@@ -14,11 +14,13 @@
 #include <clang/AST/Type.h>
 #include <clang/Basic/Specifiers.h>
 #include <iostream>
+#include <llvm/Support/raw_ostream.h>
 
 int getBuiltinTypeSign(const clang::BuiltinType *builtinType);
 BuiltinTypeKind GetBuiltinTypeKind(const clang::BuiltinType *BT);
 
-int TypeProcessor::processType(const Type *T) {
+int64_t TypeProcessor::processType(const Type *T) {
+  PROCESSOR_SCOPE();
   if (!T) {
     LOG_WARNING << "Type is null" << std::endl;
     return -1;
@@ -26,6 +28,8 @@ int TypeProcessor::processType(const Type *T) {
 
   const QualType qualType = T->getCanonicalTypeInternal();
   const clang::Type *type = qualType.getTypePtr();
+  if (auto it = type_ids_.find(type); it != type_ids_.end())
+    return _typeId = it->second;
 
   // Directly return specific type IDs instead of creating Type intermediary
   if (const auto derived_result = analyzeDerivedType(type)) {
@@ -44,10 +48,13 @@ int TypeProcessor::processType(const Type *T) {
     _typeId = -1;
   }
 
+  if (_typeId != -1)
+    type_ids_[type] = _typeId;
   return _typeId;
 }
 
 void TypeProcessor::processRecordDecl(const RecordDecl *RD) {
+  PROCESSOR_SCOPE();
   auto T = RD->getTypeForDecl();
   if (T) {
     _typeId = processType(T);
@@ -56,6 +63,7 @@ void TypeProcessor::processRecordDecl(const RecordDecl *RD) {
 }
 
 void TypeProcessor::processEnumDecl(const EnumDecl *ED) {
+  PROCESSOR_SCOPE();
   auto T = ED->getTypeForDecl();
   if (T) {
     _typeId = processType(T);
@@ -64,32 +72,40 @@ void TypeProcessor::processEnumDecl(const EnumDecl *ED) {
 }
 
 void TypeProcessor::processTypedefDecl(const TypedefDecl *TND) {
+  PROCESSOR_SCOPE();
   std::string typedefName = TND->getNameAsString();
   LOG_INFO << "Processing TypedefDecl: " << typedefName << std::endl;
 
   // Create a UserType entry for the typedef
   int typedefKind = static_cast<int>(UserTypeKind::TYPEDEF);
-  DbModel::UserType userTypeModel = {GENID(UserType), typedefName, typedefKind};
+  DbModel::UserType userTypeModel = {GENID(UserType), INTERN(typedefName),
+                                     typedefKind};
   KeyType userTypeKey = KeyGen::Type::makeKey(TND, ast_context_);
-  INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
-  STG.insertClassObj(userTypeModel);
+  // 其他TU或工作线程已登记同一 typedef 时只记录本处声明
+  const bool claimed =
+      INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id) == userTypeModel.id;
+  if (claimed)
+    STG.insertClassObj(userTypeModel);
 
   // Process the underlying type and create typedef base mapping
   auto T = TND->getTypeForDecl();
   if (T) {
-    int underlyingTypeId = processType(T);
+    int64_t underlyingTypeId = processType(T);
     // Create typedef base mapping
-    DbModel::TypedefBase typedefBase = {userTypeModel.id, underlyingTypeId};
-    STG.insertClassObj(typedefBase);
-    LOG_DEBUG << "Created typedef base: " << typedefName << " -> type_id: " << underlyingTypeId << std::endl;
+    if (claimed) {
+      DbModel::TypedefBase typedefBase = {userTypeModel.id, underlyingTypeId};
+      STG.insertClassObj(typedefBase);
+      LOG_DEBUG << "Created typedef base: " << typedefName << " -> type_id: " << underlyingTypeId << std::endl;
+    }
 
     _typeId = processType(T);
     processTypeDecl(TND);
   }
 }
 
-int TypeProcessor::processTemplateTypeParmDecl(
+int64_t TypeProcessor::processTemplateTypeParmDecl(
     const TemplateTypeParmDecl *TTPD) {
+  PROCESSOR_SCOPE();
   if (!TTPD)
     return -1;
 
@@ -99,19 +115,22 @@ int TypeProcessor::processTemplateTypeParmDecl(
     return *cachedId;
   } else {
     DbModel::UserType userTypeModel = {
-        GENID(UserType), TTPD->getNameAsString(),
+        GENID(UserType), INTERN(TTPD->getNameAsString()),
         static_cast<int>(UserTypeKind::TEMPLATE_PARAMETER)};
-    INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
+    // 只有登记成功的工作线程写入记录, 其余沿用胜出的ID
+    _typeId = INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
+    if (_typeId != userTypeModel.id)
+      return _typeId;
     STG.insertClassObj(userTypeModel);
-    _typeId = userTypeModel.id;
   }
 
   processTypeDecl(TTPD);
   return _typeId;
 }
 
-int TypeProcessor::processTemplateTemplateParmDecl(
+int64_t TypeProcessor::processTemplateTemplateParmDecl(
     const TemplateTemplateParmDecl *TTPD) {
+  PROCESSOR_SCOPE();
   if (!TTPD)
     return -1;
 
@@ -126,15 +145,16 @@ int TypeProcessor::processTemplateTemplateParmDecl(
     name = "(anonymous)";
 
   DbModel::UserType userTypeModel = {
-      GENID(UserType), name,
+      GENID(UserType), INTERN(name),
       static_cast<int>(UserTypeKind::TEMPLATE_TEMPLATE_PARAMETER)};
-  INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
-  STG.insertClassObj(userTypeModel);
-  _typeId = userTypeModel.id;
-  return userTypeModel.id;
+  _typeId = INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
+  if (_typeId == userTypeModel.id)
+    STG.insertClassObj(userTypeModel);
+  return _typeId;
 }
 
-int TypeProcessor::processDependentType(QualType QT) {
+int64_t TypeProcessor::processDependentType(QualType QT) {
+  PROCESSOR_SCOPE();
   if (QT.isNull())
     return -1;
 
@@ -157,24 +177,24 @@ int TypeProcessor::processDependentType(QualType QT) {
     return *cachedId;
   }
 
-  std::string typeName = QT.getAsString(pp_);
+  InternedString typeName = internTypeName(QT);
   if (typeName.empty())
-    typeName = "<dependent>";
+    typeName = INTERN("<dependent>");
 
   DbModel::UserType userTypeModel = {
       GENID(UserType), typeName,
       static_cast<int>(UserTypeKind::UNKNOWN_USERTYPE)};
-  INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
-  STG.insertClassObj(userTypeModel);
-  _typeId = userTypeModel.id;
-  return userTypeModel.id;
+  _typeId = INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
+  if (_typeId == userTypeModel.id)
+    STG.insertClassObj(userTypeModel);
+  return _typeId;
 }
 
 void TypeProcessor::processTypeDecl(const TypeDecl *TD) {
-  LocIdPair *locIdPair = SrcLocRecorder::processDefault(TD, ast_context_);
+  LocIdPair locIdPair = SrcLocRecorder::processDefault(TD, ast_context_);
 
   DbModel::TypeDecl typeDecl = {_typeDeclId = GENID(TypeDecl), _typeId,
-                                locIdPair->spec_id};
+                                locIdPair.spec_id};
 
   // Determine type_def
   recordTypeDef(TD);
@@ -184,15 +204,18 @@ void TypeProcessor::processTypeDecl(const TypeDecl *TD) {
   STG.insertClassObj(typeDecl);
 }
 
-int TypeProcessor::processRecordDeclType(const RecordDecl *RD) {
+int64_t TypeProcessor::processRecordDeclType(const RecordDecl *RD) {
+  PROCESSOR_SCOPE();
   if (!RD)
     return -1;
+  if (auto it = record_type_ids_.find(RD); it != record_type_ids_.end())
+    return _typeId = it->second;
 
   // Get typename
   std::string typeName = RD->getNameAsString();
   if (const auto *specDecl =
           dyn_cast<ClassTemplateSpecializationDecl>(RD)) {
-    typeName = KeyGen::Type::makeKey(specDecl, ast_context_);
+    typeName = getQualifiedDeclName(specDecl);
   }
   if (typeName.empty()) {
     // Handle anonymous types
@@ -225,33 +248,37 @@ int TypeProcessor::processRecordDeclType(const RecordDecl *RD) {
             << ", Kind: " << kind << std::endl;
 
   // Create UserType model
-  DbModel::UserType userTypeModel = {GENID(UserType), typeName, kind};
+  DbModel::UserType userTypeModel = {GENID(UserType), INTERN(typeName), kind};
   KeyType userTypeKey = KeyGen::Type::makeKey(RD, ast_context_);
   LOG_DEBUG << "RecordType UserType Key: " << userTypeKey << std::endl;
 
   // Check cache first
   if (auto cachedId = SEARCH_TYPE_CACHE(userTypeKey)) {
+    record_type_ids_[RD] = *cachedId;
     _typeId = *cachedId;
     return *cachedId;
   }
 
-  INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
-  STG.insertClassObj(userTypeModel);
-  _typeId = userTypeModel.id;
-  return userTypeModel.id;
+  _typeId = INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
+  if (_typeId == userTypeModel.id)
+    STG.insertClassObj(userTypeModel);
+  record_type_ids_[RD] = _typeId;
+  return _typeId;
 }
 
 void TypeProcessor::processRecordType(const RecordType *RT) {
-  if (!RT)
+  PROCESSOR_SCOPE();
+  if (!RT || recorded_record_types_.contains(RT))
     return;
 
   // Extract the RecordDecl from the RecordType
   const RecordDecl *RD = RT->getDecl();
-  int typeId = processRecordDeclType(RD);
+  int64_t typeId = processRecordDeclType(RD);
   if (typeId == -1)
     return;
 
   // Process additional type details (similar to processUserType)
+  recorded_record_types_.insert(RT);
   record_is_pod_class(RT, typeId);
   record_is_standard_layout_class(RT, typeId);
   record_is_complete(RT, typeId);
@@ -275,14 +302,25 @@ void TypeProcessor::recordTopTypeDecl(const TypeDecl *TD) {
   }
 }
 
-int TypeProcessor::processBuiltinType(const BuiltinType *BT,
-                                      ASTContext *ast_context) {
+InternedString TypeProcessor::internTypeName(QualType QT) {
+  print_buffer_.clear();
+  llvm::raw_svector_ostream os(print_buffer_);
+  QT.print(os, pp_);
+  return INTERN(os.str());
+}
+
+int64_t TypeProcessor::processBuiltinType(const BuiltinType *BT,
+                                          ASTContext *ast_context) {
+  PROCESSOR_SCOPE();
   // 获取类型名称
   // PrintingPolicy pp(ast_context.getLangOpts());
 
+  if (auto it = builtin_type_ids_.find(BT); it != builtin_type_ids_.end())
+    return it->second;
+
   KeyType typeKey = KeyGen::Type::makeKey(QualType(BT, 0), ast_context);
   if (auto cachedId = SEARCH_TYPE_CACHE(typeKey))
-    return *cachedId;
+    return builtin_type_ids_[BT] = *cachedId;
 
   // 获取类型大小和对齐
   clang::QualType qualType(BT, 0);
@@ -293,36 +331,38 @@ int TypeProcessor::processBuiltinType(const BuiltinType *BT,
   // 创建并返回类型ID
   DbModel::BuiltinType_ builtinTypeModel = {
       GENID(BuiltinType_),
-      BT->getNameAsCString(pp_),
+      INTERN(BT->getNameAsCString(pp_)),
       static_cast<int>(GetBuiltinTypeKind(BT)),
       size,
       getBuiltinTypeSign(BT),
       alignment};
-  INSERT_TYPE_CACHE(typeKey, builtinTypeModel.id);
-  STG.insertClassObj(builtinTypeModel);
-  return builtinTypeModel.id;
+  const int64_t typeId = INSERT_TYPE_CACHE(typeKey, builtinTypeModel.id);
+  if (typeId == builtinTypeModel.id)
+    STG.insertClassObj(builtinTypeModel);
+  return builtin_type_ids_[BT] = typeId;
 }
 
-int TypeProcessor::processDerivedType(
+int64_t TypeProcessor::processDerivedType(
     const Type *T,
     const std::optional<std::pair<DerivedTypeKind, QualType>> derived_result,
     ASTContext *ast_context) {
   QualType derivedType(T, 0);
-  KeyType derivedTypeKey = KeyGen::Type::makeKey(derivedType, ast_context);
-  if (auto cachedId = SEARCH_TYPE_CACHE(derivedTypeKey))
+  if (auto cachedId = KeyGen::Type::findId(derivedType, ast_context))
     return *cachedId;
+  KeyType derivedTypeKey = KeyGen::Type::makeKey(derivedType, ast_context);
 
   const int derivedTypeKind = (int)derived_result->first;
   const QualType baseType = derived_result->second;
 
-  KeyType typeKey = KeyGen::Type::makeKey(baseType, ast_context);
   LOG_DEBUG << "DerivedType TypeKey: " << derivedTypeKey << std::endl;
 
-  int derivedTypeId = GENID(DerivedType);
-  INSERT_TYPE_CACHE(derivedTypeKey, derivedTypeId);
-  std::string derivedTypeName = derivedType.getAsString(pp_);
+  const int64_t candidateId = GENID(DerivedType);
+  const int64_t derivedTypeId = INSERT_TYPE_CACHE(derivedTypeKey, candidateId);
+  if (derivedTypeId != candidateId)
+    return derivedTypeId;
+  InternedString derivedTypeName = internTypeName(derivedType);
 
-  if (auto cachedId = SEARCH_TYPE_CACHE(typeKey)) {
+  if (auto cachedId = KeyGen::Type::findId(baseType, ast_context)) {
     DbModel::DerivedType derivedTypeModel = {derivedTypeId, derivedTypeName,
                                              derivedTypeKind, *cachedId};
     STG.insertClassObj(derivedTypeModel);
@@ -330,14 +370,10 @@ int TypeProcessor::processDerivedType(
     DbModel::DerivedType derivedTypeModel = {derivedTypeId, derivedTypeName,
                                              derivedTypeKind, -1};
     STG.insertClassObj(derivedTypeModel);
-    PendingUpdate update{
-        typeKey, CacheType::TYPE,
-        [derivedTypeId, derivedTypeName, derivedTypeKind](int resolvedId) {
-          DbModel::DerivedType updated_record = {derivedTypeId, derivedTypeName,
-                                                 derivedTypeKind, resolvedId};
-          STG.insertClassObj(updated_record);
-        }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        KeyGen::Type::makeKey(baseType, ast_context), CacheType::TYPE,
+        derivedTypeModel,
+        &DbModel::DerivedType::type_id);
   }
 
   // Process array sizes for array types
@@ -355,7 +391,8 @@ int TypeProcessor::processDerivedType(
   return derivedTypeId;
 }
 
-int TypeProcessor::processUserType(const Type *TP, ASTContext *ast_context) {
+int64_t TypeProcessor::processUserType(const Type *TP,
+                                       ASTContext *ast_context) {
   // Check for typedef types FIRST before getting tag decl
   // This is important because a typedef of an enum should be processed as a typedef
   const TypedefNameDecl *TND = nullptr;
@@ -397,10 +434,13 @@ int TypeProcessor::processUserType(const Type *TP, ASTContext *ast_context) {
     kind = static_cast<int>(
         UserTypeKind::TEMPLATE_PARAMETER); // template_parameter
 
-  DbModel::UserType userTypeModel = {GENID(UserType), typeName, kind};
+  DbModel::UserType userTypeModel = {GENID(UserType), INTERN(typeName), kind};
   KeyType userTypeKey = KeyGen::Type::makeKey(TD, ast_context);
   LOG_DEBUG << "UserType Key: " << userTypeKey << std::endl;
-  INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
+  // 同一类型已由其他TU或工作线程登记时直接沿用其ID
+  const int64_t typeId = INSERT_TYPE_CACHE(userTypeKey, userTypeModel.id);
+  if (typeId != userTypeModel.id)
+    return typeId;
   STG.insertClassObj(userTypeModel);
 
   // Process more detail about user_type
@@ -424,7 +464,8 @@ int TypeProcessor::processUserType(const Type *TP, ASTContext *ast_context) {
   return userTypeModel.id;
 }
 
-void TypeProcessor::processEnumConstants(const EnumDecl *ED, int parentEnumId) {
+void TypeProcessor::processEnumConstants(const EnumDecl *ED,
+                                         int64_t parentEnumId) {
   LOG_DEBUG << "processEnumConstants: Processing enum with parent ID: " << parentEnumId << std::endl;
   int index = 0;
   for (const EnumConstantDecl *ECD : ED->enumerators()) {
@@ -432,7 +473,7 @@ void TypeProcessor::processEnumConstants(const EnumDecl *ED, int parentEnumId) {
               << " at index " << index << std::endl;
 
     // Record location
-    LocIdPair *locIdPair = SrcLocRecorder::processDefault(ECD, ast_context_);
+    LocIdPair locIdPair = SrcLocRecorder::processDefault(ECD, ast_context_);
 
     // Create enum constant record
     // Note: type_id is set to parentEnumId since enum constants have the enum type
@@ -443,7 +484,7 @@ void TypeProcessor::processEnumConstants(const EnumDecl *ED, int parentEnumId) {
         index,
         parentEnumId,  // Enum constants have the same type as their parent enum
         ECD->getNameAsString(),
-        locIdPair->spec_id};
+        locIdPair.spec_id};
 
     STG.insertClassObj(enumConstant);
     LOG_DEBUG << "processEnumConstants: Inserted enum constant with ID: "
@@ -453,17 +494,19 @@ void TypeProcessor::processEnumConstants(const EnumDecl *ED, int parentEnumId) {
   }
 }
 
-void TypeProcessor::processTypedefBase(const TypedefNameDecl *TND, int typedefId) {
+void TypeProcessor::processTypedefBase(const TypedefNameDecl *TND,
+                                       int64_t typedefId) {
   // Get the underlying type
   QualType underlyingType = TND->getUnderlyingType();
-  int type_id = processType(underlyingType.getTypePtr());
+  int64_t type_id = processType(underlyingType.getTypePtr());
 
   // Create typedef base mapping
   DbModel::TypedefBase typedefBase = {typedefId, type_id};
   STG.insertClassObj(typedefBase);
 }
 
-void TypeProcessor::processArraySizes(const ArrayType *AT, int derivedTypeId) {
+void TypeProcessor::processArraySizes(const ArrayType *AT,
+                                      int64_t derivedTypeId) {
   // Get number of elements (0 for incomplete arrays)
   int num_elements = 0;
   int bytesize = 0;
@@ -484,7 +527,8 @@ void TypeProcessor::processArraySizes(const ArrayType *AT, int derivedTypeId) {
   STG.insertClassObj(arraySizes);
 }
 
-void TypeProcessor::processPointerishSize(const Type *T, int derivedTypeId) {
+void TypeProcessor::processPointerishSize(const Type *T,
+                                          int64_t derivedTypeId) {
   // Get pointer size and alignment from AST context
   int size = 0;
   int alignment = 0;
@@ -501,34 +545,31 @@ void TypeProcessor::processPointerishSize(const Type *T, int derivedTypeId) {
   STG.insertClassObj(pointerishSize);
 }
 
-int TypeProcessor::processRoutineType(const Type *TP, ASTContext *ast_context) {
+int64_t TypeProcessor::processRoutineType(const Type *TP,
+                                          ASTContext *ast_context) {
   const FunctionType *FT = TP->getAs<FunctionType>();
   if (!FT)
     return -1;
 
-  int routineTypeId = GENID(RoutineType);
+  int64_t routineTypeId = GENID(RoutineType);
   QualType returnType = FT->getReturnType();
-  KeyType returnTypeKey = KeyGen::Type::makeKey(returnType, ast_context);
 
-  if (auto cachedId = SEARCH_TYPE_CACHE(returnTypeKey)) {
+  if (auto cachedId = KeyGen::Type::findId(returnType, ast_context)) {
     DbModel::RoutineType routineTypeModel = {routineTypeId, *cachedId};
     STG.insertClassObj(routineTypeModel);
   } else {
     DbModel::RoutineType routineTypeModel = {routineTypeId, -1};
     STG.insertClassObj(routineTypeModel);
-    PendingUpdate update{
-        returnTypeKey, CacheType::TYPE, [routineTypeId](int resolvedId) {
-          DbModel::RoutineType updated_record = {routineTypeId, resolvedId};
-          STG.insertClassObj(updated_record);
-        }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        KeyGen::Type::makeKey(returnType, ast_context), CacheType::TYPE,
+        routineTypeModel,
+        &DbModel::RoutineType::return_type);
   }
 
   if (const FunctionProtoType *FPT = dyn_cast<FunctionProtoType>(FT)) {
     for (unsigned index = 0; index < FPT->getNumParams(); ++index) {
       QualType paramType = FPT->getParamType(index);
-      KeyType paramTypeKey = KeyGen::Type::makeKey(paramType, ast_context);
-      if (auto cachedId = SEARCH_TYPE_CACHE(paramTypeKey)) {
+      if (auto cachedId = KeyGen::Type::findId(paramType, ast_context)) {
         DbModel::RoutineTypeArg routineTypeArgModel = {
             routineTypeId, static_cast<int>(index), *cachedId};
         STG.insertClassObj(routineTypeArgModel);
@@ -536,71 +577,59 @@ int TypeProcessor::processRoutineType(const Type *TP, ASTContext *ast_context) {
         DbModel::RoutineTypeArg routineTypeArgModel = {
             routineTypeId, static_cast<int>(index), -1};
         STG.insertClassObj(routineTypeArgModel);
-        PendingUpdate update{paramTypeKey, CacheType::TYPE,
-                             [routineTypeId, index](int resolvedId) {
-                               DbModel::RoutineTypeArg updated_record = {
-                                   routineTypeId, static_cast<int>(index),
-                                   resolvedId};
-                               STG.insertClassObj(updated_record);
-                             }};
-        DependencyManager::instance().addDependency(update);
+        DependencyManager::instance().addDependency(
+            KeyGen::Type::makeKey(paramType, ast_context), CacheType::TYPE,
+            routineTypeArgModel,
+            &DbModel::RoutineTypeArg::type_id);
       }
     }
   }
   return routineTypeId;
 }
 
-int TypeProcessor::processPtrToMemberType(const MemberPointerType *MPT,
-                                          ASTContext *ast_context) {
-  int ptrToMemberId = GENID(PtrToMember);
+int64_t TypeProcessor::processPtrToMemberType(const MemberPointerType *MPT,
+                                              ASTContext *ast_context) {
+  int64_t ptrToMemberId = GENID(PtrToMember);
   QualType pointeeType = MPT->getPointeeType();
   const Type *classType = MPT->getAs<Type>();
 
-  KeyType pointeeTypeKey = KeyGen::Type::makeKey(pointeeType, ast_context);
-  KeyType classTypeKey =
-      KeyGen::Type::makeKey(classType->getCanonicalTypeInternal(), ast_context);
+  QualType classQualType = classType->getCanonicalTypeInternal();
 
-  auto pointeeIdOpt = SEARCH_TYPE_CACHE(pointeeTypeKey);
-  auto classIdOpt = SEARCH_TYPE_CACHE(classTypeKey);
+  auto pointeeIdOpt = KeyGen::Type::findId(pointeeType, ast_context);
+  auto classIdOpt = KeyGen::Type::findId(classQualType, ast_context);
 
-  int pointeeTypeId = pointeeIdOpt.value_or(-1);
-  int classTypeId = classIdOpt.value_or(-1);
+  int64_t pointeeTypeId = pointeeIdOpt.value_or(-1);
+  int64_t classTypeId = classIdOpt.value_or(-1);
 
   DbModel::PtrToMember ptrToMemberModel = {ptrToMemberId, pointeeTypeId,
                                            classTypeId};
   STG.insertClassObj(ptrToMemberModel);
 
   if (!pointeeIdOpt) {
-    PendingUpdate update{pointeeTypeKey, CacheType::TYPE,
-                         [ptrToMemberId, classTypeId](int resolvedId) {
-                           DbModel::PtrToMember updated_record = {
-                               ptrToMemberId, resolvedId, classTypeId};
-                           STG.insertClassObj(updated_record);
-                         }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        KeyGen::Type::makeKey(pointeeType, ast_context), CacheType::TYPE,
+        DbModel::PtrToMember{ptrToMemberId, -1, classTypeId},
+        &DbModel::PtrToMember::type_id);
   }
 
   if (!classIdOpt) {
-    PendingUpdate update{classTypeKey, CacheType::TYPE,
-                         [ptrToMemberId, pointeeTypeId](int resolvedId) {
-                           DbModel::PtrToMember updated_record = {
-                               ptrToMemberId, pointeeTypeId, resolvedId};
-                           STG.insertClassObj(updated_record);
-                         }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        KeyGen::Type::makeKey(classQualType, ast_context), CacheType::TYPE,
+        DbModel::PtrToMember{ptrToMemberId, pointeeTypeId, -1},
+        &DbModel::PtrToMember::class_id);
   }
 
   return ptrToMemberId;
 }
 
-int TypeProcessor::processDeclType(const DecltypeType *DT,
-                                   ASTContext *ast_context) {
-  int declTypeId = GENID(DeclType);
+int64_t TypeProcessor::processDeclType(const DecltypeType *DT,
+                                       ASTContext *ast_context) {
+  int64_t declTypeId = GENID(DeclType);
   const Expr *expr = DT->getUnderlyingExpr();
   QualType baseType = DT->getUnderlyingType();
   bool parenthesesWouldChange = DT->isReferenceType();
 
-  int exprId = -1;
+  int64_t exprId = -1;
   if (expr) {
     KeyType exprKey = KeyGen::Expr_::makeKey(expr, ast_context);
     if (auto cachedId = SEARCH_EXPR_CACHE(exprKey)) {
@@ -608,9 +637,8 @@ int TypeProcessor::processDeclType(const DecltypeType *DT,
     }
   }
 
-  KeyType typeKey = KeyGen::Type::makeKey(baseType, ast_context);
-  auto typeIdOpt = SEARCH_TYPE_CACHE(typeKey);
-  int typeId = typeIdOpt.value_or(-1);
+  auto typeIdOpt = KeyGen::Type::findId(baseType, ast_context);
+  int64_t typeId = typeIdOpt.value_or(-1);
 
   DbModel::DeclType declTypeModel = {declTypeId, exprId, typeId,
                                      parenthesesWouldChange};
@@ -618,25 +646,17 @@ int TypeProcessor::processDeclType(const DecltypeType *DT,
 
   if (expr && exprId == -1) {
     KeyType exprKey = KeyGen::Expr_::makeKey(expr, ast_context);
-    PendingUpdate update{
+    DependencyManager::instance().addDependency(
         exprKey, CacheType::EXPR,
-        [declTypeId, typeId, parenthesesWouldChange](int resolvedId) {
-          DbModel::DeclType updated_record = {declTypeId, resolvedId, typeId,
-                                              parenthesesWouldChange};
-          STG.insertClassObj(updated_record);
-        }};
-    DependencyManager::instance().addDependency(update);
+        DbModel::DeclType{declTypeId, -1, typeId, parenthesesWouldChange},
+        &DbModel::DeclType::expr);
   }
 
   if (!typeIdOpt) {
-    PendingUpdate update{
-        typeKey, CacheType::TYPE,
-        [declTypeId, exprId, parenthesesWouldChange](int resolvedId) {
-          DbModel::DeclType updated_record = {declTypeId, exprId, resolvedId,
-                                              parenthesesWouldChange};
-          STG.insertClassObj(updated_record);
-        }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        KeyGen::Type::makeKey(baseType, ast_context), CacheType::TYPE,
+        DbModel::DeclType{declTypeId, exprId, -1, parenthesesWouldChange},
+        &DbModel::DeclType::base_type);
   }
 
   return declTypeId;
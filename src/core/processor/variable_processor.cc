@@ -13,54 +13,54 @@
 #include <clang/AST/DeclCXX.h>
 #include <clang/Basic/LLVM.h>
 
-int VariableProcessor::processVarDecl(const VarDecl *VD) {
+int64_t VariableProcessor::processVarDecl(const VarDecl *VD) {
+  PROCESSOR_SCOPE();
   if (!VD || VD->isImplicit())
     return -1;
 
-  KeyType VDKey = KeyGen::Var::makeKey(VD, ast_context_);
-  if (SEARCH_VARIABLE_CACHE(VDKey))
+  if (KeyGen::Var::findId(VD, ast_context_))
     return -1;
 
-  int varId;
+  int64_t varId;
 
   // Classify VarDecl first to get the specific variable ID
   // REFACTORED: Use direct entity IDs instead of intermediary variable IDs
   if (llvm::isa<clang::FieldDecl>(VD) ||
       (VD->getDeclContext()->isRecord() && VD->isCXXClassMember())) {
     varId = processMemberVar(VD); // @membervariable
+    if (varId == -1)
+      return -1; // 其他工作线程已登记该变量
   } else if (VD->hasGlobalStorage() && !VD->isStaticLocal() &&
              VD->getDeclContext()->isFileContext()) {
     varId = processGlobalVar(VD); // @globalvariable
+    if (varId == -1)
+      return -1;
   } else {
     varId = processLocalScopeVar(VD); // @localvariables or @params directly
   }
 
-  LocIdPair *locIdPair = SrcLocRecorder::processDefault(VD, ast_context_);
-  _name = VD->getNameAsString();
+  LocIdPair locIdPair = SrcLocRecorder::processDefault(VD, ast_context_);
+  _name = INTERN(VD->getNameAsString());
   _varDeclId = GENID(VarDecl);
 
   // Handle Type Dependency
-  KeyType typeKey = KeyGen::Type::makeKey(VD->getType(), ast_context_);
-  LOG_DEBUG << "Variable TypeKey: " << typeKey << std::endl;
-  if (auto cachedId = SEARCH_TYPE_CACHE(typeKey)) {
+  if (auto cachedId = KeyGen::Type::findId(VD->getType(), ast_context_)) {
     _typeId = *cachedId;
   } else {
     _typeId = -1;
-    PendingUpdate update{typeKey, CacheType::TYPE,
-                         [_varDeclId = _varDeclId, varId = varId, name = _name,
-                          spec_id = locIdPair->spec_id](int resolvedId) {
-                           DbModel::VarDecl updated_record = {
-                               _varDeclId, varId, resolvedId, name, spec_id};
-                           STG.insertClassObj(updated_record);
-                         }};
-    DependencyManager::instance().addDependency(update);
+    KeyType typeKey = KeyGen::Type::makeKey(VD->getType(), ast_context_);
+    LOG_DEBUG << "Variable TypeKey: " << typeKey << std::endl;
+    DependencyManager::instance().addDependency(
+        typeKey, CacheType::TYPE,
+        DbModel::VarDecl{_varDeclId, varId, -1, _name, locIdPair.spec_id},
+        &DbModel::VarDecl::type_id);
   }
 
   DbModel::VarDecl varDecl = {_varDeclId, varId, _typeId, _name,
-                              locIdPair->spec_id};
+                              locIdPair.spec_id};
 
   // Maintain cache
-  INSERT_VARIABLE_CACHE(VDKey, varId);
+  INSERT_VARIABLE_CACHE(KeyGen::Var::makeKey(VD, ast_context_), varId);
 
   if (VD->isThisDeclarationADefinition()) {
     DbModel::VarDef varDef = {_varDeclId};
@@ -101,18 +101,14 @@ void VariableProcessor::recordRequire(const VarDecl *VD) {
   } else {
     DbModel::VarRequire varRequire = {_varDeclId, -1};
     STG.insertClassObj(varRequire);
-    PendingUpdate update{
-        exprKey, CacheType::EXPR, [_varDeclId = _varDeclId](int resolvedId) {
-          DbModel::VarRequire updated_record = {_varDeclId, resolvedId};
-          STG.insertClassObj(updated_record);
-        }};
-    DependencyManager::instance().addDependency(update);
+    DependencyManager::instance().addDependency(
+        exprKey, CacheType::EXPR, varRequire, &DbModel::VarRequire::constraint);
   }
 }
 
 // Process Local Scope Variable, return direct entity ID
 // REFACTORED: Return direct entity IDs instead of LocalScopeVar intermediary
-int VariableProcessor::processLocalScopeVar(const VarDecl *VD) {
+int64_t VariableProcessor::processLocalScopeVar(const VarDecl *VD) {
   if (llvm::isa<clang::ParmVarDecl>(VD)) { // FIXME: No function context
     return processParam(VD);               // @params
   } else {
@@ -121,15 +117,15 @@ int VariableProcessor::processLocalScopeVar(const VarDecl *VD) {
 }
 
 // Process Local Variable. return id @localvariables
-int VariableProcessor::processLocalVar(const VarDecl *VD) {
+int64_t VariableProcessor::processLocalVar(const VarDecl *VD) {
   DbModel::LocalVar localVar = {GENID(LocalVar), _typeId,
-                                VD->getNameAsString()};
+                                INTERN(VD->getNameAsString())};
   STG.insertClassObj(localVar);
   return localVar.id;
 }
 
 // Process parameter. return id @params
-int VariableProcessor::processParam(const VarDecl *VD) {
+int64_t VariableProcessor::processParam(const VarDecl *VD) {
   const FunctionDecl *FD = dyn_cast<FunctionDecl>(VD->getDeclContext());
 
   if (!FD) {
@@ -159,91 +155,89 @@ int VariableProcessor::processParam(const VarDecl *VD) {
 
   // Get parameterized element
   KeyType elementKey = KeyGen::Element::makeKey(FD, ast_context_);
-  int elementId = -1;
-  if (auto cachedId = SEARCH_ELEMENT_CACHE(elementKey)) {
+  int64_t elementId = -1;
+  if (auto cachedId = SEARCH_ELEMENT_CACHE(elementKey))
     elementId = *cachedId;
-  } else {
-    PendingUpdate update{elementKey, CacheType::ELEMENT,
-                         [paramId = GENID(Parameter), index = index,
-                          typeId = _typeId](int resolvedId) {
-                           DbModel::Parameter updated_record = {
-                               paramId, resolvedId, static_cast<int>(index),
-                               typeId};
-                           STG.insertClassObj(updated_record);
-                         }};
-    DependencyManager::instance().addDependency(update);
-  }
 
   DbModel::Parameter param = {GENID(Parameter), elementId,
                               static_cast<int>(index), _typeId};
   STG.insertClassObj(param);
+  if (elementId == -1)
+    DependencyManager::instance().addDependency(
+        elementKey, CacheType::ELEMENT, param, &DbModel::Parameter::function);
   return param.id;
 }
 
 // Process Global Variable, return id @globalvariable
-int VariableProcessor::processGlobalVar(const VarDecl *VD) {
+// 全局变量可能同时被多个TU声明, 登记失败(已由其他工作线程写入)时返回 -1
+int64_t VariableProcessor::processGlobalVar(const VarDecl *VD) {
   DbModel::GlobalVar globalVar = {GENID(GlobalVar), _typeId,
-                                  VD->getNameAsString()};
+                                  INTERN(VD->getNameAsString())};
+  if (!claimVar(VD, globalVar.id))
+    return -1;
   STG.insertClassObj(globalVar);
   return globalVar.id;
 }
 
 // Process Member Variable, return id @membervariable
-int VariableProcessor::processMemberVar(const VarDecl *VD) {
+int64_t VariableProcessor::processMemberVar(const VarDecl *VD) {
   DbModel::MemberVar memberVar = {GENID(MemberVar), _typeId, _name};
+  if (!claimVar(VD, memberVar.id))
+    return -1;
   STG.insertClassObj(memberVar);
   return memberVar.id;
 }
 
-int VariableProcessor::processParmVarDecl(const ParmVarDecl *PVD) {
+bool VariableProcessor::claimVar(const VarDecl *VD, int64_t varId) {
+  return INSERT_VARIABLE_CACHE(KeyGen::Var::makeKey(VD, ast_context_),
+                               varId) == varId;
+}
+
+int64_t VariableProcessor::processParmVarDecl(const ParmVarDecl *PVD) {
+  PROCESSOR_SCOPE();
   if (!PVD || PVD->isImplicit())
     return -1;
 
   // Process parameter and get var ID
-  int varId = processParam(PVD);
+  int64_t varId = processParam(PVD);
 
   // Generate var_decl_id and create VarDecl record
-  LocIdPair *locIdPair = SrcLocRecorder::processDefault(PVD, ast_context_);
-  _name = PVD->getNameAsString();
+  LocIdPair locIdPair = SrcLocRecorder::processDefault(PVD, ast_context_);
+  _name = INTERN(PVD->getNameAsString());
   _varDeclId = GENID(VarDecl);
 
   // Handle Type Dependency
-  KeyType typeKey = KeyGen::Type::makeKey(PVD->getType(), ast_context_);
-  LOG_DEBUG << "Parameter TypeKey: " << typeKey << std::endl;
-  if (auto cachedId = SEARCH_TYPE_CACHE(typeKey)) {
+  if (auto cachedId = KeyGen::Type::findId(PVD->getType(), ast_context_)) {
     _typeId = *cachedId;
   } else {
     _typeId = -1;
-    PendingUpdate update{typeKey, CacheType::TYPE,
-                         [_varDeclId = _varDeclId, varId = varId, name = _name,
-                          spec_id = locIdPair->spec_id](int resolvedId) {
-                           DbModel::VarDecl updated_record = {
-                               _varDeclId, varId, resolvedId, name, spec_id};
-                           STG.insertClassObj(updated_record);
-                         }};
-    DependencyManager::instance().addDependency(update);
+    KeyType typeKey = KeyGen::Type::makeKey(PVD->getType(), ast_context_);
+    LOG_DEBUG << "Parameter TypeKey: " << typeKey << std::endl;
+    DependencyManager::instance().addDependency(
+        typeKey, CacheType::TYPE,
+        DbModel::VarDecl{_varDeclId, varId, -1, _name, locIdPair.spec_id},
+        &DbModel::VarDecl::type_id);
   }
 
   DbModel::VarDecl varDecl = {_varDeclId, varId, _typeId, _name,
-                              locIdPair->spec_id};
+                              locIdPair.spec_id};
   STG.insertClassObj(varDecl);
   return _varDeclId;
 }
 
-int VariableProcessor::processFieldDecl(const FieldDecl *FD) {
+int64_t VariableProcessor::processFieldDecl(const FieldDecl *FD) {
+  PROCESSOR_SCOPE();
   if (!FD)
     return -1;
 
   // Process member variable and get var ID
-  LocIdPair *locIdPair = SrcLocRecorder::processDefault(FD, ast_context_);
-  _name = FD->getNameAsString();
+  LocIdPair locIdPair = SrcLocRecorder::processDefault(FD, ast_context_);
+  _name = INTERN(FD->getNameAsString());
   _varDeclId = GENID(VarDecl);
 
   // Handle Type Dependency - _typeId will be set by ASTVisitor before calling
   // this
-  KeyType typeKey = KeyGen::Type::makeKey(FD->getType(), ast_context_);
-  LOG_DEBUG << "Field TypeKey: " << typeKey << std::endl;
-  if (auto cachedId = SEARCH_TYPE_CACHE(typeKey)) {
+  if (auto cachedId = KeyGen::Type::findId(FD->getType(), ast_context_)) {
     _typeId = *cachedId;
   } else {
     _typeId = -1;
@@ -252,35 +246,37 @@ int VariableProcessor::processFieldDecl(const FieldDecl *FD) {
   }
 
   // Process member variable to get varId
-  int varId = processMemberVar(FD);
+  int64_t varId = processMemberVar(FD);
 
   DbModel::VarDecl varDecl = {_varDeclId, varId, _typeId, _name,
-                              locIdPair->spec_id};
+                              locIdPair.spec_id};
   STG.insertClassObj(varDecl);
   return _varDeclId;
 }
 
-int VariableProcessor::processMemberVar(const FieldDecl *FD) {
+int64_t VariableProcessor::processMemberVar(const FieldDecl *FD) {
   // For fields, _typeId should be set by the caller before calling this method
   return resolveMemberVarId(FD, _typeId);
 }
 
-int VariableProcessor::resolveMemberVarId(const FieldDecl *FD, int type_id) {
+int64_t VariableProcessor::resolveMemberVarId(const FieldDecl *FD,
+                                              int64_t type_id) {
   if (!FD)
     return -1;
 
-  const std::string name = FD->getNameAsString();
-  KeyType fieldKey = KeyGen::Var::makeKey(FD, ast_context_);
-
-  if (auto cachedId = SEARCH_MEMBERVAR_CACHE(fieldKey)) {
+  const InternedString name = INTERN(FD->getNameAsString());
+  if (auto cachedId = KeyGen::Var::findId(FD, ast_context_)) {
     LOG_DEBUG << "MemberVar '" << name
               << "' found in cache with ID: " << *cachedId << std::endl;
     return *cachedId;
   }
 
   DbModel::MemberVar memberVar = {GENID(MemberVar), type_id, name};
+  KeyType fieldKey = KeyGen::Var::makeKey(FD, ast_context_);
+  if (const int64_t winner = INSERT_MEMBERVAR_CACHE(fieldKey, memberVar.id);
+      winner != memberVar.id)
+    return winner;
   STG.insertClassObj(memberVar);
-  INSERT_MEMBERVAR_CACHE(fieldKey, memberVar.id);
 
   LOG_DEBUG << "Created and cached MemberVar '" << name
             << "' with key: " << fieldKey << " -> ID: " << memberVar.id
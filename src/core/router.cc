@@ -2,27 +2,100 @@
 #include "core/ast_visitor.h"
 #include "core/clang_ast_manager.h"
 #include "core/compilation_recorder.h"
+#include "core/focus_filter.h"
+#include "core/header_registry.h"
+#include "core/incremental_tracker.h"
+#include "db/cache_repository.h"
 #include "db/dependency_manager.h"
+#include "db/storage_facade.h"
+#include "model/db/incremental.h"
 #include "util/hires_timer.h"
 #include "util/logger/macros.h"
-#include <filesystem>
+#include "util/logger/perf_log.h"
+#include "util/processor_metrics.h"
+#include "util/string_pool.h"
+#include <clang/Basic/SourceManager.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// 输出各处理器的累计计数, 耗时为处理器自身耗时, 只在开启性能日志时统计
+void logProcessorMetrics() {
+  ProcessorMetrics &metrics = ProcessorMetrics::getInstance();
+  char line[160];
+  std::snprintf(line, sizeof(line), "%-22s %10s %10s %10s %10s %10s",
+                "processor", "nodes", "rows", "hits", "misses", "ms");
+  LOG_INFO << "Processor metrics:" << std::endl;
+  LOG_INFO << line << std::endl;
+  for (size_t i = 0; i < static_cast<size_t>(ProcessorKind::Count); ++i) {
+    const auto kind = static_cast<ProcessorKind>(i);
+    const ProcessorCounters counters = metrics.total(kind);
+    if (counters.nodes == 0)
+      continue;
+    std::snprintf(line, sizeof(line),
+                  "%-22s %10llu %10llu %10llu %10llu %10.1f",
+                  ProcessorMetrics::name(kind),
+                  static_cast<unsigned long long>(counters.nodes),
+                  static_cast<unsigned long long>(counters.rows),
+                  static_cast<unsigned long long>(counters.cache_hits),
+                  static_cast<unsigned long long>(counters.cache_misses),
+                  counters.time_ns / 1e6);
+    LOG_INFO << line << std::endl;
+  }
+}
+
+} // namespace
 
 void Router::processCompilation(const Configuration &config) {
   CompRecorder &recorder = CompRecorder::getInstance();
 
+  // 增量模式下沿用上次的文件记录与ID计数器, 需先于任何ID的生成
+  IncrementalTracker &tracker = IncrementalTracker::getInstance();
+  tracker.setEnabled(config.database.incremental);
+  tracker.loadState();
+
   // 创建编译记录
   recorder.createCompilation(config.compilation.working_directory);
 
-  // 记录编译参数, 文件名
+  // 记录编译参数
   recorder.recordArguments(config.compilation.flags);
-  recorder.recordFile(
-      std::filesystem::path(config.general.source_path).filename().string());
 
   HighResTimer frontend_timer;
   frontend_timer.start();
 
   // 使用ClangASTManager处理AST
-  ClangASTManager::getInstance().loadConfig(config);
+  ClangASTManager &manager = ClangASTManager::getInstance();
+  if (!manager.loadConfig(config))
+    throw std::runtime_error("Failed to load compilation database");
+
+  FocusFilter::getInstance().configure(config.compilation);
+
+  // 未抽取的表族不会产生对应缓存的记录, 引用它们的回填无需登记
+  extraction_ = config.extraction;
+  DependencyManager &dependencies = DependencyManager::instance();
+  dependencies.setCacheTypeEnabled(
+      CacheType::STMT, extraction_.has(ExtractionFamily::Stmts));
+  dependencies.setCacheTypeEnabled(
+      CacheType::EXPR, extraction_.has(ExtractionFamily::Exprs));
+
+  // 增量模式下每个TU需独立写出完整的记录
+  HeaderRegistry::getInstance().setEnabled(config.compilation.dedup_headers &&
+                                           !tracker.isEnabled());
+  if (tracker.isEnabled() && config.compilation.dedup_headers)
+    LOG_INFO << "Incremental extraction writes every translation unit "
+                "separately, header dedup is disabled"
+             << std::endl;
+
+  // 记录本次抽取涉及的全部源文件
+  std::vector<std::string> source_paths =
+      manager.collectSourcePaths(config.general.source_path);
+  for (const auto &source_path : source_paths)
+    recorder.recordFile(source_path);
+  source_paths = tracker.selectSources(source_paths);
 
   // 记录前端耗时
   recorder.recordTime(CompTimeKind::FrontendCpu, frontend_timer.cpu_time());
@@ -32,12 +105,42 @@ void Router::processCompilation(const Configuration &config) {
   HighResTimer extractor_timer;
   extractor_timer.start();
 
-  parseAST(config.general.source_path);
+  unsigned jobs = config.compilation.jobs;
+  if (jobs == 0)
+    jobs = std::max(1u, std::thread::hardware_concurrency());
+  jobs = std::min<unsigned>(jobs, source_paths.size());
+
+  if (tracker.isEnabled()) {
+    if (jobs > 1)
+      LOG_INFO << "Incremental extraction parses translation units sequentially"
+               << std::endl;
+    parseASTIncremental(source_paths);
+  } else if (jobs > 1)
+    parseASTParallel(source_paths, jobs);
+  else
+    parseAST(source_paths);
 
   // Resolve dependencies
   LOG_INFO << "Resolving pending dependencies..." << std::endl;
   DependencyManager::instance().resolveDependencies();
   LOG_INFO << "All dependencies resolved." << std::endl;
+  LOG_INFO << "Interned " << StringPool::getInstance().size()
+           << " distinct strings (" << StringPool::getInstance().bytes()
+           << " bytes)" << std::endl;
+  if (CacheSpill::instance().enabled())
+    LOG_INFO << "Spilled " << CacheSpill::instance().spilledRows()
+             << " cache entries to disk, " << CacheSpill::instance().spillHits()
+             << " lookups served from disk" << std::endl;
+
+  // 记录各缓存仓库的最大规模, 下次运行据此预留容量
+  for (const auto &[name, size] : CacheManager::instance().peakSizes()) {
+    DbModel::CacheSize cache_size = {name, static_cast<int64_t>(size)};
+    STG.insertClassObj(cache_size);
+  }
+
+  logProcessorMetrics();
+  if (config.logger.record_metrics)
+    recorder.recordProcessorMetrics();
 
   // 记录解析耗时
   recorder.recordTime(CompTimeKind::ExtractorCpu, extractor_timer.cpu_time());
@@ -47,15 +150,70 @@ void Router::processCompilation(const Configuration &config) {
   // 完成记录
   recorder.finalize(frontend_timer.cpu_time() + extractor_timer.cpu_time(),
                     frontend_timer.elapsed() + extractor_timer.elapsed());
+  tracker.finish();
 }
 
-void Router::parseAST(const std::string &source_path) {
-  // 使用C++ API处理AST
-  ClangASTManager::getInstance().processAST(
-      source_path,
-      [this](clang::ASTContext &context) { // 这里定义具体的AST处理逻辑
-        // 创建并运行AST访问者
-        ASTVisitor visitor(&context);
-        visitor.TraverseAST(context);
-      });
+void Router::handleTranslationUnit(clang::ASTContext &context) {
+  PERF_SPAN("tu.extract");
+  // 切换当前TU对应的 files 记录
+  const auto &sourceManager = context.getSourceManager();
+  if (auto mainFile =
+          sourceManager.getFileEntryRefForID(sourceManager.getMainFileID()))
+    CompRecorder::getInstance().enterSourceFile(
+        CompRecorder::entryPath(*mainFile, sourceManager));
+
+  // 创建并运行AST访问者
+  ASTVisitor visitor(&context, getInstance().extraction_);
+  visitor.TraverseAST(context);
+
+  IncrementalTracker::getInstance().collectFiles(sourceManager);
+  // 本TU内各 Visit 族累加的耗时
+  PerfLog::getInstance().flushThread();
+}
+
+void Router::parseAST(const std::vector<std::string> &source_paths) {
+  PERF_SPAN("phase.parse");
+  // 使用C++ API处理AST, 每个TU回调一次
+  ClangASTManager::getInstance().processAST(source_paths,
+                                            &Router::handleTranslationUnit);
+}
+
+void Router::parseASTIncremental(
+    const std::vector<std::string> &source_paths) {
+  PERF_SPAN("phase.parse");
+  IncrementalTracker &tracker = IncrementalTracker::getInstance();
+  ClangASTManager &manager = ClangASTManager::getInstance();
+  for (const auto &source_path : source_paths) {
+    tracker.beginTranslationUnit();
+    manager.processAST({source_path}, &Router::handleTranslationUnit);
+    tracker.endTranslationUnit(source_path);
+  }
+}
+
+void Router::parseASTParallel(const std::vector<std::string> &source_paths,
+                              unsigned jobs) {
+  PERF_SPAN("phase.parse");
+  LOG_INFO << "Parsing " << source_paths.size() << " translation units with "
+           << jobs << " worker threads" << std::endl;
+
+  STG.startWriter();
+
+  // 工作线程按顺序领取TU, 各自拥有独立的 ClangTool 和 ASTContext
+  std::atomic<size_t> next_tu{0};
+  auto worker = [&source_paths, &next_tu] {
+    ClangASTManager &manager = ClangASTManager::getInstance();
+    for (size_t i = next_tu++; i < source_paths.size(); i = next_tu++) {
+      manager.processAST({source_paths[i]}, &Router::handleTranslationUnit);
+      STG.flushThreadBatch();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(jobs);
+  for (unsigned i = 0; i < jobs; ++i)
+    workers.emplace_back(worker);
+  for (auto &thread : workers)
+    thread.join();
+
+  STG.stopWriter();
 }
@@ -1,72 +1,88 @@
 #include "core/srcloc_recorder.h"
+#include "core/compilation_recorder.h"
 #include "db/storage_facade.h"
 #include "model/db/location.h"
 #include "util/id_generator.h"
 #include "util/logger/macros.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/Basic/SourceManager.h>
-#include <filesystem>
 #include <iostream>
+#include <mutex>
 
 using namespace DbModel;
 
-LocIdPair *SrcLocRecorder::processDefault(const SourceLocation beginLoc,
-                                          const SourceLocation endLoc,
-                                          ASTContext *context) {
+LocIdPair SrcLocRecorder::processDefault(const SourceLocation beginLoc,
+                                         const SourceLocation endLoc,
+                                         ASTContext *context) {
   return process(beginLoc, endLoc, LocationType::DEFAULT, context);
 }
 
-LocIdPair *SrcLocRecorder::processStmt(const SourceLocation beginLoc,
-                                       const SourceLocation endLoc,
-                                       ASTContext *context) {
+LocIdPair SrcLocRecorder::processStmt(const SourceLocation beginLoc,
+                                      const SourceLocation endLoc,
+                                      ASTContext *context) {
   return process(beginLoc, endLoc, LocationType::STMT, context);
 }
 
-LocIdPair *SrcLocRecorder::processExpr(const SourceLocation beginLoc,
-                                       const SourceLocation endLoc,
-                                       ASTContext *context) {
+LocIdPair SrcLocRecorder::processExpr(const SourceLocation beginLoc,
+                                      const SourceLocation endLoc,
+                                      ASTContext *context) {
   return process(beginLoc, endLoc, LocationType::EXPR, context);
 }
 
-LocIdPair *SrcLocRecorder::processDefault(const Stmt *stmt,
-                                          ASTContext *context) {
+LocIdPair SrcLocRecorder::processDefault(const Stmt *stmt,
+                                         ASTContext *context) {
 
   return process(stmt->getBeginLoc(), stmt->getEndLoc(), LocationType::DEFAULT,
                  context);
 }
 
-LocIdPair *SrcLocRecorder::processStmt(const Stmt *stmt, ASTContext *context) {
+LocIdPair SrcLocRecorder::processStmt(const Stmt *stmt, ASTContext *context) {
   return process(stmt->getBeginLoc(), stmt->getEndLoc(), LocationType::STMT,
                  context);
 }
 
-LocIdPair *SrcLocRecorder::processExpr(const Stmt *stmt, ASTContext *context) {
+LocIdPair SrcLocRecorder::processExpr(const Stmt *stmt, ASTContext *context) {
   return process(stmt->getBeginLoc(), stmt->getEndLoc(), LocationType::EXPR,
                  context);
 }
 
-LocIdPair *SrcLocRecorder::processDefault(const Decl *decl,
-                                          ASTContext *context) {
+LocIdPair SrcLocRecorder::processDefault(const Decl *decl,
+                                         ASTContext *context) {
 
   return process(decl->getBeginLoc(), decl->getEndLoc(), LocationType::DEFAULT,
                  context);
 }
 
-LocIdPair *SrcLocRecorder::processStmt(const Decl *decl, ASTContext *context) {
+LocIdPair SrcLocRecorder::processStmt(const Decl *decl, ASTContext *context) {
   return process(decl->getBeginLoc(), decl->getEndLoc(), LocationType::STMT,
                  context);
 }
 
-LocIdPair *SrcLocRecorder::processExpr(const Decl *decl, ASTContext *context) {
+LocIdPair SrcLocRecorder::processExpr(const Decl *decl, ASTContext *context) {
   return process(decl->getBeginLoc(), decl->getEndLoc(), LocationType::EXPR,
                  context);
 }
 
+std::unordered_map<SrcLocRecorder::LocKey, LocIdPair,
+                   SrcLocRecorder::LocKeyHash>
+    SrcLocRecorder::interned_;
+std::shared_mutex SrcLocRecorder::interned_mutex_;
+thread_local llvm::DenseMap<FileID, int64_t> SrcLocRecorder::file_containers_;
+
+size_t SrcLocRecorder::LocKeyHash::operator()(const LocKey &key) const {
+  size_t h = 0xcbf29ce484222325ULL;
+  for (int64_t v : {key.container, int64_t{key.start_line},
+                    int64_t{key.start_column}, int64_t{key.end_line},
+                    int64_t{key.end_column}, static_cast<int64_t>(key.type)})
+    h = h * 0x100000001b3ULL ^ static_cast<size_t>(v);
+  return h;
+}
+
 // 处理方法实现
-LocIdPair *SrcLocRecorder::process(const SourceLocation beginLoc,
-                                   const SourceLocation endLoc,
-                                   const LocationType type,
-                                   ASTContext *context) {
+LocIdPair SrcLocRecorder::process(const SourceLocation beginLoc,
+                                  const SourceLocation endLoc,
+                                  const LocationType type,
+                                  ASTContext *context) {
   const auto &sourceManager = context->getSourceManager();
 
   // if (beginLoc.isInvalid() || endLoc.isInvalid()) {
@@ -82,60 +98,91 @@ LocIdPair *SrcLocRecorder::process(const SourceLocation beginLoc,
   const unsigned end_line = sourceManager.getSpellingLineNumber(endLoc);
   const unsigned end_column = sourceManager.getSpellingColumnNumber(endLoc);
 
-  // 获取文件信息
-  const FileID fileID = sourceManager.getFileID(beginLoc);
-  const FileEntry *fileEntry = sourceManager.getFileEntryForID(fileID);
-  std::string filename;
+  // 获取文件信息, 与行列号一样取拼写位置所在的文件
+  const FileID fileID =
+      sourceManager.getFileID(sourceManager.getSpellingLoc(beginLoc));
+  const int64_t container = getContainerId(fileID, sourceManager);
+
+  const LocKey key = {container,
+                      static_cast<int>(start_line),
+                      static_cast<int>(start_column),
+                      static_cast<int>(end_line),
+                      static_cast<int>(end_column),
+                      type};
+  {
+    std::shared_lock<std::shared_mutex> lock(interned_mutex_);
+    if (auto it = interned_.find(key); it != interned_.end())
+      return it->second;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(interned_mutex_);
+  // 加写锁前可能已被其他线程记录
+  if (auto it = interned_.find(key); it != interned_.end())
+    return it->second;
+  LocIdPair result = insertLocation(key);
+  interned_.emplace(key, result);
+  return result;
+}
 
-  if (fileEntry) {
-    // 使用较新Clang版本中通用的方法获取文件名
-    llvm::StringRef fileName = sourceManager.getFilename(beginLoc);
-    filename = std::filesystem::path(fileName.str()).filename().string();
+void SrcLocRecorder::enterTranslationUnit() { file_containers_.clear(); }
+
+void SrcLocRecorder::clearInterned() {
+  std::unique_lock<std::shared_mutex> lock(interned_mutex_);
+  interned_.clear();
+}
+
+int64_t SrcLocRecorder::getContainerId(FileID fileID,
+                                       const SourceManager &sourceManager) {
+  auto [it, inserted] = file_containers_.try_emplace(fileID, -1);
+  if (!inserted)
+    return it->second;
+
+  if (auto fileEntry = sourceManager.getFileEntryRefForID(fileID)) {
+    // 路径经 CompRecorder 规范化, 同一文件在不同TU中得到同一记录
+    it->second = CompRecorder::getInstance().resolveFile(
+        CompRecorder::entryPath(*fileEntry, sourceManager));
   } else
     LOG_WARNING << "Could not determine file for statement, use default value"
                 << std::endl;
+  return it->second;
+}
 
-  // 创建位置模型
-  // FIXME: Currently, only one source file will be parsed, so container_id here
-  // is always 0. Update: Can use variable `filename`
+LocIdPair SrcLocRecorder::insertLocation(const LocKey &key) {
   Location locModel;
-  LocIdPair *result = nullptr;
+  LocIdPair result = {-1, -1};
 
-  switch (type) {
+  switch (key.type) {
   case LocationType::DEFAULT: {
     LocationDefault locDefaultModel = {
-        GENID(LocationDefault),       0,
-        static_cast<int>(start_line), static_cast<int>(start_column),
-        static_cast<int>(end_line),   static_cast<int>(end_column)};
+        GENID(LocationDefault), key.container, key.start_line,
+        key.start_column,       key.end_line,  key.end_column};
     locModel = {GENID(Location), locDefaultModel.id};
 
     STG.insertClassObj(locDefaultModel);
     STG.insertClassObj(locModel);
-    result = new LocIdPair{locModel.id, locDefaultModel.id};
+    result = {locModel.id, locDefaultModel.id};
     break;
   }
   case LocationType::STMT: {
     LocationStmt locStmtModel = {
-        GENID(LocationStmt),          0,
-        static_cast<int>(start_line), static_cast<int>(start_column),
-        static_cast<int>(end_line),   static_cast<int>(end_column)};
+        GENID(LocationStmt), key.container, key.start_line,
+        key.start_column,    key.end_line,  key.end_column};
     locModel = {GENID(Location), locStmtModel.id};
 
     STG.insertClassObj(locStmtModel);
     STG.insertClassObj(locModel);
-    result = new LocIdPair{locModel.id, locStmtModel.id};
+    result = {locModel.id, locStmtModel.id};
     break;
   }
   case LocationType::EXPR: {
     LocationExpr locExprModel = {
-        GENID(LocationExpr),          0,
-        static_cast<int>(start_line), static_cast<int>(start_column),
-        static_cast<int>(end_line),   static_cast<int>(end_column)};
+        GENID(LocationExpr), key.container, key.start_line,
+        key.start_column,    key.end_line,  key.end_column};
     locModel = {GENID(Location), locExprModel.id};
 
     STG.insertClassObj(locExprModel);
     STG.insertClassObj(locModel);
-    result = new LocIdPair{locModel.id, locExprModel.id};
+    result = {locModel.id, locExprModel.id};
     break;
   }
   }
@@ -0,0 +1,115 @@
+#include "db/cache_spill.h"
+#include "util/logger/macros.h"
+#include <sqlite3.h>
+#include <stdexcept>
+
+namespace {
+
+void exec(sqlite3 *db, const char *sql) {
+  char *errmsg = nullptr;
+  if (sqlite3_exec(db, sql, nullptr, nullptr, &errmsg) != SQLITE_OK) {
+    std::string message = errmsg ? errmsg : "unknown error";
+    sqlite3_free(errmsg);
+    throw std::runtime_error(std::string("Cache spill: failed to execute \"") +
+                             sql + "\": " + message);
+  }
+}
+
+sqlite3_stmt *prepare(sqlite3 *db, const char *sql) {
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    throw std::runtime_error(std::string("Cache spill: failed to prepare \"") +
+                             sql + "\": " + sqlite3_errmsg(db));
+  return stmt;
+}
+
+} // namespace
+
+CacheSpill::~CacheSpill() {
+  sqlite3_finalize(insert_);
+  sqlite3_finalize(select_);
+  sqlite3_finalize(delete_);
+  sqlite3_close(db_);
+}
+
+void CacheSpill::setMemoryLimit(size_t bytes) {
+  limit_ = bytes;
+  if (limit_ > 0)
+    LOG_INFO << "Cache memory limited to " << (limit_ >> 20)
+             << " MiB, cold entries spill to disk" << std::endl;
+}
+
+bool CacheSpill::account(std::ptrdiff_t delta) {
+  // 无符号回绕相加, 负的 delta 同样成立
+  const size_t change = static_cast<size_t>(delta);
+  size_t total = bytes_.fetch_add(change, std::memory_order_relaxed) + change;
+  return limit_ > 0 && total > limit_;
+}
+
+void CacheSpill::open() {
+  // 空文件名: SQLite 在临时目录(可由 SQLITE_TMPDIR 指定)创建私有库, 关闭时删除
+  if (sqlite3_open_v2("", &db_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
+                      nullptr) != SQLITE_OK)
+    throw std::runtime_error("Cache spill: failed to open temporary database");
+  exec(db_, "PRAGMA journal_mode = OFF");
+  exec(db_, "PRAGMA synchronous = OFF");
+  exec(db_, "CREATE TABLE spill (repo INTEGER, key BLOB, id INTEGER, "
+            "PRIMARY KEY (repo, key)) WITHOUT ROWID");
+  insert_ = prepare(db_, "INSERT OR IGNORE INTO spill VALUES (?, ?, ?)");
+  select_ = prepare(db_, "SELECT id FROM spill WHERE repo = ? AND key = ?");
+  delete_ = prepare(db_, "DELETE FROM spill WHERE repo = ?");
+}
+
+void CacheSpill::write(
+    int repository,
+    const std::vector<std::pair<std::string, std::int64_t>> &rows) {
+  if (rows.empty())
+    return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!db_)
+    open();
+
+  exec(db_, "BEGIN");
+  for (const auto &[key, id] : rows) {
+    sqlite3_bind_int(insert_, 1, repository);
+    sqlite3_bind_blob(insert_, 2, key.data(), static_cast<int>(key.size()),
+                      SQLITE_STATIC);
+    sqlite3_bind_int64(insert_, 3, id);
+    int rc = sqlite3_step(insert_);
+    sqlite3_reset(insert_);
+    if (rc != SQLITE_DONE) {
+      sqlite3_exec(db_, "ROLLBACK", nullptr, nullptr, nullptr);
+      throw std::runtime_error(std::string("Cache spill: failed to write: ") +
+                               sqlite3_errmsg(db_));
+    }
+  }
+  exec(db_, "COMMIT");
+  spilled_rows_ += rows.size();
+}
+
+std::optional<std::int64_t> CacheSpill::lookup(int repository,
+                                               std::string_view key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!db_)
+    return std::nullopt;
+
+  sqlite3_bind_int(select_, 1, repository);
+  sqlite3_bind_blob(select_, 2, key.data(), static_cast<int>(key.size()),
+                    SQLITE_STATIC);
+  std::optional<std::int64_t> id;
+  if (sqlite3_step(select_) == SQLITE_ROW) {
+    id = sqlite3_column_int64(select_, 0);
+    ++spill_hits_;
+  }
+  sqlite3_reset(select_);
+  return id;
+}
+
+void CacheSpill::drop(int repository) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!db_)
+    return;
+  sqlite3_bind_int(delete_, 1, repository);
+  sqlite3_step(delete_);
+  sqlite3_reset(delete_);
+}
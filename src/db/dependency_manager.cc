@@ -7,76 +7,75 @@
 #include "model/db/type.h"
 #include "model/db/variable.h"
 #include "util/logger/macros.h"
-#include <optional>
+#include "util/logger/perf_log.h"
 
 DependencyManager &DependencyManager::instance() {
   static DependencyManager instance;
   return instance;
 }
 
-void DependencyManager::addDependency(const PendingUpdate &update) {
-  pending_updates_.push_back(update);
+size_t DependencyManager::nextSlot() {
+  static std::atomic<size_t> slot_count{0};
+  return slot_count++;
 }
 
-void DependencyManager::resolveDependencies() {
-  for (const auto &update : pending_updates_) {
-    std::optional<int> resolvedId;
+template <typename Model>
+static void findIdsIn(const std::vector<KeyType> &keys,
+                      std::vector<std::optional<int64_t>> &ids) {
+  const auto &repository =
+      CacheManager::instance().getRepository<CacheRepository<Model>>();
+  ids.clear();
+  ids.reserve(keys.size());
+  for (const auto &key : keys)
+    ids.push_back(repository.find(key));
+}
 
-    // 根据 keyType 从正确的缓存中查找 ID
-    switch (update.keyType) {
-    case CacheType::FUNCTION:
-      resolvedId = CacheManager::instance()
-                       .getRepository<CacheRepository<DbModel::Function>>()
-                       .find(update.dependencyKey);
-      break;
-    case CacheType::TYPE:
-      resolvedId = CacheManager::instance()
-                       .getRepository<CacheRepository<DbModel::Type>>()
-                       .find(update.dependencyKey);
-      break;
-    case CacheType::USERTYPE:
-      resolvedId = CacheManager::instance()
-                       .getRepository<CacheRepository<DbModel::UserType>>()
-                       .find(update.dependencyKey);
-      break;
-    case CacheType::STMT:
-      resolvedId = CacheManager::instance()
-                       .getRepository<CacheRepository<DbModel::Stmt>>()
-                       .find(update.dependencyKey);
-      break;
-    case CacheType::EXPR:
-      resolvedId = CacheManager::instance()
-                       .getRepository<CacheRepository<DbModel::Expr>>()
-                       .find(update.dependencyKey);
-      break;
-    case CacheType::VARIABLE:
-      resolvedId = CacheManager::instance()
-                       .getRepository<CacheRepository<DbModel::Variable>>()
-                       .find(update.dependencyKey);
-      break;
-    case CacheType::ELEMENT:
-      resolvedId =
-          CacheManager::instance()
-              .getRepository<CacheRepository<DbModel::ParameterizedElement>>()
-              .find(update.dependencyKey);
-      break;
-    case CacheType::MEMBERVERY:
-      resolvedId = CacheManager::instance()
-                       .getRepository<CacheRepository<DbModel::MemberVar>>()
-                       .find(update.dependencyKey);
-      break;
-    }
+void DependencyManager::findIds(CacheType keyType,
+                                const std::vector<KeyType> &keys,
+                                std::vector<std::optional<int64_t>> &ids) {
+  // 根据 keyType 从正确的缓存中查找 ID, 每组只取一次缓存
+  switch (keyType) {
+  case CacheType::FUNCTION:
+    findIdsIn<DbModel::Function>(keys, ids);
+    break;
+  case CacheType::TYPE:
+    findIdsIn<DbModel::Type>(keys, ids);
+    break;
+  case CacheType::USERTYPE:
+    findIdsIn<DbModel::UserType>(keys, ids);
+    break;
+  case CacheType::STMT:
+    findIdsIn<DbModel::Stmt>(keys, ids);
+    break;
+  case CacheType::EXPR:
+    findIdsIn<DbModel::Expr>(keys, ids);
+    break;
+  case CacheType::VARIABLE:
+    findIdsIn<DbModel::Variable>(keys, ids);
+    break;
+  case CacheType::ELEMENT:
+    findIdsIn<DbModel::ParameterizedElement>(keys, ids);
+    break;
+  case CacheType::MEMBERVERY:
+    findIdsIn<DbModel::MemberVar>(keys, ids);
+    break;
+  }
+}
 
-    if (resolvedId) {
-      // 找到ID，执行之前注册的回调函数
-      update.updater(*resolvedId);
-      LOG_DEBUG << "Dependency resolved for key: " << update.dependencyKey
-                << std::endl;
-    } else {
-      LOG_WARNING << "Failed to resolve dependency for key: "
-                  << update.dependencyKey << std::endl;
-    }
+void DependencyManager::resolveDependencies() {
+  PERF_SPAN("phase.dependencies");
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t resolved = 0, unresolved = 0;
+  // 每个表的每个被回填列各执行一组 UPDATE, 只改写该列
+  for (auto &store : stores_) {
+    if (!store)
+      continue;
+    auto [ok, failed] = store->resolve();
+    resolved += ok;
+    unresolved += failed;
   }
+  LOG_DEBUG << "Dependencies resolved: " << resolved
+            << ", unresolved: " << unresolved << std::endl;
   // 清空已处理的依赖，为下一轮分析做准备
-  pending_updates_.clear();
+  stores_.clear();
 }
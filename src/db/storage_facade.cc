@@ -1,14 +1,121 @@
 #include "db/storage_facade.h"
 #include "db/storage.h"
+#include "util/logger/macros.h"
+#include "util/logger/perf_log.h"
+#include "util/processor_metrics.h"
+#include <algorithm>
+#include <exception>
+#include <type_traits>
+
+namespace {
+// SQLite 3.32 起单条语句默认最多绑定 32766 个参数
+constexpr size_t kMaxBoundVariables = 32766;
+// 多行 REPLACE 语句的行数上限, 足以摊薄单步开销
+constexpr size_t kMaxRowsPerStatement = 64;
+} // namespace
+
+template <typename T>
+struct StorageFacade::StatementCache : StatementCacheBase {
+  using Table = internal::storage_pick_table_t<
+      T, Storage::StorageType::db_objects_type>;
+  static constexpr size_t kColumns =
+      Table::template count_of<internal::is_column>();
+  // 每条多行 REPLACE 语句容纳的行数
+  static constexpr size_t kRowsPerStatement = std::clamp<size_t>(
+      kMaxBoundVariables / kColumns, 1, kMaxRowsPerStatement);
+
+  // 语句绑定的是行指针槽位, 槽位大小固定, 迭代器在整个生命周期内有效
+  struct Deref {
+    const T &operator()(const T *row) const { return *row; }
+  };
+  using SlotIter = typename std::vector<const T *>::iterator;
+  using RangeStatement =
+      decltype(std::declval<Storage::StorageType &>().prepare(replace_range(
+          std::declval<SlotIter>(), std::declval<SlotIter>(), Deref{})));
+
+  // 语句持有连接, storage 需比语句活得更久
+  std::shared_ptr<Storage::StorageType> storage;
+  std::vector<const T *> chunk_slots =
+      std::vector<const T *>(kRowsPerStatement);
+  std::vector<const T *> single_slot = std::vector<const T *>(1);
+  RangeStatement chunk_statement;
+  RangeStatement single_statement;
+
+  explicit StatementCache(std::shared_ptr<Storage::StorageType> stg)
+      : storage(std::move(stg)),
+        chunk_statement(storage->prepare(
+            replace_range(chunk_slots.begin(), chunk_slots.end(), Deref{}))),
+        single_statement(storage->prepare(
+            replace_range(single_slot.begin(), single_slot.end(), Deref{}))) {}
+
+  // 每次 execute 都会 reset 语句并从槽位重新绑定参数
+  void replace(const std::vector<T> &rows) {
+    size_t i = 0;
+    for (; i + kRowsPerStatement <= rows.size(); i += kRowsPerStatement) {
+      for (size_t j = 0; j < kRowsPerStatement; ++j)
+        chunk_slots[j] = &rows[i + j];
+      storage->execute(chunk_statement);
+    }
+    for (; i < rows.size(); ++i) {
+      single_slot[0] = &rows[i];
+      storage->execute(single_statement);
+    }
+  }
+};
+
+template <typename T> struct StorageFacade::RowBuffer : RowBufferBase {
+  std::vector<T> rows;
+
+  void write() override {
+    STG.statementCache<T>().replace(rows);
+    rows.clear();
+  }
+
+  void clear() override { rows.clear(); }
+};
+
+thread_local StorageFacade::RowBatch StorageFacade::thread_batch_;
+
+size_t StorageFacade::nextSlot() {
+  static std::atomic<size_t> slot_count{0};
+  return slot_count++;
+}
+
+template <typename T> size_t StorageFacade::slotOf() {
+  static const size_t slot = nextSlot();
+  return slot;
+}
+
+template <typename T>
+StorageFacade::StatementCache<T> &StorageFacade::statementCache() {
+  const size_t slot = slotOf<T>();
+  if (slot >= statements_.size())
+    statements_.resize(slot + 1);
+  if (!statements_[slot])
+    statements_[slot] = std::make_unique<StatementCache<T>>(
+        Storage::getInstance().getStorage());
+  return static_cast<StatementCache<T> &>(*statements_[slot]);
+}
 
 void StorageFacade::initOrm(const DatabaseConfig config) {
   Storage::getInstance().initialize(config);
+  batch_size_ = std::max<size_t>(1, config.batch_size);
 }
 
 template <typename T> void StorageFacade::insertClassObj(T &&obj) {
-  auto storage = Storage::getInstance().getStorage();
-  auto statement = storage->prepare(replace(std::forward<T>(obj)));
-  storage->execute(statement);
+  using Model = std::decay_t<T>;
+  auto &buffers = thread_batch_.buffers;
+  const size_t slot = slotOf<Model>();
+  if (slot >= buffers.size())
+    buffers.resize(slot + 1);
+  if (!buffers[slot])
+    buffers[slot] = std::make_unique<RowBuffer<Model>>();
+
+  static_cast<RowBuffer<Model> &>(*buffers[slot])
+      .rows.push_back(std::forward<T>(obj));
+  ProcessorMetrics::countRow();
+  if (++thread_batch_.rows >= batch_size_)
+    flushThreadBatch();
 }
 
 void StorageFacade::transaction(const std::function<bool()> &f) {
@@ -16,5 +123,106 @@ void StorageFacade::transaction(const std::function<bool()> &f) {
   storage->transaction(f);
 }
 
+template <typename T>
+void StorageFacade::updateColumn(int64_t T::*column,
+                                 const std::vector<int64_t T::*> &keyColumns,
+                                 const std::vector<int64_t> &values) {
+  if (values.empty())
+    return;
+  flushThreadBatch();
+  auto storage = Storage::getInstance().getStorage();
+  auto columnName = [&storage](int64_t T::*member) {
+    const std::string *name = storage->find_column_name(member);
+    if (!name)
+      throw std::runtime_error("Column is not mapped in table " +
+                               storage->template tablename<T>());
+    return *name;
+  };
+  std::vector<std::string> keyNames;
+  keyNames.reserve(keyColumns.size());
+  for (int64_t T::*key : keyColumns)
+    keyNames.push_back(columnName(key));
+  Storage::getInstance().updateColumn(storage->template tablename<T>(),
+                                      columnName(column), keyNames, values);
+}
+
+void StorageFacade::startWriter() {
+  if (writer_running_.exchange(true))
+    return;
+  // 之前单线程攒下的记录先落库, 保证写入顺序
+  writeBatch(thread_batch_);
+  writer_queue_.resume();
+  writer_thread_ = std::thread(&StorageFacade::writerLoop, this);
+  LOG_DEBUG << "Storage writer thread started" << std::endl;
+}
+
+void StorageFacade::stopWriter() {
+  if (!writer_running_.load())
+    return;
+  flushThreadBatch();
+  writer_running_.store(false, std::memory_order_release);
+  // 队列停止后写线程仍会取完剩余批次, 直到队列为空才退出
+  writer_queue_.stop();
+  if (writer_thread_.joinable())
+    writer_thread_.join();
+  writer_queue_.resume();
+  LOG_DEBUG << "Storage writer thread stopped" << std::endl;
+}
+
+void StorageFacade::flushThreadBatch() {
+  if (thread_batch_.rows == 0)
+    return;
+  if (writer_running_.load(std::memory_order_acquire)) {
+    RowBatch batch = std::move(thread_batch_);
+    thread_batch_ = RowBatch{};
+    writer_queue_.push(std::move(batch));
+    return;
+  }
+  writeBatch(thread_batch_);
+}
+
+void StorageFacade::finalizeSchema() {
+  PERF_SPAN("db.finalize");
+  flushThreadBatch();
+  // 重建表之前释放缓存的语句, 之后的写入会重新预编译
+  statements_.clear();
+  Storage::getInstance().dropFixupIndexes();
+  Storage::getInstance().buildDeferredConstraints();
+}
+
+void StorageFacade::writerLoop() {
+  while (true) {
+    RowBatch batch;
+    try {
+      batch = writer_queue_.pop();
+    } catch (const std::runtime_error &) {
+      break; // 队列已停止且为空
+    }
+    writeBatch(batch);
+  }
+}
+
+void StorageFacade::writeBatch(RowBatch &batch) {
+  if (batch.rows == 0)
+    return;
+  PERF_SPAN("db.write_batch");
+  try {
+    auto storage = Storage::getInstance().getStorage();
+    storage->transaction([&batch] {
+      for (auto &buffer : batch.buffers)
+        if (buffer)
+          buffer->write();
+      return true;
+    });
+  } catch (const std::exception &e) {
+    LOG_ERROR << "Failed to write batch of " << batch.rows
+              << " rows: " << e.what() << std::endl;
+    for (auto &buffer : batch.buffers)
+      if (buffer)
+        buffer->clear();
+  }
+  batch.rows = 0;
+}
+
 // Instantiations of template methods defined here
-#include "storage_facade_instantiations.inc"
\ No newline at end of file
+#include "storage_facade_instantiations.inc"
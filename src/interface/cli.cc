@@ -9,6 +9,7 @@
 #endif
 #include <iomanip>
 #include <iostream>
+#include <stdexcept>
 
 void printBanner();
 
@@ -39,12 +40,31 @@ void Cli::init(int argc, char *argv[]) {
       {"-c", "--config-path", "Specify config.toml path (required)", true,
        [this](const std::string &value) { options.config_path = value; }},
 
-      {"-s", "--source", "Specify source file or directory path (required)",
+      {"-s", "--source",
+       "Specify source file or directory path (required unless -p is given)",
        true, [this](const std::string &value) { options.source_path = value; }},
 
+      {"-p", "--compile-commands",
+       "Specify compile_commands.json or the directory containing it", true,
+       [this](const std::string &value) {
+         options.compile_commands_path = value;
+       }},
+
       {"-o", "--output", "Specify output database file path (required)", true,
        [this](const std::string &value) { options.output_path = value; }},
 
+      {"-j", "--jobs", "Number of parallel frontend workers (0 = all cores)",
+       true,
+       [this](const std::string &value) {
+         try {
+           options.jobs = std::stoi(value);
+         } catch (const std::exception &) {
+           throw std::runtime_error("Invalid value for --jobs: " + value);
+         }
+         if (options.jobs < 0)
+           throw std::runtime_error("Invalid value for --jobs: " + value);
+       }},
+
       {"-q", "--quiet", "Suppress logger's output to console", false,
        [this](const std::string &) { options.quiet = true; }},
 
@@ -3,6 +3,32 @@
 #include "util/logger/macros.h"
 #include <iostream>
 #include <toml.hpp>
+#include <unordered_map>
+
+// 将表族名称列表转换为 ExtractionConfig 的位掩码, 忽略未知名称
+static unsigned parseExtractionFamilies(
+    const std::vector<std::string> &names) {
+  static const std::unordered_map<std::string, ExtractionFamily> families = {
+      {"namespaces", ExtractionFamily::Namespaces},
+      {"templates", ExtractionFamily::Templates},
+      {"inheritance", ExtractionFamily::Inheritance},
+      {"stmts", ExtractionFamily::Stmts},
+      {"exprs", ExtractionFamily::Exprs},
+      {"lambdas", ExtractionFamily::Lambdas},
+      {"preprocessor", ExtractionFamily::Preprocessor}};
+
+  unsigned mask = 0;
+  for (const auto &name : names) {
+    auto it = families.find(name);
+    if (it == families.end()) {
+      LOG_WARNING << "Ignore unknown extraction family: " << name
+                  << std::endl;
+      continue;
+    }
+    mask |= 1u << static_cast<unsigned>(it->second);
+  }
+  return mask;
+}
 
 bool ConfigLoader::loadFromFile(const std::string &config_file) {
   try {
@@ -25,6 +51,25 @@ bool ConfigLoader::loadFromFile(const std::string &config_file) {
         toml::find<std::string>(compilation, "cxx_standard");
     config.compilation.flags =
         toml::find<std::vector<std::string>>(compilation, "flags");
+    // 以下为可选项, 旧配置文件中可以不存在
+    config.compilation.compile_commands =
+        toml::find_or<std::string>(compilation, "compile_commands", "");
+    config.compilation.source_filters = toml::find_or<std::vector<std::string>>(
+        compilation, "source_filters", {});
+    config.compilation.jobs = toml::find_or<unsigned>(compilation, "jobs", 1);
+    config.compilation.dedup_headers =
+        toml::find_or<bool>(compilation, "dedup_headers", true);
+    config.compilation.focus_paths = toml::find_or<std::vector<std::string>>(
+        compilation, "focus_paths", {});
+    config.compilation.skip_system_headers =
+        toml::find_or<bool>(compilation, "skip_system_headers", false);
+    config.compilation.prefix_headers =
+        toml::find_or<std::vector<std::string>>(compilation, "prefix_headers",
+                                                {});
+    config.compilation.pch_dir =
+        toml::find_or<std::string>(compilation, "pch_dir", "");
+    config.compilation.module_cache_path =
+        toml::find_or<std::string>(compilation, "module_cache_path", "");
 
     // 解析database部分
     auto &database = toml::find(data, "database");
@@ -35,6 +80,23 @@ bool ConfigLoader::loadFromFile(const std::string &config_file) {
         toml::find<std::string>(database, "journal_mode");
     config.database.synchronous =
         toml::find<std::string>(database, "synchronous");
+    config.database.profile =
+        toml::find_or<std::string>(database, "profile", "default");
+    config.database.defer_indexes =
+        toml::find_or<bool>(database, "defer_indexes",
+                            config.database.profile == "bulk_load");
+    config.database.incremental =
+        toml::find_or<bool>(database, "incremental", false);
+    config.database.cache_memory_mb =
+        toml::find_or<int>(database, "cache_memory_mb", 0);
+
+    // 解析extraction部分(可选), 缺省时抽取全部表族
+    if (data.contains("extraction")) {
+      auto &extraction = toml::find(data, "extraction");
+      if (extraction.contains("families"))
+        config.extraction.families = parseExtractionFamilies(
+            toml::find<std::vector<std::string>>(extraction, "families"));
+    }
 
     // 解析logging部分
     auto &logging = toml::find(data, "logging");
@@ -44,6 +106,10 @@ bool ConfigLoader::loadFromFile(const std::string &config_file) {
     config.logger.batch_size = toml::find<int>(logging, "batch_size");
     config.logger.enable_perf_logging =
         toml::find<bool>(logging, "enable_perf_logging");
+    config.logger.perf_file =
+        toml::find_or<std::string>(logging, "perf_file", "perf.bin");
+    config.logger.record_metrics =
+        toml::find_or<bool>(logging, "record_metrics", false);
 
     return true;
   } catch (const std::exception &e) {
@@ -72,4 +138,13 @@ void ConfigLoader::mergeFromCli(const CLArgs &args) {
   config.compilation.working_directory = args.working_directory;
   LOG_DEBUG << "merged working_directory: " << config.compilation.working_directory
             << std::endl;
+  if (args.jobs >= 0) {
+    config.compilation.jobs = static_cast<unsigned>(args.jobs);
+    LOG_DEBUG << "merged jobs: " << config.compilation.jobs << std::endl;
+  }
+  if (!args.compile_commands_path.empty()) {
+    config.compilation.compile_commands = args.compile_commands_path;
+    LOG_DEBUG << "merged compile_commands: "
+              << config.compilation.compile_commands << std::endl;
+  }
 }
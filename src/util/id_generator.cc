@@ -1,4 +1,4 @@
 #include "util/id_generator.h"
 
-std::mutex IDGenerator::mutex_;
-std::atomic<int> IDGenerator::global_id_ = 0;
+std::atomic<std::int64_t> IDGenerator::global_id_ = 0;
+thread_local IDGenerator::IdBlock IDGenerator::block_;
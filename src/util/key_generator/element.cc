@@ -6,7 +6,7 @@ namespace KeyGen {
 namespace Element {
 
 KeyType makeKeyFromFuncKey(const KeyType funcKey) {
-  return "function-" + funcKey;
+  return FingerprintBuilder().add("function-").add(funcKey).finish();
 }
 
 KeyType makeKey(const FunctionDecl *FD, ASTContext *Context) {
@@ -1,4 +1,5 @@
 #include "util/key_generator/expr.h"
+#include "util/key_generator/fingerprint_ostream.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/Expr.h>
 #include <clang/AST/ExprConcepts.h>
@@ -120,57 +121,51 @@ KeyType makeKey(const Expr *expr, ASTContext *ctx) {
   unsigned endLine = SM.getSpellingLineNumber(end);
   unsigned endCol = SM.getSpellingColumnNumber(end);
 
-  // 生成唯一字符串
-  std::string locStr = llvm::Twine("expr-")
-                           .concat(std::to_string(startLine))
-                           .concat("-")
-                           .concat(std::to_string(startCol))
-                           .concat("-")
-                           .concat(std::to_string(endLine))
-                           .concat("-")
-                           .concat(std::to_string(endCol))
-                           .str();
+  // 生成唯一Key, 直接写入指纹流
+  FingerprintOStream os;
+  os << "expr-" << startLine << "-" << startCol << "-" << endLine << "-"
+     << endCol;
+
+  // 多TU抽取时不同文件中相同位置的表达式不能共用同一个Key
+  llvm::StringRef fileName = SM.getFilename(start);
+  if (!fileName.empty())
+    os << "-file-" << fileName;
 
   // Add expression-specific information to enhance uniqueness
   if (auto callExpr = llvm::dyn_cast<CallExpr>(expr)) {
-    locStr += "-args-" + std::to_string(callExpr->getNumArgs());
+    os << "-args-" << callExpr->getNumArgs();
     // Add function name if available
     if (auto *callee = callExpr->getDirectCallee()) {
-      locStr += "-func-" + callee->getNameAsString();
+      os << "-func-";
+      callee->printName(os);
     }
   } else if (auto declRefExpr = llvm::dyn_cast<DeclRefExpr>(expr)) {
     if (declRefExpr->getDecl()) {
-      locStr += "-decl-" + std::to_string(declRefExpr->getDecl()->getID());
+      os << "-decl-" << declRefExpr->getDecl()->getID();
     }
   } else if (auto binaryOp = llvm::dyn_cast<BinaryOperator>(expr)) {
-    locStr += "-opcode-" + std::to_string(binaryOp->getOpcode());
+    os << "-opcode-" << static_cast<unsigned>(binaryOp->getOpcode());
   } else if (auto unaryOp = llvm::dyn_cast<UnaryOperator>(expr)) {
-    locStr += "-opcode-" + std::to_string(unaryOp->getOpcode());
+    os << "-opcode-" << static_cast<unsigned>(unaryOp->getOpcode());
   } else if (auto conceptExpr =
                  llvm::dyn_cast<ConceptSpecializationExpr>(expr)) {
-    std::string fileName = SM.getFilename(start).str();
-    if (!fileName.empty())
-      locStr += "-file-" + fileName;
-
     if (const ConceptDecl *concept = conceptExpr->getNamedConcept()) {
       const ConceptDecl *canonicalConcept = concept->getCanonicalDecl();
-      locStr += "-concept-" +
-                canonicalConcept->getQualifiedNameAsString();
+      os << "-concept-";
+      canonicalConcept->printQualifiedName(os);
     }
 
     // Keep this aligned with the concept specialization identity key: use the
     // printed template argument content, not only the argument count.
-    std::string argKey;
-    llvm::raw_string_ostream argStream(argKey);
+    os << "-args-";
     clang::PrintingPolicy policy(ctx->getLangOpts());
     llvm::ArrayRef<clang::TemplateArgument> args =
         conceptExpr->getTemplateArguments();
     for (unsigned index = 0; index < args.size(); ++index) {
       if (index != 0)
-        argStream << ",";
-      args[index].print(policy, argStream, true);
+        os << ",";
+      args[index].print(policy, os, true);
     }
-    locStr += "-args-" + argStream.str();
   }
   // // 生成MD5哈希
   // llvm::MD5 hash;
@@ -181,50 +176,43 @@ KeyType makeKey(const Expr *expr, ASTContext *ctx) {
   // // 转换为十六进制字符串
   // llvm::SmallString<32> hexStr;
   // llvm::MD5::stringifyResult(result, hexStr);
-  return locStr;
+  return os.finish();
 }
 
 KeyType makeKeyForNonTypeTemplateParm(const NonTypeTemplateParmDecl *decl,
                                         ASTContext *ctx) {
   if (!decl || !ctx)
-    return "";
+    return {};
 
   const SourceManager &SM = ctx->getSourceManager();
+  FingerprintOStream os;
 
   // Source location
+  os << "nttp-";
   SourceLocation loc = SM.getSpellingLoc(decl->getLocation());
-  std::string locStr;
   if (loc.isValid()) {
-    locStr = loc.printToString(SM);
+    loc.print(os, SM);
   } else {
-    locStr = "addr-" + std::to_string(reinterpret_cast<std::uintptr_t>(decl));
+    os << "addr-" << reinterpret_cast<std::uintptr_t>(decl);
   }
 
   // Decl context (parent template or enclosing decl)
-  std::string contextStr;
+  os << "-ctx-";
   if (const auto *dc = decl->getDeclContext()) {
     if (const auto *named = llvm::dyn_cast<NamedDecl>(dc)) {
-      contextStr = named->getQualifiedNameAsString();
+      named->printQualifiedName(os);
     } else {
-      contextStr = std::to_string(reinterpret_cast<std::uintptr_t>(dc));
+      os << reinterpret_cast<std::uintptr_t>(dc);
     }
   }
 
-  // Depth and index
-  unsigned depth = decl->getDepth();
-  unsigned index = decl->getIndex();
-
-  // Parameter name
-  std::string name = decl->getNameAsString();
-
-  // Parameter type
-  std::string typeStr = decl->getType().getAsString();
-
-  return "nttp-" + locStr + "-ctx-" + contextStr +
-         "-depth-" + std::to_string(depth) +
-         "-idx-" + std::to_string(index) +
-         "-name-" + name +
-         "-type-" + typeStr;
+  // Depth, index, name and type of the parameter
+  os << "-depth-" << decl->getDepth() << "-idx-" << decl->getIndex()
+     << "-name-";
+  decl->printName(os);
+  os << "-type-";
+  decl->getType().print(os, PrintingPolicy(ctx->getLangOpts()));
+  return os.finish();
 }
 
 } // namespace Expr_
@@ -1,37 +1,32 @@
 #include "util/key_generator/function.h"
+#include "util/key_generator/fingerprint_ostream.h"
+#include "util/key_generator/node_cache.h"
 #include "util/logger/macros.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclCXX.h> // For CXXMethodDecl etc.
 #include <clang/AST/Mangle.h>
 #include <llvm/Support/raw_ostream.h>
+#include <memory>
 #include <string>
 
 namespace KeyGen {
 
 namespace Function {
 
-KeyType makeKey(const FunctionDecl *FD, ASTContext *Context) {
-  if (!FD) {
-    LOG_ERROR << "Null FunctionDecl" << std::endl;
-    return "ERRORKEY";
-  }
-
-  const FunctionDecl *CanonicalFD = FD->getCanonicalDecl();
-  if (!CanonicalFD) {
-    LOG_ERROR << "Cannot get CanonicalDecl for FunctionDecl" << std::endl;
-    return "ERRORKEY";
-  }
-
-  MangleContext *MangleCtx = Context->createMangleContext();
+static KeyType computeKey(const FunctionDecl *CanonicalFD,
+                          ASTContext *Context) {
+  std::unique_ptr<MangleContext> MangleCtx(Context->createMangleContext());
   if (!MangleCtx) {
     LOG_ERROR << "MangleCtx is not available for "
               << CanonicalFD->getQualifiedNameAsString() << std::endl;
-    return "ERRORKEY";
+    return Fingerprint::of("ERRORKEY");
   }
 
-  std::string MangledName;
-  llvm::raw_string_ostream Ostream(MangledName);
+  // 修饰名直接写入指纹流, 不再生成中间字符串
+  constexpr llvm::StringLiteral Prefix = "funtion-";
+  FingerprintOStream Ostream;
+  Ostream << Prefix;
 
   if (const auto *CD = llvm::dyn_cast<clang::CXXConstructorDecl>(CanonicalFD)) {
     // For constructors
@@ -49,13 +44,39 @@ KeyType makeKey(const FunctionDecl *FD, ASTContext *Context) {
   } else
     MangleCtx->mangleName(CanonicalFD, Ostream);
 
-  Ostream.flush();
-  if (MangledName.empty()) {
+  if (Ostream.tell() == Prefix.size()) {
     LOG_ERROR << "Warning: Mangled name was empty for: "
               << CanonicalFD->getQualifiedNameAsString() << std::endl;
-    return "__EMPTY_MANGLED__" + CanonicalFD->getQualifiedNameAsString();
+    return Fingerprint::of("__EMPTY_MANGLED__" +
+                           CanonicalFD->getQualifiedNameAsString());
+  }
+  return Ostream.finish();
+}
+
+KeyType makeKey(const FunctionDecl *FD, ASTContext *Context) {
+  if (!FD) {
+    LOG_ERROR << "Null FunctionDecl" << std::endl;
+    return Fingerprint::of("ERRORKEY");
+  }
+
+  const FunctionDecl *CanonicalFD = FD->getCanonicalDecl();
+  if (!CanonicalFD) {
+    LOG_ERROR << "Cannot get CanonicalDecl for FunctionDecl" << std::endl;
+    return Fingerprint::of("ERRORKEY");
   }
-  return "funtion-" + MangledName;
+
+  // 各次声明共用规范声明的 Key
+  return NodeCache::key(NodeCache::Kind::Function, CanonicalFD,
+                        [&] { return computeKey(CanonicalFD, Context); });
+}
+
+std::optional<int64_t> findId(const FunctionDecl *FD, ASTContext *Context) {
+  const FunctionDecl *CanonicalFD = FD ? FD->getCanonicalDecl() : nullptr;
+  if (!CanonicalFD)
+    return std::nullopt;
+  return NodeCache::id(NodeCache::Kind::Function, CanonicalFD, [&] {
+    return SEARCH_FUNCTION_CACHE(makeKey(CanonicalFD, Context));
+  });
 }
 
 } // namespace Function
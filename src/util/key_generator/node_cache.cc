@@ -0,0 +1,11 @@
+#include "util/key_generator/node_cache.h"
+
+thread_local std::array<NodeCache::Table,
+                        static_cast<size_t>(NodeCache::Kind::Count)>
+    NodeCache::tables_;
+
+void NodeCache::enterTranslationUnit() {
+  // 释放上一个TU的表, 避免线程常驻期间一直占着峰值容量
+  for (Table &table : tables_)
+    table = Table{};
+}
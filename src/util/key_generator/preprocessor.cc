@@ -6,13 +6,13 @@ namespace Preprocessor {
 
 KeyType makeKey(const std::string &filename, unsigned line, unsigned column,
                 int directive_kind, const std::string &extra_tag) {
-  std::string normalized_filename = filename.empty() ? "<invalid>" : filename;
-  KeyType key = normalized_filename + ":" + std::to_string(line) + ":" +
-                std::to_string(column) + ":" +
-                std::to_string(directive_kind);
+  FingerprintBuilder key;
+  key.add(filename.empty() ? "<invalid>" : filename)
+      .add(":" + std::to_string(line) + ":" + std::to_string(column) + ":" +
+           std::to_string(directive_kind));
   if (!extra_tag.empty())
-    key += ":" + extra_tag;
-  return key;
+    key.add(":").add(extra_tag);
+  return key.finish();
 }
 
 } // namespace Preprocessor
@@ -1,11 +1,11 @@
 #include "util/key_generator/stmt.h"
+#include "util/key_generator/fingerprint_ostream.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/Expr.h>
 #include <clang/AST/Stmt.h>
 #include <clang/Basic/SourceManager.h>
 #include <string>
 
-using KeyType = std::string;
 using namespace clang;
 
 namespace KeyGen {
@@ -13,8 +13,8 @@ namespace KeyGen {
 namespace Stmt_ {
 // For clang::Stmt
 KeyType makeKey(const Stmt *stmt, ASTContext *ctx) {
-  std::string s;
-  llvm::raw_string_ostream os(s);
+  FingerprintOStream os;
+  os << "stmt-";
 
   // Get Stmt type
   unsigned stmtClass = stmt->getStmtClass();
@@ -42,8 +42,10 @@ KeyType makeKey(const Stmt *stmt, ASTContext *ctx) {
     unsigned endLine = srcMgr.getLineNumber(endInfo.first, endInfo.second);
     unsigned endCol = srcMgr.getColumnNumber(endInfo.first, endInfo.second);
 
-    // Format: beginLine:beginCol-endLine:endCol
-    os << beginLine << ":" << beginCol << "-" << endLine << ":" << endCol;
+    // Format: file@beginLine:beginCol-endLine:endCol
+    // 多TU抽取时不同文件中相同位置的语句不能共用同一个Key
+    os << srcMgr.getFilename(expBegin) << "@" << beginLine << ":" << beginCol
+       << "-" << endLine << ":" << endCol;
   } else {
     // Use ptr address as fallback
     os << "addr-" << reinterpret_cast<uintptr_t>(stmt);
@@ -58,7 +60,7 @@ KeyType makeKey(const Stmt *stmt, ASTContext *ctx) {
     os << "-args-" << callExpr->getNumArgs();
   }
 
-  return "stmt-" + os.str();
+  return os.finish();
 }
 
 } // namespace Stmt_
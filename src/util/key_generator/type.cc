@@ -1,40 +1,60 @@
 #include "util/key_generator/type.h"
+#include "util/key_generator/fingerprint_ostream.h"
+#include "util/key_generator/node_cache.h"
 #include "util/logger/macros.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclTemplate.h>
 #include <clang/AST/Type.h>
 #include <iostream>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/ADT/StringExtras.h>
 #include <string>
 
+// 以下 print* 函数直接写入输出流, 供指纹计算与字符串形式共用
+static void printScopePath(const NamedDecl *decl, llvm::raw_ostream &os);
+static void printDeclName(const NamedDecl *decl, llvm::raw_ostream &os);
+static void printTemplateArgs(const NamedDecl *decl, llvm::raw_ostream &os);
+static void printQualifiedDeclName(const NamedDecl *decl,
+                                   llvm::raw_ostream &os);
+
 namespace KeyGen {
 
 namespace Type {
 
 // For clang::QualType
+// Key 只取决于规范且无限定符的类型, 各种类型糖共用同一份记忆
 KeyType makeKey(const QualType &qualType, ASTContext *ctx) {
-  std::string s;
-  llvm::raw_string_ostream os(s);
-  qualType.getCanonicalType().getUnqualifiedType().print(
-      os, ctx->getPrintingPolicy());
-  return os.str();
+  QualType canonical = qualType.getCanonicalType().getUnqualifiedType();
+  return NodeCache::key(NodeCache::Kind::Type, canonical.getAsOpaquePtr(),
+                        [&] {
+                          FingerprintOStream os;
+                          canonical.print(os, ctx->getPrintingPolicy());
+                          return os.finish();
+                        });
 }
 
 // For clang::NamedDecl
 KeyType makeKey(const NamedDecl *decl, ASTContext *ctx) {
-  // 1. 作用域路径
-  std::string scope = getScopePath(decl);
-  // 2. 声明名称（含匿名处理）
-  std::string name = getDeclName(decl);
-  // 3. 模板参数
-  std::string templateArgs = getTemplateArgs(decl);
-  // 组合完整标识符
-  std::string uid;
-  if (!scope.empty())
-    uid = scope + "::";
-  uid += name + templateArgs;
-  return uid;
+  return NodeCache::key(NodeCache::Kind::TypeDecl, decl, [&] {
+    FingerprintOStream os;
+    printQualifiedDeclName(decl, os);
+    return os.finish();
+  });
+}
+
+std::optional<int64_t> findId(const QualType &qualType, ASTContext *ctx) {
+  QualType canonical = qualType.getCanonicalType().getUnqualifiedType();
+  return NodeCache::id(
+      NodeCache::Kind::Type, canonical.getAsOpaquePtr(),
+      [&] { return SEARCH_TYPE_CACHE(makeKey(canonical, ctx)); });
+}
+
+std::optional<int64_t> findId(const NamedDecl *decl, ASTContext *ctx) {
+  return NodeCache::id(NodeCache::Kind::TypeDecl, decl, [&] {
+    return SEARCH_TYPE_CACHE(makeKey(decl, ctx));
+  });
 }
 
 // clang::TemplateDecl -> clang::NamedDecl
@@ -46,7 +66,7 @@ KeyType makeKey(const TemplateDecl *decl, ASTContext *ctx) {
     // 处理非NamedDecl情况
     LOG_WARNING << "Warning: Unexpected decl type: " << decl->getDeclKindName()
                 << std::endl;
-    return "";
+    return {};
   }
 }
 
@@ -59,7 +79,7 @@ KeyType makeKey(const TypeDecl *decl, ASTContext *ctx) {
     // 处理非NamedDecl情况
     LOG_WARNING << "Warning: Unexpected decl type: " << decl->getDeclKindName()
                 << std::endl;
-    return "";
+    return {};
   }
 }
 
@@ -68,74 +88,127 @@ KeyType makeKey(const TypeDecl *decl, ASTContext *ctx) {
 } // namespace KeyGen
 
 // namespace "ns" -> 类 "A" -> 类 "B" 的作用域为 "ns::A::B"
-std::string getScopePath(const NamedDecl *decl) {
-  std::vector<std::string> scopes;
+static void printScopePath(const NamedDecl *decl, llvm::raw_ostream &os) {
+  llvm::SmallVector<const NamedDecl *, 8> scopes;
   const DeclContext *ctx = decl->getDeclContext();
 
   while (ctx && llvm::isa<NamedDecl>(ctx)) {
     const auto *namedCtx = llvm::cast<NamedDecl>(ctx);
-    if (!namedCtx->getDeclName().isEmpty()) {
-      scopes.push_back(namedCtx->getNameAsString());
-    }
+    if (!namedCtx->getDeclName().isEmpty())
+      scopes.push_back(namedCtx);
     ctx = ctx->getParent();
   }
 
-  std::reverse(scopes.begin(), scopes.end());
-  return llvm::join(scopes.begin(), scopes.end(), "::");
+  for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
+    if (it != scopes.rbegin())
+      os << "::";
+    (*it)->printName(os);
+  }
 }
 
-std::string getDeclName(const NamedDecl *decl) {
+static void printDeclName(const NamedDecl *decl, llvm::raw_ostream &os) {
+  const SourceManager &srcMgr = decl->getASTContext().getSourceManager();
+
   if (const auto *templateTemplateParam =
           llvm::dyn_cast<TemplateTemplateParmDecl>(decl)) {
-    std::string name = templateTemplateParam->getNameAsString();
-    if (name.empty())
-      name = "(anonymous)";
-
-    SourceLocation loc = templateTemplateParam->getLocation();
-    std::string locStr = loc.printToString(
-        templateTemplateParam->getASTContext().getSourceManager());
-    return name + "@template-template-param:" +
-           std::to_string(templateTemplateParam->getDepth()) + ":" +
-           std::to_string(templateTemplateParam->getIndex()) + ":" + locStr;
+    if (templateTemplateParam->getDeclName().isEmpty())
+      os << "(anonymous)";
+    else
+      templateTemplateParam->printName(os);
+    os << "@template-template-param:" << templateTemplateParam->getDepth()
+       << ":" << templateTemplateParam->getIndex() << ":";
+    templateTemplateParam->getLocation().print(os, srcMgr);
+    return;
   }
 
   if (const auto *templateParam =
           llvm::dyn_cast<TemplateTypeParmDecl>(decl)) {
-    std::string name = templateParam->getNameAsString();
-    if (name.empty())
-      name = "(anonymous)";
-
-    SourceLocation loc = templateParam->getLocation();
-    std::string locStr =
-        loc.printToString(templateParam->getASTContext().getSourceManager());
-    return name + "@template-type-param:" +
-           std::to_string(templateParam->getDepth()) + ":" +
-           std::to_string(templateParam->getIndex()) + ":" + locStr;
+    if (templateParam->getDeclName().isEmpty())
+      os << "(anonymous)";
+    else
+      templateParam->printName(os);
+    os << "@template-type-param:" << templateParam->getDepth() << ":"
+       << templateParam->getIndex() << ":";
+    templateParam->getLocation().print(os, srcMgr);
+    return;
   }
 
   if (decl->getDeclName().isEmpty()) {
     // 匿名声明：使用源码位置作为唯一标识
-    SourceLocation loc = decl->getLocation();
-    return "(anonymous@" +
-           loc.printToString(decl->getASTContext().getSourceManager()) + ")";
+    os << "(anonymous@";
+    decl->getLocation().print(os, srcMgr);
+    os << ")";
+    return;
   }
-  return decl->getNameAsString();
+  decl->printName(os);
 }
 
-std::string getTemplateArgs(const NamedDecl *decl) {
-  std::string args;
+static void printTemplateArgs(const NamedDecl *decl, llvm::raw_ostream &os) {
+  llvm::SmallString<128> args;
+  llvm::raw_svector_ostream argsStream(args);
 
   if (const auto *templateDecl = llvm::dyn_cast<TemplateDecl>(decl)) {
     // 处理普通模板声明（如 template<typename T> class A）
-    const auto *paramList = templateDecl->getTemplateParameters();
-    args = getTemplateParamListAsString(paramList);
+    bool first = true;
+    for (const NamedDecl *param : *templateDecl->getTemplateParameters()) {
+      if (!first)
+        argsStream << ", ";
+      first = false;
+      param->printName(argsStream);
+    }
   } else if (const auto *specDecl =
                  llvm::dyn_cast<ClassTemplateSpecializationDecl>(decl)) {
     // 处理模板特化（如 A<int>）
-    args = getTemplateArgumentListAsString(specDecl->getTemplateArgs());
+    const TemplateArgumentList &templateArgs = specDecl->getTemplateArgs();
+    PrintingPolicy policy((LangOptions()));
+    for (unsigned i = 0; i < templateArgs.size(); ++i) {
+      if (i != 0)
+        argsStream << ", ";
+      templateArgs[i].print(policy, argsStream, true);
+    }
   }
 
-  return args.empty() ? "" : "<" + args + ">";
+  if (!args.empty())
+    os << "<" << args << ">";
+}
+
+// 组合完整标识符: 作用域路径::声明名称<模板参数>
+static void printQualifiedDeclName(const NamedDecl *decl,
+                                   llvm::raw_ostream &os) {
+  uint64_t start = os.tell();
+  printScopePath(decl, os);
+  if (os.tell() != start)
+    os << "::";
+  printDeclName(decl, os);
+  printTemplateArgs(decl, os);
+}
+
+std::string getQualifiedDeclName(const NamedDecl *decl) {
+  std::string name;
+  llvm::raw_string_ostream os(name);
+  printQualifiedDeclName(decl, os);
+  return os.str();
+}
+
+std::string getScopePath(const NamedDecl *decl) {
+  std::string scope;
+  llvm::raw_string_ostream os(scope);
+  printScopePath(decl, os);
+  return os.str();
+}
+
+std::string getDeclName(const NamedDecl *decl) {
+  std::string name;
+  llvm::raw_string_ostream os(name);
+  printDeclName(decl, os);
+  return os.str();
+}
+
+std::string getTemplateArgs(const NamedDecl *decl) {
+  std::string args;
+  llvm::raw_string_ostream os(args);
+  printTemplateArgs(decl, os);
+  return os.str();
 }
 
 // 获取模板参数列表的字符串表示（如 "T, U"）
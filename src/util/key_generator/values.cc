@@ -1,21 +1,16 @@
 #include "util/key_generator/values.h"
-#include <sstream>
 
 namespace KeyGen {
 
 namespace Values {
 KeyType makeKey(const std::string &value) {
-  std::ostringstream oss;
-  oss << "val-" << value;
-  return oss.str();
+  return FingerprintBuilder().add("val-").add(value).finish();
 }
 } // namespace Values
 
 namespace ValueText {
 KeyType makeKey(const std::string &text) {
-  std::ostringstream oss;
-  oss << "txt-" << text;
-  return oss.str();
+  return FingerprintBuilder().add("txt-").add(text).finish();
 }
 } // namespace ValueText
 
@@ -1,21 +1,33 @@
 #include "util/key_generator/variable.h"
+#include "util/key_generator/fingerprint_ostream.h"
+#include "util/key_generator/node_cache.h"
 #include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
 #include <clang/AST/DeclTemplate.h>
 #include <clang/AST/Expr.h>
 #include <clang/Basic/SourceManager.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/Support/raw_ostream.h>
-#include <sstream>
 #include <string>
 
-using KeyType = std::string;
 using namespace clang;
 
 namespace KeyGen {
 
 namespace Var {
+
+// 按由外到内的顺序输出 "a::b::c", contexts 为由内到外收集的上下文
+static void printHierarchy(llvm::ArrayRef<const NamedDecl *> contexts,
+                           llvm::raw_ostream &os) {
+  for (auto it = contexts.rbegin(); it != contexts.rend(); ++it) {
+    if (it != contexts.rbegin())
+      os << "::";
+    (*it)->printName(os);
+  }
+}
+
 // For clang::VarDecl
-KeyType makeKey(const VarDecl *VD, ASTContext *ctx) {
+static KeyType computeKey(const VarDecl *VD, ASTContext *ctx) {
   // 第一部分：处理源位置信息
   const SourceManager &srcMgr = ctx->getSourceManager();
   SourceLocation loc = srcMgr.getExpansionLoc(VD->getLocation());
@@ -23,43 +35,37 @@ KeyType makeKey(const VarDecl *VD, ASTContext *ctx) {
   unsigned line = srcMgr.getLineNumber(fileLoc.first, fileLoc.second);
   unsigned col = srcMgr.getColumnNumber(fileLoc.first, fileLoc.second);
 
-  // 第二部分：构建基础ID（行:列:名称）
-  std::string uid = std::to_string(line) + ":" + std::to_string(col) + ":" +
-                    VD->getNameAsString();
+  // 第二部分：构建基础ID（文件@行:列:名称）
+  FingerprintOStream os;
+  os << "var-" << srcMgr.getFilename(loc) << "@" << line << ":" << col << ":";
+  VD->printName(os);
 
   if (const auto *specialization =
           dyn_cast<VarTemplateSpecializationDecl>(VD)) {
-    std::string specializedName;
-    llvm::raw_string_ostream stream(specializedName);
-    specialization->getNameForDiagnostic(stream, ctx->getPrintingPolicy(),
-                                         true);
-    uid += ":" + stream.str();
+    os << ":";
+    specialization->getNameForDiagnostic(os, ctx->getPrintingPolicy(), true);
   }
 
   // 第三部分：添加声明上下文层次信息
-  const DeclContext *hctx = VD->getDeclContext();
-  std::string hierarchy;
-
-  while (hctx && !hctx->isTranslationUnit()) {
-    if (const auto *ns = dyn_cast<NamespaceDecl>(hctx)) {
-      hierarchy =
-          ns->getNameAsString() + (hierarchy.empty() ? "" : "::" + hierarchy);
-    } else if (const auto *func = dyn_cast<FunctionDecl>(hctx)) {
-      hierarchy =
-          func->getNameAsString() + (hierarchy.empty() ? "" : "::" + hierarchy);
-    }
-    hctx = hctx->getParent();
+  llvm::SmallVector<const NamedDecl *, 8> contexts;
+  for (const DeclContext *hctx = VD->getDeclContext();
+       hctx && !hctx->isTranslationUnit(); hctx = hctx->getParent()) {
+    if (const auto *ns = dyn_cast<NamespaceDecl>(hctx))
+      contexts.push_back(ns);
+    else if (const auto *func = dyn_cast<FunctionDecl>(hctx))
+      contexts.push_back(func);
   }
 
-  if (!hierarchy.empty()) {
-    uid += ":" + hierarchy;
+  if (!contexts.empty()) {
+    os << ":";
+    printHierarchy(contexts, os);
   }
 
-  return "var-" + uid;
+  return os.finish();
 }
 
 // For clang::FieldDecl (MemberVar)
-KeyType makeKey(const FieldDecl *FD, ASTContext *ctx) {
+static KeyType computeKey(const FieldDecl *FD, ASTContext *ctx) {
   // 第一部分：处理源位置信息
   const SourceManager &srcMgr = ctx->getSourceManager();
   SourceLocation loc = srcMgr.getExpansionLoc(FD->getLocation());
@@ -69,37 +75,57 @@ KeyType makeKey(const FieldDecl *FD, ASTContext *ctx) {
 
   // 第二部分：获取记录类型名称
   const RecordDecl *record = FD->getParent();
-  std::string recordName = record ? record->getNameAsString() : "";
-
-  // 处理嵌套类的层次结构
-  const DeclContext *hctx = record ? record->getDeclContext() : nullptr;
-  std::string hierarchy;
-
-  while (hctx && !hctx->isTranslationUnit()) {
-    if (const auto *ns = dyn_cast<NamespaceDecl>(hctx)) {
-      std::string nsName = ns->getNameAsString();
-      if (!nsName.empty()) {
-        hierarchy = nsName + (hierarchy.empty() ? "" : "::" + hierarchy);
-      }
-    } else if (const auto *parentRecord = dyn_cast<RecordDecl>(hctx)) {
-      std::string parentName = parentRecord->getNameAsString();
-      if (!parentName.empty()) {
-        hierarchy = parentName + (hierarchy.empty() ? "" : "::" + hierarchy);
-      }
-    }
-    hctx = hctx->getParent();
-  }
 
-  // 构建完整的键: "member:line:col:recordname:fieldname[:hierarchy]"
-  std::ostringstream oss;
-  oss << "member:" << line << ":" << col << ":"
-      << recordName << ":" << FD->getNameAsString();
+  // 处理嵌套类的层次结构, 跳过匿名的命名空间与类
+  llvm::SmallVector<const NamedDecl *, 8> contexts;
+  for (const DeclContext *hctx = record ? record->getDeclContext() : nullptr;
+       hctx && !hctx->isTranslationUnit(); hctx = hctx->getParent()) {
+    const NamedDecl *named = nullptr;
+    if (const auto *ns = dyn_cast<NamespaceDecl>(hctx))
+      named = ns;
+    else if (const auto *parentRecord = dyn_cast<RecordDecl>(hctx))
+      named = parentRecord;
+    if (named && !named->getDeclName().isEmpty())
+      contexts.push_back(named);
+  }
 
-  if (!hierarchy.empty()) {
-    oss << ":" << hierarchy;
+  // 构建完整的键: "member:file@line:col:recordname:fieldname[:hierarchy]"
+  FingerprintOStream os;
+  os << "member:" << srcMgr.getFilename(loc) << "@" << line << ":" << col
+     << ":";
+  if (record)
+    record->printName(os);
+  os << ":";
+  FD->printName(os);
+
+  if (!contexts.empty()) {
+    os << ":";
+    printHierarchy(contexts, os);
   }
 
-  return oss.str();
+  return os.finish();
+}
+
+KeyType makeKey(const VarDecl *VD, ASTContext *ctx) {
+  return NodeCache::key(NodeCache::Kind::Variable, VD,
+                        [&] { return computeKey(VD, ctx); });
+}
+
+KeyType makeKey(const FieldDecl *FD, ASTContext *ctx) {
+  return NodeCache::key(NodeCache::Kind::MemberVar, FD,
+                        [&] { return computeKey(FD, ctx); });
+}
+
+std::optional<int64_t> findId(const VarDecl *VD, ASTContext *ctx) {
+  return NodeCache::id(NodeCache::Kind::Variable, VD, [&] {
+    return SEARCH_VARIABLE_CACHE(makeKey(VD, ctx));
+  });
+}
+
+std::optional<int64_t> findId(const FieldDecl *FD, ASTContext *ctx) {
+  return NodeCache::id(NodeCache::Kind::MemberVar, FD, [&] {
+    return SEARCH_MEMBERVAR_CACHE(makeKey(FD, ctx));
+  });
 }
 
 } // namespace Var
@@ -1,10 +1,14 @@
 #include "util/logger/logger.h"
 #include "util/logger/macros.h"
+#include "util/logger/perf_log.h"
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
-thread_local Logger::LogContext Logger::log_context_;
+thread_local Logger::RingHandle Logger::ring_handle_;
+thread_local LogRecord *Logger::record_ = nullptr;
+thread_local LogRecord Logger::direct_record_;
 thread_local bool Logger::is_logging_ = false;
 
 Logger &Logger::getInstance() {
@@ -12,6 +16,14 @@ Logger &Logger::getInstance() {
   return instance;
 }
 
+Logger::~Logger() {
+  for (LogRing *ring = rings_.load(std::memory_order_acquire); ring;) {
+    LogRing *next = ring->next;
+    delete ring;
+    ring = next;
+  }
+}
+
 // Initialize the logger
 void Logger::init() {
   is_to_file_ = false;
@@ -39,6 +51,9 @@ bool Logger::loadConfig(const LoggerConfig &config) {
     log_level_threshold_ = StringToLevel(config.level);
     batch_size_ = config.batch_size;
     is_to_console_ = config.is_to_console;
+    if (config.enable_perf_logging &&
+        !PerfLog::getInstance().open(config.perf_file))
+      throw std::runtime_error("Cannot open perf log file");
   } catch (const std::exception &e) {
     LOG_ERROR << "Logger config initialization failed: " << e.what()
               << std::endl;
@@ -55,29 +70,15 @@ bool Logger::loadConfig(const LoggerConfig &config) {
 
 void Logger::stop() {
   if (running_) {
+    PerfLog::getInstance().close();
     LOG_INFO << "Stopping logger worker thread" << std::endl;
     running_ = false;
-    queue_.stop(); // 通知队列终止
+    // 唤醒日志线程, 由其取完已发布的记录后退出
+    wakeWorker();
 
     if (worker_thread_.joinable())
       worker_thread_.join();
 
-    // 处理队列中剩余的日志
-    while (!queue_.empty()) {
-      auto msg = queue_.pop();
-      batch_buffer_.push_back(std::move(msg));
-      if (batch_buffer_.size() >= batch_size_) {
-        formatOutput(batch_buffer_);
-        batch_buffer_.clear();
-      }
-    }
-
-    // 处理 batch_buffer_ 中剩余的日志
-    if (!batch_buffer_.empty()) {
-      formatOutput(batch_buffer_);
-      batch_buffer_.clear();
-    }
-
     if (log_file_.is_open())
       log_file_.close();
   } else
@@ -86,37 +87,117 @@ void Logger::stop() {
 
 void Logger::log(LogMessage &&msg) {
   if (msg.level >= log_level_threshold_) {
-    queue_.push(std::move(msg));
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    batch_buffer_.push_back(std::move(msg));
+    flushBuffer();
   }
 }
 
 void Logger::setLogLevel(LogLevel level) { log_level_threshold_ = level; }
 
-void Logger::processMessages() {
-  try {
-    while (running_ || !queue_.empty()) {
-      auto msg = queue_.pop();
-      batch_buffer_.push_back(std::move(msg));
-
-      if (batch_buffer_.size() >= batch_size_ ||
-          (!running_ && !queue_.empty())) {
-        formatOutput(batch_buffer_);
-        batch_buffer_.clear();
-      }
-    }
+LogRing *Logger::claimRing() {
+  // 优先认领已退出线程交还的缓冲区
+  for (LogRing *ring = rings_.load(std::memory_order_acquire); ring;
+       ring = ring->next) {
+    bool expected = false;
+    if (ring->owned.compare_exchange_strong(expected, true,
+                                            std::memory_order_acquire))
+      return ring;
+  }
 
-    // 处理 batch_buffer_ 中剩余的日志
-    if (!batch_buffer_.empty()) {
-      formatOutput(batch_buffer_);
-      batch_buffer_.clear();
+  auto *ring = new LogRing();
+  ring->owned.store(true, std::memory_order_relaxed);
+  ring->next = rings_.load(std::memory_order_relaxed);
+  while (!rings_.compare_exchange_weak(ring->next, ring,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+  }
+  return ring;
+}
+
+LogRecord *Logger::acquireRecord() {
+  if (running_.load(std::memory_order_acquire)) {
+    if (!ring_handle_.ring)
+      ring_handle_.ring = claimRing();
+    // 缓冲区满时等待日志线程腾出槽位, 日志线程停止后改为直接输出
+    do {
+      if (LogRecord *record = ring_handle_.ring->acquire())
+        return record;
+      std::this_thread::yield();
+    } while (running_.load(std::memory_order_acquire));
+  }
+  return &direct_record_;
+}
+
+void Logger::commitRecord() {
+  if (record_ == &direct_record_) {
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    batch_buffer_.push_back(decodeRecord(direct_record_));
+    flushBuffer();
+    return;
+  }
+  ring_handle_.ring->publish();
+  wakeWorker();
+}
+
+void Logger::wakeWorker() {
+  // 与日志线程的 sleeping_/signal_ 检查构成 Dekker 式配对, 需顺序一致
+  signal_.fetch_add(1);
+  if (sleeping_.load()) {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_cv_.notify_one();
+  }
+}
+
+LogMessage Logger::decodeRecord(const LogRecord &record) {
+  static const std::ios pristine(nullptr);
+  decode_stream_.str(std::string());
+  decode_stream_.clear();
+  decode_stream_.copyfmt(pristine);
+  LogArgs::decode(record.payload, decode_stream_);
+  return LogMessage(record.level, record.timestamp, decode_stream_.str(),
+                    record.file, record.line);
+}
+
+size_t Logger::drainRings() {
+  size_t drained = 0;
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  for (LogRing *ring = rings_.load(std::memory_order_acquire); ring;
+       ring = ring->next) {
+    while (LogRecord *record = ring->front()) {
+      batch_buffer_.push_back(decodeRecord(*record));
+      ring->pop();
+      ++drained;
+      if (batch_buffer_.size() >= batch_size_)
+        flushBuffer();
     }
-  } catch (const std::runtime_error &e) {
-    // 处理队列终止异常
-    if (!batch_buffer_.empty()) {
-      formatOutput(batch_buffer_);
-      batch_buffer_.clear();
+  }
+  return drained;
+}
+
+void Logger::processMessages() {
+  while (true) {
+    // 先取信号再检查缓冲区, 期间发布的记录会使 wait 立即返回
+    const uint64_t seen = signal_.load(std::memory_order_acquire);
+    if (drainRings() > 0)
+      continue;
+    {
+      // 空闲时输出未攒满一批的日志
+      std::lock_guard<std::mutex> lock(output_mutex_);
+      flushBuffer();
     }
+    if (!running_.load(std::memory_order_acquire))
+      break;
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    sleeping_.store(true);
+    wake_cv_.wait(lock, [this, seen] { return signal_.load() != seen; });
+    sleeping_.store(false);
   }
+
+  // 停止前最后发布的记录
+  drainRings();
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  flushBuffer();
 }
 
 void Logger::formatOutput(const std::vector<LogMessage> &messages) {
@@ -177,9 +258,14 @@ LogLevel Logger::StringToLevel(const std::string &level) {
 // Logger类的成员函数，用于设置日志级别、文件名和行号
 Logger &Logger::operator()(LogLevel level, const char *file, int line) {
   if (level >= log_level_threshold_) {
+    // 取得一个可复用的记录槽位, 后续参数编码写入其中
+    record_ = acquireRecord();
+    record_->level = level;
+    record_->file = file;
+    record_->line = line;
+    record_->timestamp = std::chrono::system_clock::now();
+    record_->payload.clear();
     is_logging_ = true;
-    // 初始化日志上下文，包括日志流、日志级别、文件名和行号
-    log_context_ = LogContext{std::ostringstream(), level, file, line};
   } else
     is_logging_ = false;
   return *this; // 返回当前Logger对象，以便支持链式调用
@@ -188,14 +274,74 @@ Logger &Logger::operator()(LogLevel level, const char *file, int line) {
 // Logger类的成员函数，用于处理流操作符<<
 Logger &Logger::operator<<(std::ostream &(*manip)(std::ostream &)) {
   if (is_logging_) {
-    manip(log_context_.stream);
-    // 检查操作符是否为std::endl
+    LogArgs::encodeManip(record_->payload, manip);
+    // 遇到 std::endl 时记录完整, 交给日志线程
     if (manip == static_cast<std::ostream &(*)(std::ostream &)>(std::endl)) {
-      // 如果是，则将日志消息写入日志系统
-      log(LogMessage(log_context_.level, log_context_.stream.str(),
-                     log_context_.file, log_context_.line));
       is_logging_ = false;
+      commitRecord();
     }
   }
   return *this;
 }
+
+void LogArgs::decode(std::string_view payload, std::ostream &os) {
+  size_t pos = 0;
+  auto take = [&payload, &pos](auto &value) {
+    std::memcpy(&value, payload.data() + pos, sizeof(value));
+    pos += sizeof(value);
+  };
+
+  while (pos < payload.size()) {
+    switch (static_cast<Tag>(payload[pos++])) {
+    case Tag::Text: {
+      size_t size;
+      take(size);
+      os << payload.substr(pos, size);
+      pos += size;
+      break;
+    }
+    case Tag::Int: {
+      int64_t value;
+      take(value);
+      os << value;
+      break;
+    }
+    case Tag::UInt: {
+      uint64_t value;
+      take(value);
+      os << value;
+      break;
+    }
+    case Tag::Double: {
+      double value;
+      take(value);
+      os << value;
+      break;
+    }
+    case Tag::Char: {
+      char value;
+      take(value);
+      os << value;
+      break;
+    }
+    case Tag::Bool: {
+      bool value;
+      take(value);
+      os << value;
+      break;
+    }
+    case Tag::Pointer: {
+      const void *value;
+      take(value);
+      os << value;
+      break;
+    }
+    case Tag::Manip: {
+      Manipulator manip;
+      take(manip);
+      manip(os);
+      break;
+    }
+    }
+  }
+}
@@ -0,0 +1,149 @@
+#include "util/logger/perf_log.h"
+#include "util/logger/macros.h"
+#include <algorithm>
+#include <cstring>
+
+std::atomic<bool> PerfLog::enabled_{false};
+thread_local std::unique_ptr<PerfLog::ThreadBuffer> PerfLog::thread_buffer_;
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'X', 'X', 'P', 'E', 'R', 'F', '1'};
+
+template <typename T> void put(std::string &out, T value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void putRecord(std::string &out, PerfLog::RecordKind kind, uint16_t event,
+               uint32_t thread, uint64_t first, uint64_t second) {
+  put(out, static_cast<uint8_t>(kind));
+  put(out, event);
+  put(out, thread);
+  put(out, first);
+  put(out, second);
+}
+
+} // namespace
+
+PerfLog::~PerfLog() {
+  if (file_)
+    std::fclose(file_);
+}
+
+PerfLog::ThreadBuffer::~ThreadBuffer() {
+  PerfLog &log = PerfLog::getInstance();
+  log.emitAggregates(*this);
+  std::lock_guard<std::mutex> lock(log.mutex_);
+  log.writeLocked(bytes);
+  log.buffers_.erase(std::remove(log.buffers_.begin(), log.buffers_.end(), this),
+                     log.buffers_.end());
+}
+
+bool PerfLog::open(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (file_)
+    return true;
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) {
+    LOG_ERROR << "Cannot open perf log file: " << path << std::endl;
+    return false;
+  }
+  std::fwrite(kMagic, 1, sizeof(kMagic), file_);
+  // open 之前已登记的事件名
+  for (size_t event = 0; event < names_.size(); ++event)
+    writeNameLocked(static_cast<uint16_t>(event), names_[event]);
+  origin_ = now();
+  enabled_.store(true, std::memory_order_release);
+  LOG_INFO << "Perf events are recorded to " << path << std::endl;
+  return true;
+}
+
+void PerfLog::close() {
+  if (!enabled())
+    return;
+  enabled_.store(false, std::memory_order_release);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (ThreadBuffer *buffer : buffers_) {
+    emitAggregates(*buffer);
+    writeLocked(buffer->bytes);
+  }
+  std::fclose(file_);
+  file_ = nullptr;
+}
+
+uint16_t PerfLog::registerEvent(const char *name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = std::find(names_.begin(), names_.end(), name);
+  if (it != names_.end())
+    return static_cast<uint16_t>(it - names_.begin());
+  const auto event = static_cast<uint16_t>(names_.size());
+  names_.emplace_back(name);
+  if (file_)
+    writeNameLocked(event, names_.back());
+  return event;
+}
+
+void PerfLog::record(uint16_t event, Mode mode, uint64_t start,
+                     uint64_t duration) {
+  ThreadBuffer &buffer = threadBuffer();
+  if (mode == Mode::Accumulate) {
+    if (event >= buffer.aggregates.size())
+      buffer.aggregates.resize(event + 1);
+    ++buffer.aggregates[event].count;
+    buffer.aggregates[event].total += duration;
+    return;
+  }
+
+  putRecord(buffer.bytes, RecordKind::Span, event, buffer.thread,
+            start - origin_, duration);
+  if (buffer.bytes.size() >= kFlushBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writeLocked(buffer.bytes);
+  }
+}
+
+void PerfLog::flushThread() {
+  if (!enabled() || !thread_buffer_)
+    return;
+  emitAggregates(*thread_buffer_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  writeLocked(thread_buffer_->bytes);
+}
+
+PerfLog::ThreadBuffer &PerfLog::threadBuffer() {
+  if (!thread_buffer_) {
+    thread_buffer_ = std::make_unique<ThreadBuffer>();
+    thread_buffer_->bytes.reserve(kFlushBytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    thread_buffer_->thread = next_thread_++;
+    buffers_.push_back(thread_buffer_.get());
+  }
+  return *thread_buffer_;
+}
+
+void PerfLog::emitAggregates(ThreadBuffer &buffer) {
+  for (size_t event = 0; event < buffer.aggregates.size(); ++event) {
+    Aggregate &aggregate = buffer.aggregates[event];
+    if (aggregate.count == 0)
+      continue;
+    putRecord(buffer.bytes, RecordKind::Aggregate,
+              static_cast<uint16_t>(event), buffer.thread, aggregate.count,
+              aggregate.total);
+    aggregate = Aggregate{};
+  }
+}
+
+void PerfLog::writeLocked(std::string &bytes) {
+  if (file_ && !bytes.empty())
+    std::fwrite(bytes.data(), 1, bytes.size(), file_);
+  bytes.clear();
+}
+
+void PerfLog::writeNameLocked(uint16_t event, const std::string &name) {
+  std::string bytes;
+  put(bytes, static_cast<uint8_t>(RecordKind::Name));
+  put(bytes, event);
+  put(bytes, static_cast<uint16_t>(name.size()));
+  bytes += name;
+  std::fwrite(bytes.data(), 1, bytes.size(), file_);
+}
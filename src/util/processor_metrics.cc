@@ -0,0 +1,57 @@
+#include "util/processor_metrics.h"
+
+thread_local ProcessorCounters *ProcessorMetrics::current_ = nullptr;
+thread_local uint64_t ProcessorMetrics::switched_at_ = 0;
+
+const char *ProcessorMetrics::name(ProcessorKind kind) {
+  switch (kind) {
+  case ProcessorKind::Function:
+    return "FunctionProcessor";
+  case ProcessorKind::Variable:
+    return "VariableProcessor";
+  case ProcessorKind::Type:
+    return "TypeProcessor";
+  case ProcessorKind::Specifier:
+    return "SpecifierProcessor";
+  case ProcessorKind::Namespace:
+    return "NamespaceProcessor";
+  case ProcessorKind::Stmt:
+    return "StmtProcessor";
+  case ProcessorKind::Expr:
+    return "ExprProcessor";
+  case ProcessorKind::Template:
+    return "TemplateProcessor";
+  case ProcessorKind::Inheritance:
+    return "InheritanceProcessor";
+  case ProcessorKind::RecordLayout:
+    return "RecordLayoutProcessor";
+  case ProcessorKind::Lambda:
+    return "LambdaProcessor";
+  case ProcessorKind::Preprocessor:
+    return "PreprocessorProcessor";
+  default:
+    return "Unknown";
+  }
+}
+
+void ProcessorMetrics::merge(ProcessorKind kind,
+                             const ProcessorCounters &counters) {
+  AtomicCounters &total = totals_[static_cast<size_t>(kind)];
+  total.nodes.fetch_add(counters.nodes, std::memory_order_relaxed);
+  total.rows.fetch_add(counters.rows, std::memory_order_relaxed);
+  total.cache_hits.fetch_add(counters.cache_hits, std::memory_order_relaxed);
+  total.cache_misses.fetch_add(counters.cache_misses,
+                               std::memory_order_relaxed);
+  total.time_ns.fetch_add(counters.time_ns, std::memory_order_relaxed);
+}
+
+ProcessorCounters ProcessorMetrics::total(ProcessorKind kind) const {
+  const AtomicCounters &total = totals_[static_cast<size_t>(kind)];
+  ProcessorCounters counters;
+  counters.nodes = total.nodes.load(std::memory_order_relaxed);
+  counters.rows = total.rows.load(std::memory_order_relaxed);
+  counters.cache_hits = total.cache_hits.load(std::memory_order_relaxed);
+  counters.cache_misses = total.cache_misses.load(std::memory_order_relaxed);
+  counters.time_ns = total.time_ns.load(std::memory_order_relaxed);
+  return counters;
+}
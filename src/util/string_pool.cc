@@ -0,0 +1,57 @@
+#include "util/string_pool.h"
+#include <cstring>
+#include <functional>
+
+InternedString StringPool::intern(std::string_view text) {
+  if (text.empty())
+    return InternedString();
+
+  const size_t hash = std::hash<std::string_view>{}(text);
+  Shard &shard = shards_[hash % kShardCount];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (auto it = shard.strings.find(text); it != shard.strings.end())
+    return InternedString(*it);
+  std::string_view stored = shard.store(text);
+  shard.strings.insert(stored);
+  return InternedString(stored);
+}
+
+std::string_view StringPool::Shard::store(std::string_view text) {
+  // 超过块大小四分之一的长串单独分配, 避免浪费当前块的剩余空间
+  if (text.size() > kChunkSize / 4) {
+    chunks.push_back(std::make_unique<char[]>(text.size()));
+    std::memcpy(chunks.back().get(), text.data(), text.size());
+    bytes += text.size();
+    return {chunks.back().get(), text.size()};
+  }
+
+  if (text.size() > remaining) {
+    chunks.push_back(std::make_unique<char[]>(kChunkSize));
+    cursor = chunks.back().get();
+    remaining = kChunkSize;
+  }
+  char *data = cursor;
+  std::memcpy(data, text.data(), text.size());
+  cursor += text.size();
+  remaining -= text.size();
+  bytes += text.size();
+  return {data, text.size()};
+}
+
+size_t StringPool::size() const {
+  size_t total = 0;
+  for (const Shard &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    total += shard.strings.size();
+  }
+  return total;
+}
+
+size_t StringPool::bytes() const {
+  size_t total = 0;
+  for (const Shard &shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    total += shard.bytes;
+  }
+  return total;
+}
@@ -0,0 +1,17 @@
+#include "shared.h"
+
+// Same header as in util.cc, but a COLOR definition no other TU uses
+#define COLOR(name, value)                                                     \
+  const char *name##Name() { return #name; }
+#include "colors.def"
+#undef COLOR
+
+int main() {
+  shared::Point origin = {3, -4};
+  int distance = shared::manhattan(origin);
+  for (int i = 0; i < 2; ++i) {
+    distance += shared::clampValue(i, 0, 1);
+  }
+  distance += RedName()[0] == 'R';
+  return distance;
+}
@@ -0,0 +1,31 @@
+// Shared header for multi-translation-unit extraction.
+// Both TUs include it, so its declarations must map to the same IDs.
+#ifndef MULTI_TU_SHARED_H
+#define MULTI_TU_SHARED_H
+
+namespace shared {
+
+struct Point {
+  int x;
+  int y;
+};
+
+int manhattan(const Point &p);
+
+template <typename T> T clampValue(T value, T low, T high) {
+  if (value < low)
+    return low;
+  if (value > high)
+    return high;
+  return value;
+}
+
+enum class Color {
+#define COLOR(name, value) name,
+#include "colors.def"
+#undef COLOR
+};
+
+} // namespace shared
+
+#endif // MULTI_TU_SHARED_H
@@ -0,0 +1,20 @@
+#include "shared.h"
+
+namespace shared {
+
+int manhattan(const Point &p) {
+  int dx = p.x < 0 ? -p.x : p.x;
+  int dy = p.y < 0 ? -p.y : p.y;
+  return dx + dy;
+}
+
+// Second inclusion in the same TU, with another COLOR definition
+#define COLOR(name, value)                                                     \
+  int name##Value() { return value; }
+#include "colors.def"
+#undef COLOR
+
+} // namespace shared
+
+// Global-scope using: its using_container row is keyed by the file ID
+using shared::Color;